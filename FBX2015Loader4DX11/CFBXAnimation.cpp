@@ -0,0 +1,504 @@
+// *********************************************************************************************************************
+///
+/// @file 		CFBXAnimation.cpp
+/// @brief		ǂݍݎɏĂ񂾃m[hAj[V. FBX SDKg킸ɊKwŜ̍s߂
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#include "CFBXAnimation.h"
+
+#include <math.h>
+#include <algorithm>
+
+#include <DirectXPackedVector.h>
+
+namespace FBX_LOADER
+{
+
+// ]smallest three. ő̐𐳂ɂďȂ, c3(}1/2Ɏ܂)15bit.
+// Ȃ̔ԍx, y̍ŉbitɓ
+static const float ROTATION_RANGE = 0.70710678f;
+static const float ROTATION_STEP = ROTATION_RANGE * 2.0f / 32767.0f;
+
+static uint16_t Quantize(const float value, const float maxValue)
+{
+	return static_cast<uint16_t>(std::min(std::max(value, 0.0f), maxValue) + 0.5f);
+}
+
+static const DirectX::XMFLOAT4A& GetKeyChannel(const FBX_ANIMATION_KEY& key, const uint32_t channel)
+{
+	switch(channel)
+	{
+	case CFBXAnimation::CHANNEL_TRANSLATION:	return key.translation;
+	case CFBXAnimation::CHANNEL_ROTATION:		return key.rotation;
+	default:									return key.scale;
+	}
+}
+
+// lƂ̍, _distance̋ɂ_ǂꂾ邩.
+// ]q, -q̋߂Ƃ̍ |q|  px/2 g(1 - dot^2菬ȊpxŐxȂ)
+static float GetChannelError(const uint32_t channel, DirectX::FXMVECTOR exact, DirectX::FXMVECTOR approx, const float distance)
+{
+	using namespace DirectX;
+
+	switch(channel)
+	{
+	case CFBXAnimation::CHANNEL_TRANSLATION:
+		return XMVectorGetX(XMVector3Length(XMVectorSubtract(exact, approx)));
+	case CFBXAnimation::CHANNEL_ROTATION:
+		{
+			const float d0 = XMVectorGetX(XMVector4Length(XMVectorSubtract(exact, approx)));
+			const float d1 = XMVectorGetX(XMVector4Length(XMVectorAdd(exact, approx)));
+			return 2.0f * distance * std::min(d0, d1);
+		}
+	default:
+		{
+			XMFLOAT4 diff;
+			XMStoreFloat4(&diff, XMVectorAbs(XMVectorSubtract(exact, approx)));
+			return distance * std::max(std::max(diff.x, diff.y), diff.z);
+		}
+	}
+}
+
+CFBXAnimation::CFBXAnimation()
+{
+	m_sampleRate = 0.0f;
+	m_frameCount = 0;
+	m_trackCount = 0;
+	m_isCompressed = false;
+	m_maxError = 0.0f;
+	m_rawKeyBytes = 0;
+}
+
+void CFBXAnimation::Release()
+{
+	m_sampleRate = 0.0f;
+	m_frameCount = 0;
+	m_trackCount = 0;
+	m_parentArray.clear();
+	m_trackArray.clear();
+	m_localArray.clear();
+	m_globalArray.clear();
+	m_isStaticArray.clear();
+	m_keyArray.clear();
+	m_channelArray.clear();
+	m_keyFrameArray.clear();
+	m_keyValueArray.clear();
+	m_isCompressed = false;
+	m_maxError = 0.0f;
+	m_rawKeyBytes = 0;
+}
+
+void CFBXAnimation::Initialize(const size_t nodeCount, const uint32_t trackCount, const uint32_t frameCount, const float sampleRate)
+{
+	Release();
+
+	m_sampleRate = sampleRate;
+	m_frameCount = frameCount;
+	m_trackCount = trackCount;
+
+	DirectX::XMFLOAT4X4 identity;
+	DirectX::XMStoreFloat4x4(&identity, DirectX::XMMatrixIdentity());
+
+	m_parentArray.assign(nodeCount, -1);
+	m_trackArray.assign(nodeCount, -1);
+	m_localArray.assign(nodeCount, identity);
+	m_globalArray.assign(nodeCount, identity);
+	m_isStaticArray.assign(nodeCount, 1);
+	m_keyArray.resize(static_cast<size_t>(frameCount) * trackCount);
+}
+
+void CFBXAnimation::SetNode(const size_t nodeId, const int32_t parentId, const int32_t trackId, const DirectX::XMFLOAT4X4& local)
+{
+	m_parentArray[nodeId] = parentId;
+	m_trackArray[nodeId] = trackId;
+	m_localArray[nodeId] = local;
+}
+
+// Ȃ؂̃O[osɋ߂Ă. eOɂ̂őO1Ȃ߂΂悢
+void CFBXAnimation::Finalize()
+{
+	for(size_t i=0;i<m_parentArray.size();i++)
+	{
+		const int32_t parent = m_parentArray[i];
+		const bool isParentStatic = parent < 0 || m_isStaticArray[parent];
+		m_isStaticArray[i] = (m_trackArray[i] < 0 && isParentStatic) ? 1 : 0;
+		if(!m_isStaticArray[i])
+			continue;
+
+		const DirectX::XMMATRIX local = DirectX::XMLoadFloat4x4(&m_localArray[i]);
+		if(parent < 0)
+			m_globalArray[i] = m_localArray[i];
+		else
+			DirectX::XMStoreFloat4x4(&m_globalArray[i], DirectX::XMMatrixMultiply(local, DirectX::XMLoadFloat4x4(&m_globalArray[parent])));
+	}
+}
+
+void CFBXAnimation::GetFrame(const float time, uint32_t* pFrame0, float* pAlpha) const
+{
+	*pFrame0 = 0;
+	*pAlpha = 0.0f;
+	if(m_frameCount < 2)
+		return ;
+
+	const float duration = GetDuration();
+	float t = fmodf(time, duration);
+	if(t < 0.0f)
+		t += duration;
+
+	const float frame = t * m_sampleRate;
+	uint32_t frame0 = static_cast<uint32_t>(frame);
+	if(frame0 >= m_frameCount - 1)
+		frame0 = m_frameCount - 2;
+
+	*pFrame0 = frame0;
+	*pAlpha = std::min(frame - static_cast<float>(frame0), 1.0f);
+}
+
+void CFBXAnimation::Sample(const float time, DirectX::XMFLOAT4X4* pMatrices) const
+{
+	if(!pMatrices)
+		return ;
+
+	uint32_t frame0;
+	float alpha;
+	GetFrame(time, &frame0, &alpha);
+	Evaluate(frame0, alpha, m_isCompressed, pMatrices);
+}
+
+// 2t[̃L[`(]͐K`)čsɂ, ẽO[os|.
+// ԊũL[͏Ăݎɉ]𑵂̕Ă̂, ł͓ς̕Ȃ
+void CFBXAnimation::Evaluate(const uint32_t frame0, const float alpha, const bool useCompressed, DirectX::XMFLOAT4X4* pMatrices) const
+{
+	using namespace DirectX;
+
+	const uint32_t frame1 = frame0 + 1 < m_frameCount ? frame0 + 1 : frame0;
+	const bool hasKeys = !useCompressed && !m_keyArray.empty();
+	const FBX_ANIMATION_KEY* pKeys0 = hasKeys ? &m_keyArray[static_cast<size_t>(frame0) * m_trackCount] : nullptr;
+	const FBX_ANIMATION_KEY* pKeys1 = hasKeys ? &m_keyArray[static_cast<size_t>(frame1) * m_trackCount] : nullptr;
+	const XMVECTOR vAlpha = XMVectorReplicate(alpha);
+
+	const size_t nodeCount = m_parentArray.size();
+	for(size_t i=0;i<nodeCount;i++)
+	{
+		if(m_isStaticArray[i])
+		{
+			pMatrices[i] = m_globalArray[i];
+			continue;
+		}
+
+		XMMATRIX local;
+		const int32_t track = m_trackArray[i];
+		if(track < 0)
+		{
+			local = XMLoadFloat4x4(&m_localArray[i]);
+		}
+		else
+		{
+			XMVECTOR translation, rotation, scale;
+			if(useCompressed)
+			{
+				translation = SampleChannel(track, CHANNEL_TRANSLATION, frame0, alpha);
+				rotation = SampleChannel(track, CHANNEL_ROTATION, frame0, alpha);
+				scale = SampleChannel(track, CHANNEL_SCALE, frame0, alpha);
+			}
+			else
+			{
+				const FBX_ANIMATION_KEY& key0 = pKeys0[track];
+				const FBX_ANIMATION_KEY& key1 = pKeys1[track];
+
+				translation = XMVectorLerpV(XMLoadFloat4A(&key0.translation), XMLoadFloat4A(&key1.translation), vAlpha);
+				rotation = XMQuaternionNormalize(XMVectorLerpV(XMLoadFloat4A(&key0.rotation), XMLoadFloat4A(&key1.rotation), vAlpha));
+				scale = XMVectorLerpV(XMLoadFloat4A(&key0.scale), XMLoadFloat4A(&key1.scale), vAlpha);
+			}
+
+			// S * R * T. ]s̊esg債, sړ4sڂɓ
+			local = XMMatrixRotationQuaternion(rotation);
+			local.r[0] = XMVectorMultiply(local.r[0], XMVectorSplatX(scale));
+			local.r[1] = XMVectorMultiply(local.r[1], XMVectorSplatY(scale));
+			local.r[2] = XMVectorMultiply(local.r[2], XMVectorSplatZ(scale));
+			local.r[3] = XMVectorSelect(g_XMIdentityR3, translation, g_XMSelect1110);
+		}
+
+		const int32_t parent = m_parentArray[i];
+		if(parent >= 0)
+			local = XMMatrixMultiply(local, XMLoadFloat4x4(&pMatrices[parent]));
+
+		XMStoreFloat4x4(&pMatrices[i], local);
+	}
+}
+
+// frame0܂ދԂ̃L[2񕪒TŌĕԂ
+DirectX::XMVECTOR CFBXAnimation::SampleChannel(const uint32_t track, const uint32_t channel, const uint32_t frame0, const float alpha) const
+{
+	const FBX_ANIMATION_CHANNEL& range = m_channelArray[static_cast<size_t>(track) * CHANNEL_COUNT + channel];
+	if(range.keyCount == 1)
+		return DirectX::XMLoadFloat4A(&range.rangeMin);
+
+	const uint16_t* pFrames = &m_keyFrameArray[range.keyStart];
+	uint32_t key = static_cast<uint32_t>(std::upper_bound(pFrames, pFrames + range.keyCount, frame0) - pFrames) - 1;
+	if(key > range.keyCount - 2)
+		key = range.keyCount - 2;
+
+	const float t = (static_cast<float>(frame0 - pFrames[key]) + alpha) / static_cast<float>(pFrames[key + 1] - pFrames[key]);
+	const uint16_t* pValue = &m_keyValueArray[(static_cast<size_t>(range.keyStart) + key) * 3];
+	return InterpolateChannel(channel, DecodeKey(channel, pValue, range), DecodeKey(channel, pValue + 3, range), t);
+}
+
+DirectX::XMVECTOR CFBXAnimation::InterpolateChannel(const uint32_t channel, DirectX::FXMVECTOR v0, DirectX::FXMVECTOR v1, const float alpha)
+{
+	using namespace DirectX;
+
+	if(channel != CHANNEL_ROTATION)
+		return XMVectorLerp(v0, v1, alpha);
+
+	const XMVECTOR q1 = XMVectorGetX(XMVector4Dot(v0, v1)) < 0.0f ? XMVectorNegate(v1) : v1;
+	return XMQuaternionNormalize(XMVectorLerp(v0, q1, alpha));
+}
+
+// 316bit1œǂ, ͈͂|Ė߂. ]͍ŉbit𗎂ƂĂ߂,
+// Ȃ w = (1 - x^2 - y^2 - z^2) ŋ߂Č̕тɉ
+DirectX::XMVECTOR CFBXAnimation::DecodeKey(const uint32_t channel, const uint16_t* pValue, const FBX_ANIMATION_CHANNEL& range)
+{
+	using namespace DirectX;
+	using namespace DirectX::PackedVector;
+
+	const XMVECTOR rangeMin = XMLoadFloat4A(&range.rangeMin);
+	const XMVECTOR rangeScale = XMLoadFloat4A(&range.rangeScale);
+	if(channel != CHANNEL_ROTATION)
+		return XMVectorMultiplyAdd(XMLoadUShort4(reinterpret_cast<const XMUSHORT4*>(pValue)), rangeScale, rangeMin);
+
+	const uint32_t largest = (pValue[0] & 1) | ((pValue[1] & 1) << 1);
+	XMUSHORT4 packed;
+	packed.x = pValue[0] >> 1;
+	packed.y = pValue[1] >> 1;
+	packed.z = pValue[2] >> 1;
+	packed.w = 0;
+
+	// т (largest+1, largest+2, largest+3, largest)
+	const XMVECTOR v = XMVectorMultiplyAdd(XMLoadUShort4(&packed), rangeScale, rangeMin);
+	const float w = sqrtf(std::max(1.0f - XMVectorGetX(XMVector3Dot(v, v)), 0.0f));
+	return XMVectorRotateLeft(XMVectorSetW(v, w), 3 - largest);
+}
+
+void CFBXAnimation::EncodeKey(const uint32_t channel, DirectX::FXMVECTOR value, const FBX_ANIMATION_CHANNEL& range, uint16_t* pValue)
+{
+	DirectX::XMFLOAT4A v;
+	DirectX::XMStoreFloat4A(&v, value);
+	const float* pComponent = &v.x;
+
+	if(channel != CHANNEL_ROTATION)
+	{
+		const float* pMin = &range.rangeMin.x;
+		const float* pScale = &range.rangeScale.x;
+		for(int i=0;i<3;i++)
+			pValue[i] = pScale[i] > 0.0f ? Quantize((pComponent[i] - pMin[i]) / pScale[i], 65535.0f) : 0;
+		return ;
+	}
+
+	uint32_t largest = 0;
+	for(uint32_t i=1;i<4;i++)
+	{
+		if(fabsf(pComponent[i]) > fabsf(pComponent[largest]))
+			largest = i;
+	}
+
+	const float sign = pComponent[largest] < 0.0f ? -1.0f : 1.0f;
+	for(uint32_t i=0;i<3;i++)
+	{
+		const float component = pComponent[(largest + 1 + i) & 3] * sign;
+		pValue[i] = static_cast<uint16_t>(Quantize((component + ROTATION_RANGE) / ROTATION_STEP, 32767.0f) << 1);
+	}
+	pValue[0] |= largest & 1;
+	pValue[1] |= (largest >> 1) & 1;
+}
+
+float CFBXAnimation::GetMaxTranslation(const size_t nodeId) const
+{
+	const int32_t track = m_trackArray[nodeId];
+	if(track < 0)
+	{
+		const DirectX::XMFLOAT4X4& local = m_localArray[nodeId];
+		return sqrtf(local._41 * local._41 + local._42 * local._42 + local._43 * local._43);
+	}
+
+	float maxLength = 0.0f;
+	for(uint32_t frame=0;frame<m_frameCount;frame++)
+	{
+		const DirectX::XMFLOAT4A& t = m_keyArray[static_cast<size_t>(frame) * m_trackCount + track].translation;
+		maxLength = std::max(maxLength, sqrtf(t.x * t.x + t.y * t.y + t.z * t.z));
+	}
+	return maxLength;
+}
+
+// St[擪Ƌe덷Ȃɂ. łȂΑSt[ʎq,
+// l̐`ԂԂ̃t[e덷ŕ\ԂL΂(ʎq̌덷܂߂đ)
+void CFBXAnimation::CompressChannel(const uint32_t track, const uint32_t channel, const float distance, const float tolerance)
+{
+	using namespace DirectX;
+
+	FBX_ANIMATION_CHANNEL& range = m_channelArray[static_cast<size_t>(track) * CHANNEL_COUNT + channel];
+	range.keyStart = static_cast<uint32_t>(m_keyFrameArray.size());
+
+	std::vector<XMFLOAT4> exactArray(m_frameCount);
+	for(uint32_t frame=0;frame<m_frameCount;frame++)
+		exactArray[frame] = GetKeyChannel(m_keyArray[static_cast<size_t>(frame) * m_trackCount + track], channel);
+
+	const XMVECTOR first = XMLoadFloat4(&exactArray[0]);
+	bool isConstant = true;
+	for(uint32_t frame=1;frame<m_frameCount && isConstant;frame++)
+		isConstant = GetChannelError(channel, XMLoadFloat4(&exactArray[frame]), first, distance) <= tolerance;
+
+	if(isConstant)
+	{
+		XMStoreFloat4A(&range.rangeMin, first);
+		range.rangeScale = XMFLOAT4A(0.0f, 0.0f, 0.0f, 0.0f);
+		range.keyCount = 1;
+		return ;
+	}
+
+	if(channel == CHANNEL_ROTATION)
+	{
+		range.rangeMin = XMFLOAT4A(-ROTATION_RANGE, -ROTATION_RANGE, -ROTATION_RANGE, 0.0f);
+		range.rangeScale = XMFLOAT4A(ROTATION_STEP, ROTATION_STEP, ROTATION_STEP, 0.0f);
+	}
+	else
+	{
+		// sړƊgw0Ȃ̂, ͈͂w0ɂȂ
+		XMVECTOR minValue = first;
+		XMVECTOR maxValue = first;
+		for(uint32_t frame=1;frame<m_frameCount;frame++)
+		{
+			minValue = XMVectorMin(minValue, XMLoadFloat4(&exactArray[frame]));
+			maxValue = XMVectorMax(maxValue, XMLoadFloat4(&exactArray[frame]));
+		}
+		XMStoreFloat4A(&range.rangeMin, minValue);
+		XMStoreFloat4A(&range.rangeScale, XMVectorScale(XMVectorSubtract(maxValue, minValue), 1.0f / 65535.0f));
+	}
+
+	std::vector<uint16_t> packedArray(static_cast<size_t>(m_frameCount) * 3 + 1, 0);
+	std::vector<XMFLOAT4> decodedArray(m_frameCount);
+	for(uint32_t frame=0;frame<m_frameCount;frame++)
+		EncodeKey(channel, XMLoadFloat4(&exactArray[frame]), range, &packedArray[frame * 3]);
+	for(uint32_t frame=0;frame<m_frameCount;frame++)
+		XMStoreFloat4(&decodedArray[frame], DecodeKey(channel, &packedArray[frame * 3], range));
+
+	std::vector<uint32_t> keyArray(1, 0);
+	uint32_t start = 0;
+	while(start < m_frameCount - 1)
+	{
+		uint32_t end = start + 1;
+		for(;end + 1 < m_frameCount && end + 1 - start <= COMPRESS_SPAN_MAX;end++)
+		{
+			const uint32_t next = end + 1;
+			const XMVECTOR v0 = XMLoadFloat4(&decodedArray[start]);
+			const XMVECTOR v1 = XMLoadFloat4(&decodedArray[next]);
+			const float span = static_cast<float>(next - start);
+
+			bool isValid = true;
+			for(uint32_t frame=start+1;frame<next && isValid;frame++)
+			{
+				const XMVECTOR approx = InterpolateChannel(channel, v0, v1, static_cast<float>(frame - start) / span);
+				isValid = GetChannelError(channel, XMLoadFloat4(&exactArray[frame]), approx, distance) <= tolerance;
+			}
+			if(!isValid)
+				break;
+		}
+		keyArray.push_back(end);
+		start = end;
+	}
+
+	range.keyCount = static_cast<uint32_t>(keyArray.size());
+	for(size_t i=0;i<keyArray.size();i++)
+	{
+		const uint16_t* pValue = &packedArray[static_cast<size_t>(keyArray[i]) * 3];
+		m_keyFrameArray.push_back(static_cast<uint16_t>(keyArray[i]));
+		m_keyValueArray.insert(m_keyValueArray.end(), pValue, pValue + 3);
+	}
+}
+
+// 덷̋̓m[hɁuqɓ͂v(qւ̕sړ + q̋̍ő, ŒshellDistanceMin)g.
+// e̊g͍lȂ̂, e傫g債ĂƎۂ̌덷͑傫Ȃ.
+// 1m[h3`l̘atoleranceɎ܂悤, `lɂtolerance / 3Ŕ肷
+bool CFBXAnimation::Compress(const float tolerance, const float shellDistanceMin)
+{
+	using namespace DirectX;
+
+	if(m_isCompressed || !IsAnimated() || m_frameCount > COMPRESS_FRAME_MAX)
+		return false;
+
+	// q͐eɂ̂, 납Ȃ߂Ύq̋Ɍ܂
+	const size_t nodeCount = m_parentArray.size();
+	std::vector<float> distanceArray(nodeCount, shellDistanceMin);
+	for(size_t i=nodeCount;i-->0;)
+	{
+		const int32_t parent = m_parentArray[i];
+		if(parent >= 0)
+			distanceArray[parent] = std::max(distanceArray[parent], distanceArray[i] + GetMaxTranslation(i));
+	}
+
+	const float channelTolerance = tolerance / static_cast<float>(CHANNEL_COUNT);
+	m_channelArray.resize(static_cast<size_t>(m_trackCount) * CHANNEL_COUNT);
+	m_keyFrameArray.clear();
+	m_keyValueArray.clear();
+	for(size_t i=0;i<nodeCount;i++)
+	{
+		const int32_t track = m_trackArray[i];
+		if(track < 0)
+			continue;
+
+		for(uint32_t channel=0;channel<CHANNEL_COUNT;channel++)
+			CompressChannel(track, channel, distanceArray[i], channelTolerance);
+	}
+	m_keyValueArray.push_back(0);
+
+	// St[ňkOƔ, _Ɗeɋꂽ_̂̍ő덷Ƃ
+	std::vector<XMFLOAT4X4> rawArray(nodeCount);
+	std::vector<XMFLOAT4X4> compressedArray(nodeCount);
+	m_maxError = 0.0f;
+	for(uint32_t frame=0;frame<m_frameCount;frame++)
+	{
+		Evaluate(frame, 0.0f, false, &rawArray[0]);
+		Evaluate(frame, 0.0f, true, &compressedArray[0]);
+
+		for(size_t i=0;i<nodeCount;i++)
+		{
+			if(m_isStaticArray[i])
+				continue;
+
+			const XMMATRIX raw = XMLoadFloat4x4(&rawArray[i]);
+			const XMMATRIX compressed = XMLoadFloat4x4(&compressedArray[i]);
+			const XMVECTOR distance = XMVectorReplicate(distanceArray[i]);
+			const XMVECTOR origin = XMVectorSubtract(raw.r[3], compressed.r[3]);
+
+			XMVECTOR error = XMVector3Length(origin);
+			for(int axis=0;axis<3;axis++)
+				error = XMVectorMax(error, XMVector3Length(XMVectorMultiplyAdd(XMVectorSubtract(raw.r[axis], compressed.r[axis]), distance, origin)));
+			m_maxError = std::max(m_maxError, XMVectorGetX(error));
+		}
+	}
+
+	m_rawKeyBytes = m_keyArray.size() * sizeof(FBX_ANIMATION_KEY);
+	FBX_ANIMATION_KEY_STREAM().swap(m_keyArray);
+	m_isCompressed = true;
+	return true;
+}
+
+size_t CFBXAnimation::GetKeySize() const
+{
+	return m_keyArray.size() * sizeof(FBX_ANIMATION_KEY)
+		+ m_channelArray.size() * sizeof(FBX_ANIMATION_CHANNEL)
+		+ m_keyFrameArray.size() * sizeof(uint16_t)
+		+ m_keyValueArray.size() * sizeof(uint16_t);
+}
+
+size_t CFBXAnimation::GetMemorySize() const
+{
+	return GetKeySize()
+		+ m_parentArray.size() * (sizeof(int32_t) * 2 + sizeof(DirectX::XMFLOAT4X4) * 2 + sizeof(uint8_t));
+}
+
+}	// namespace FBX_LOADER
@@ -0,0 +1,130 @@
+// *********************************************************************************************************************
+///
+/// @file 		CFBXAnimation.h
+/// @brief		ǂݍݎɏĂ񂾃m[hAj[V. FBX SDKg킸ɊKwŜ̍s߂
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include <DirectXMath.h>
+
+#include "CFBXLoader.h"
+
+namespace FBX_LOADER
+{
+
+// 1m[h1t[̃[Jϊ. ̂܂XMLoadFloat4Aœǂ߂
+struct FBX_ANIMATION_KEY
+{
+	DirectX::XMFLOAT4A	translation;	// w0
+	DirectX::XMFLOAT4A	rotation;		// NH[^jI. Õt[ƓɑĂ
+	DirectX::XMFLOAT4A	scale;			// w0
+};
+
+typedef std::vector<FBX_ANIMATION_KEY, ALIGNED_ALLOCATOR<FBX_ANIMATION_KEY>>	FBX_ANIMATION_KEY_STREAM;
+
+// k̃gbN1`l(sړ, ], ĝǂꂩ).
+// L[116bit x 3. sړƊgrangeMin + l * rangeScale, ]smallest three(CFBXAnimation.cppQ)
+struct FBX_ANIMATION_CHANNEL
+{
+	DirectX::XMFLOAT4A	rangeMin;		// keyCount1Ȃ炱̒l̂܂(]̓NH[^jI)
+	DirectX::XMFLOAT4A	rangeScale;		// w0
+	uint32_t			keyStart;		// m_keyFrameArray, m_keyValueArray(x3)̐擪
+	uint32_t			keyCount;		// 1Ȃ. ȊO͐擪ƍŌ̃t[K܂
+};
+
+typedef std::vector<FBX_ANIMATION_CHANNEL, ALIGNED_ALLOCATOR<FBX_ANIMATION_CHANNEL>>	FBX_ANIMATION_CHANNEL_STREAM;
+
+// m[h̕тCFBXLoader̃m[h(CFBXRenderDX11̃m[h)Ɠ, e͕KqOɂ.
+// m[h(gbN)ԊũL[, L[̓t[ɑSgbNׂ(1Sampleœǂޔ͈͂A).
+// Ȃm[h̓[Js, c܂߂ēȂm[h̓O[osĂvZȂ.
+// Compresš͈ԊũL[̂, `lɊԈʎqL[Sample
+class CFBXAnimation
+{
+public:
+	enum
+	{
+		CHANNEL_TRANSLATION = 0,
+		CHANNEL_ROTATION,
+		CHANNEL_SCALE,
+		CHANNEL_COUNT,
+
+		COMPRESS_FRAME_MAX = 65536,		// L[̃t[ԍ16bit
+		COMPRESS_SPAN_MAX = 256,		// 1Ԃ̍őt[(kԂ})
+	};
+
+private:
+	float		m_sampleRate;		// 1b̃t[
+	uint32_t	m_frameCount;
+	uint32_t	m_trackCount;
+
+	std::vector<int32_t>				m_parentArray;		// m[h. e-1
+	std::vector<int32_t>				m_trackArray;		// m[h. Ȃ-1
+	std::vector<DirectX::XMFLOAT4X4>	m_localArray;		// m[h. Ȃm[h̃[Js
+	std::vector<DirectX::XMFLOAT4X4>	m_globalArray;		// m[h. m_isStaticArraỹm[hL
+	std::vector<uint8_t>				m_isStaticArray;	// cȂ
+
+	FBX_ANIMATION_KEY_STREAM			m_keyArray;			// [frame * m_trackCount + track]. k͋
+
+	FBX_ANIMATION_CHANNEL_STREAM		m_channelArray;		// [track * CHANNEL_COUNT + channel]
+	std::vector<uint16_t>				m_keyFrameArray;	// L[̃t[ԍ
+	std::vector<uint16_t>				m_keyValueArray;	// L[3. Ō̃L[4ǂ߂悤1]ɒu
+	bool								m_isCompressed;
+	float								m_maxError;			// kO̍(St[̍ő)
+	size_t								m_rawKeyBytes;		// kÕL[̃TCY
+
+	void GetFrame(const float time, uint32_t* pFrame0, float* pAlpha) const;
+	// frame0 + alpha̎̑Sm[h̃O[os. useCompressedȂ爳kL[g
+	void Evaluate(const uint32_t frame0, const float alpha, const bool useCompressed, DirectX::XMFLOAT4X4* pMatrices) const;
+	DirectX::XMVECTOR SampleChannel(const uint32_t track, const uint32_t channel, const uint32_t frame0, const float alpha) const;
+	float GetMaxTranslation(const size_t nodeId) const;
+	void CompressChannel(const uint32_t track, const uint32_t channel, const float distance, const float tolerance);
+
+public:
+	CFBXAnimation();
+
+	void Release();
+
+	// Ăݗp. Initialize  SetNode(Sm[h)  GetKeysőSt[𖄂߂  Finalize ( Compress)
+	void Initialize(const size_t nodeCount, const uint32_t trackCount, const uint32_t frameCount, const float sampleRate);
+	void SetNode(const size_t nodeId, const int32_t parentId, const int32_t trackId, const DirectX::XMFLOAT4X4& local);
+	FBX_ANIMATION_KEY* GetKeys(const uint32_t frame) { return &m_keyArray[static_cast<size_t>(frame) * m_trackCount]; }
+	void Finalize();
+
+	// L[k(Finalizě). tolerance͊Kw̋(m[h̎q܂ޔashellDistanceMinȏ̋ʏ)
+	// 덷̖ڈ. ̃`l͒l1, `Ԃŕ\L[͊Ԉ, c16bitɗʎq.
+	// t[COMPRESS_FRAME_MAX𒴂ΈkȂ
+	bool Compress(const float tolerance, const float shellDistanceMin = 1.0f);
+
+	// time(b)̑Sm[h̃O[ospMatricesɏ(GetNodeCount). 𒴂Ԃ̓[v.
+	// sFBX_MESH_NODE::mat4x4Ɠ
+	void Sample(const float time, DirectX::XMFLOAT4X4* pMatrices) const;
+
+	bool IsAnimated() const { return m_trackCount > 0 && m_frameCount > 1; }
+	size_t GetNodeCount() const { return m_parentArray.size(); }
+	uint32_t GetTrackCount() const { return m_trackCount; }
+	uint32_t GetFrameCount() const { return m_frameCount; }
+	float GetSampleRate() const { return m_sampleRate; }
+	float GetDuration() const { return m_frameCount > 1 ? static_cast<float>(m_frameCount - 1) / m_sampleRate : 0.0f; }
+	size_t GetMemorySize() const;
+
+	bool IsCompressed() const { return m_isCompressed; }
+	float GetMaxError() const { return m_maxError; }
+	size_t GetRawKeySize() const { return m_isCompressed ? m_rawKeyBytes : m_keyArray.size() * sizeof(FBX_ANIMATION_KEY); }
+	size_t GetKeySize() const;
+
+	// 2̃L[̊Ԃ̕. ]͓ςȂq1𔽓]Ă琳K`
+	static DirectX::XMVECTOR InterpolateChannel(const uint32_t channel, DirectX::FXMVECTOR v0, DirectX::FXMVECTOR v1, const float alpha);
+	// 16bit x 3̃L[𕜌. pValue4ǂ
+	static DirectX::XMVECTOR DecodeKey(const uint32_t channel, const uint16_t* pValue, const FBX_ANIMATION_CHANNEL& range);
+	static void EncodeKey(const uint32_t channel, DirectX::FXMVECTOR value, const FBX_ANIMATION_CHANNEL& range, uint16_t* pValue);
+};
+
+}	// namespace FBX_LOADER
@@ -0,0 +1,134 @@
+// *********************************************************************************************************************
+///
+/// @file 		CFBXFrustum.cpp
+/// @brief		ƋE̔. 4܂Ƃ߂SIMDŃJO
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#include "CFBXFrustum.h"
+
+#include <math.h>
+#include <algorithm>
+
+namespace FBX_LOADER
+{
+
+CFBXFrustum::CFBXFrustum()
+{
+	// ݒ肵ȂΑSČ
+	for(int p=0;p<PLANE_COUNT;p++)
+		m_planeArray[p] = DirectX::XMFLOAT4A(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+void CFBXFrustum::SetMatrix(const DirectX::XMFLOAT4X4& m)
+{
+	float planes[PLANE_COUNT][4];
+	for(int i=0;i<4;i++)
+	{
+		const float c0 = m.m[i][0];
+		const float c1 = m.m[i][1];
+		const float c2 = m.m[i][2];
+		const float c3 = m.m[i][3];
+		planes[0][i] = c3 + c0;
+		planes[1][i] = c3 - c0;
+		planes[2][i] = c3 + c1;
+		planes[3][i] = c3 - c1;
+		planes[4][i] = c2;
+		planes[5][i] = c3 - c2;
+	}
+
+	for(int p=0;p<PLANE_COUNT;p++)
+	{
+		const float length = sqrtf(planes[p][0]*planes[p][0] + planes[p][1]*planes[p][1] + planes[p][2]*planes[p][2]);
+		const float scale = length > 0.0f ? 1.0f / length : 1.0f;
+		m_planeArray[p] = DirectX::XMFLOAT4A(planes[p][0] * scale, planes[p][1] * scale, planes[p][2] * scale, planes[p][3] * scale);
+	}
+}
+
+bool CFBXFrustum::IsVisible(const DirectX::XMFLOAT4A& sphere) const
+{
+	for(int p=0;p<PLANE_COUNT;p++)
+	{
+		const DirectX::XMFLOAT4A& plane = m_planeArray[p];
+		if(plane.x*sphere.x + plane.y*sphere.y + plane.z*sphere.z + plane.w < -sphere.w)
+			return false;
+	}
+	return true;
+}
+
+// 4̋]u x, y, z, aꂼ1{̃xNgɂ, ʖ4ɋ߂.
+// Y͌邩ǂɊւ炸Ă琔i߂(򂵂Ȃ)
+uint32_t CFBXFrustum::CullSpheres(const DirectX::XMFLOAT4A* pSpheres, const uint32_t count, uint32_t* pVisibleIndices) const
+{
+	using namespace DirectX;
+
+	if(!pSpheres || !pVisibleIndices)
+		return 0;
+
+	// ʂ̐̓[v̊OōLĂ
+	XMVECTOR planeX[PLANE_COUNT], planeY[PLANE_COUNT], planeZ[PLANE_COUNT], planeW[PLANE_COUNT];
+	for(int p=0;p<PLANE_COUNT;p++)
+	{
+		const XMVECTOR plane = XMLoadFloat4A(&m_planeArray[p]);
+		planeX[p] = XMVectorSplatX(plane);
+		planeY[p] = XMVectorSplatY(plane);
+		planeZ[p] = XMVectorSplatZ(plane);
+		planeW[p] = XMVectorSplatW(plane);
+	}
+
+	uint32_t visibleCount = 0;
+	const uint32_t batchEnd = count & ~3u;
+	for(uint32_t i=0;i<batchEnd;i+=4)
+	{
+		const XMMATRIX spheres = XMMatrixTranspose(XMMATRIX(XMLoadFloat4A(&pSpheres[i]), XMLoadFloat4A(&pSpheres[i + 1]),
+			XMLoadFloat4A(&pSpheres[i + 2]), XMLoadFloat4A(&pSpheres[i + 3])));
+		const XMVECTOR negativeRadius = XMVectorNegate(spheres.r[3]);
+
+		XMVECTOR inside = XMVectorTrueInt();
+		for(int p=0;p<PLANE_COUNT;p++)
+		{
+			XMVECTOR distance = XMVectorMultiplyAdd(spheres.r[0], planeX[p], planeW[p]);
+			distance = XMVectorMultiplyAdd(spheres.r[1], planeY[p], distance);
+			distance = XMVectorMultiplyAdd(spheres.r[2], planeZ[p], distance);
+			inside = XMVectorAndInt(inside, XMVectorGreaterOrEqual(distance, negativeRadius));
+		}
+
+		uint32_t mask[4];
+		XMStoreInt4(mask, inside);
+		for(uint32_t j=0;j<4;j++)
+		{
+			pVisibleIndices[visibleCount] = i + j;
+			visibleCount += mask[j] & 1;
+		}
+	}
+
+	for(uint32_t i=batchEnd;i<count;i++)
+	{
+		if(IsVisible(pSpheres[i]))
+			pVisibleIndices[visibleCount++] = i;
+	}
+
+	return visibleCount;
+}
+
+void CFBXFrustum::TransformSphere(const FBX_BOUNDS& bounds, DirectX::CXMMATRIX matrix, DirectX::XMFLOAT4A* pSphere)
+{
+	const DirectX::XMFLOAT4A sphere(bounds.sphereCenter.x, bounds.sphereCenter.y, bounds.sphereCenter.z, bounds.sphereRadius);
+	TransformSphere(sphere, matrix, pSphere);
+}
+
+void CFBXFrustum::TransformSphere(const DirectX::XMFLOAT4A& sphere, DirectX::CXMMATRIX matrix, DirectX::XMFLOAT4A* pSphere)
+{
+	using namespace DirectX;
+
+	const XMVECTOR center = XMVector3Transform(XMLoadFloat4A(&sphere), matrix);
+	const XMVECTOR scaleSq = XMVectorMax(XMVector3LengthSq(matrix.r[0]), XMVectorMax(XMVector3LengthSq(matrix.r[1]), XMVector3LengthSq(matrix.r[2])));
+	const float radius = sphere.w * sqrtf(XMVectorGetX(scaleSq));
+
+	XMStoreFloat4A(pSphere, XMVectorSetW(center, radius));
+}
+
+}	// namespace FBX_LOADER
@@ -0,0 +1,57 @@
+// *********************************************************************************************************************
+///
+/// @file 		CFBXFrustum.h
+/// @brief		ƋE̔. 4܂Ƃ߂SIMDŃJO
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include <DirectXMath.h>
+
+#include "CFBXLoader.h"
+
+namespace FBX_LOADER
+{
+
+// E. xyzS, wa. XMLoadFloat4Ał̂܂ܓǂ߂
+typedef std::vector<DirectX::XMFLOAT4A, ALIGNED_ALLOCATOR<DirectX::XMFLOAT4A>>	FBX_SPHERE_STREAM;
+
+// SetMatrixɓns̑O̍WŔ肷.
+// view * projectionȂ烏[hW, world * view * projectionȂworld|O̍W
+class CFBXFrustum
+{
+public:
+	enum
+	{
+		PLANE_COUNT = 6,	// , E, , , , 
+	};
+
+private:
+	DirectX::XMFLOAT4A	m_planeArray[PLANE_COUNT];	// (ax + by + cz + d >= 0), (a, b, c)͐Kς
+
+public:
+	CFBXFrustum();
+
+	// s̗񂩂6ʂo. D3D̎ˉeȂ̂ŋߕʂz >= 0
+	void SetMatrix(const DirectX::XMFLOAT4X4& viewProjection);
+
+	bool IsVisible(const DirectX::XMFLOAT4A& sphere) const;
+
+	// 鋅̓YpVisibleIndicesɑO珑, ̐Ԃ. 4SƔaבւ6ʂƔׂ
+	uint32_t CullSpheres(const DirectX::XMFLOAT4A* pSpheres, const uint32_t count, uint32_t* pVisibleIndices) const;
+
+	// [JW̋Ematrixœ. a͈ԑ傫̊g嗦ōL
+	static void TransformSphere(const FBX_BOUNDS& bounds, DirectX::CXMMATRIX matrix, DirectX::XMFLOAT4A* pSphere);
+	static void TransformSphere(const DirectX::XMFLOAT4A& sphere, DirectX::CXMMATRIX matrix, DirectX::XMFLOAT4A* pSphere);
+
+	const DirectX::XMFLOAT4A& GetPlane(const uint32_t planeId) const { return m_planeArray[planeId]; }
+};
+
+}	// namespace FBX_LOADER
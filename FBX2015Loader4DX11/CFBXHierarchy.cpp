@@ -0,0 +1,347 @@
+// *********************************************************************************************************************
+///
+/// @file 		CFBXHierarchy.cpp
+/// @brief		Rm[hKw. ύXm[h̕؂[hsvZ
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#include "CFBXHierarchy.h"
+
+#include <algorithm>
+
+namespace FBX_LOADER
+{
+
+CFBXHierarchy::CFBXHierarchy()
+	: m_nextTask(0)
+{
+	m_jobSerial = 0;
+	m_runningCount = 0;
+	m_stopWorkers = false;
+}
+
+CFBXHierarchy::~CFBXHierarchy()
+{
+	Release();
+}
+
+void CFBXHierarchy::Release()
+{
+	StopWorkers();
+
+	m_parentArray.clear();
+	m_subtreeEndArray.clear();
+	m_localArray.clear();
+	m_worldArray.clear();
+	m_dirtyArray.clear();
+	m_dirtyList.clear();
+	m_rangeArray.clear();
+	m_taskArray.clear();
+	m_splitStack.clear();
+	m_stats.Reset();
+}
+
+HRESULT CFBXHierarchy::Initialize(const size_t nodeCount, const int32_t* pParents, const DirectX::XMFLOAT4X4* pWorlds)
+{
+	Release();
+
+	if(nodeCount==0)
+		return S_OK;
+	if(!pParents || !pWorlds || nodeCount >= 0xffffffff)
+		return E_INVALIDARG;
+
+	// sȂ, e1Õm[h̑ĉǂꂩ
+	for(size_t i=0;i<nodeCount;i++)
+	{
+		const int32_t parent = pParents[i];
+		if(parent < -1 || parent >= static_cast<int32_t>(i))
+			return E_INVALIDARG;
+
+		int32_t ancestor = static_cast<int32_t>(i) - 1;
+		while(ancestor > parent)
+			ancestor = pParents[ancestor];
+		if(ancestor != parent)
+			return E_INVALIDARG;
+	}
+
+	m_parentArray.assign(pParents, pParents + nodeCount);
+	m_worldArray.assign(pWorlds, pWorlds + nodeCount);
+	m_localArray.resize(nodeCount);
+	m_dirtyArray.assign(nodeCount, 0);
+
+	// q͐eɂ̂, 납Ȃ߂Ύq̕؂̏I肪Ɍ܂
+	m_subtreeEndArray.resize(nodeCount);
+	for(size_t i=0;i<nodeCount;i++)
+		m_subtreeEndArray[i] = static_cast<uint32_t>(i + 1);
+	for(size_t i=nodeCount;i-->0;)
+	{
+		const int32_t parent = m_parentArray[i];
+		if(parent >= 0)
+			m_subtreeEndArray[parent] = std::max(m_subtreeEndArray[parent], m_subtreeEndArray[i]);
+	}
+
+	for(size_t i=0;i<nodeCount;i++)
+	{
+		const int32_t parent = m_parentArray[i];
+		if(parent < 0)
+		{
+			m_localArray[i] = m_worldArray[i];
+			continue;
+		}
+
+		DirectX::XMVECTOR determinant;
+		const DirectX::XMMATRIX parentInverse = DirectX::XMMatrixInverse(&determinant, DirectX::XMLoadFloat4x4(&m_worldArray[parent]));
+		DirectX::XMStoreFloat4x4(&m_localArray[i], DirectX::XMMatrixMultiply(DirectX::XMLoadFloat4x4(&m_worldArray[i]), parentInverse));
+	}
+
+	return S_OK;
+}
+
+void CFBXHierarchy::SetLocal(const uint32_t nodeId, const DirectX::XMFLOAT4X4& local)
+{
+	m_localArray[nodeId] = local;
+	if(!m_dirtyArray[nodeId])
+	{
+		m_dirtyArray[nodeId] = 1;
+		m_dirtyList.push_back(nodeId);
+	}
+}
+
+// ԍɕׂƑc͎qOɗ̂, O̕؂Ɋ܂܂m[h΂
+// dȂȂ؂̍c
+void CFBXHierarchy::CollectDirtyRanges()
+{
+	std::sort(m_dirtyList.begin(), m_dirtyList.end());
+
+	m_rangeArray.clear();
+	uint32_t coveredEnd = 0;
+	for(size_t i=0;i<m_dirtyList.size();i++)
+	{
+		const uint32_t nodeId = m_dirtyList[i];
+		if(nodeId < coveredEnd)
+			continue;
+
+		UPDATE_RANGE range;
+		range.first = nodeId;
+		range.end = m_subtreeEndArray[nodeId];
+		m_rangeArray.push_back(range);
+		coveredEnd = range.end;
+	}
+	m_dirtyList.clear();
+
+	m_stats.dirtyRootCount = static_cast<uint32_t>(m_rangeArray.size());
+	for(size_t i=0;i<m_rangeArray.size();i++)
+		m_stats.updatedNodeCount += m_rangeArray[i].end - m_rangeArray[i].first;
+}
+
+// sȂ̂, e͕K͈͂̑O͈͂̊̕O(vZς)ɂ
+void CFBXHierarchy::UpdateRange(const uint32_t first, const uint32_t end)
+{
+	using namespace DirectX;
+
+	for(uint32_t i=first;i<end;i++)
+	{
+		XMMATRIX world = XMLoadFloat4x4(&m_localArray[i]);
+		const int32_t parent = m_parentArray[i];
+		if(parent >= 0)
+			world = XMMatrixMultiply(world, XMLoadFloat4x4(&m_worldArray[parent]));
+
+		XMStoreFloat4x4(&m_worldArray[i], world);
+		m_dirtyArray[i] = 0;
+	}
+}
+
+void CFBXHierarchy::Update()
+{
+	m_stats.Reset();
+	m_stats.threadCount = 1;
+	if(m_dirtyList.empty())
+		return ;
+
+	CollectDirtyRanges();
+	for(size_t i=0;i<m_rangeArray.size();i++)
+		UpdateRange(m_rangeArray[i].first, m_rangeArray[i].end);
+	m_stats.taskCount = static_cast<uint32_t>(m_rangeArray.size());
+}
+
+// PARALLEL_GRAIN傫ȕ؂͍ŌvZ, q̕؂ɕ.
+// Z̕؂ׂ͗荇Ă̂, Ȃ̂͑1͈̔͂ɂ܂Ƃ߂
+void CFBXHierarchy::SplitRanges()
+{
+	m_taskArray.clear();
+	for(size_t r=0;r<m_rangeArray.size();r++)
+	{
+		m_splitStack.clear();
+		m_splitStack.push_back(m_rangeArray[r].first);
+
+		while(!m_splitStack.empty())
+		{
+			const uint32_t nodeId = m_splitStack.back();
+			m_splitStack.pop_back();
+
+			const uint32_t end = m_subtreeEndArray[nodeId];
+			UPDATE_RANGE range;
+			if(end - nodeId <= PARALLEL_GRAIN)
+			{
+				range.first = nodeId;
+				range.end = end;
+				m_taskArray.push_back(range);
+				continue;
+			}
+
+			UpdateRange(nodeId, nodeId + 1);
+
+			range.first = nodeId + 1;
+			range.end = nodeId + 1;
+			for(uint32_t child=nodeId+1;child<end;child=m_subtreeEndArray[child])
+			{
+				const uint32_t childEnd = m_subtreeEndArray[child];
+				if(childEnd - child > PARALLEL_GRAIN)
+				{
+					if(range.end > range.first)
+						m_taskArray.push_back(range);
+					m_splitStack.push_back(child);
+					range.first = childEnd;
+					range.end = childEnd;
+					continue;
+				}
+
+				if(childEnd - range.first > PARALLEL_GRAIN)
+				{
+					if(range.end > range.first)
+						m_taskArray.push_back(range);
+					range.first = child;
+				}
+				range.end = childEnd;
+			}
+			if(range.end > range.first)
+				m_taskArray.push_back(range);
+		}
+	}
+}
+
+// ͈͓m͏dȂ炸, e͕OɌvZĂ
+void CFBXHierarchy::UpdateParallel(const unsigned int threadCount)
+{
+	if(m_dirtyList.empty())
+	{
+		m_stats.Reset();
+		return ;
+	}
+
+	unsigned int workerCount = threadCount;
+	if(workerCount==0)
+		workerCount = std::thread::hardware_concurrency();
+	if(workerCount==0)
+		workerCount = 1;
+
+	m_stats.Reset();
+	CollectDirtyRanges();
+	if(workerCount==1 || m_stats.updatedNodeCount < PARALLEL_MIN_NODES)
+	{
+		for(size_t i=0;i<m_rangeArray.size();i++)
+			UpdateRange(m_rangeArray[i].first, m_rangeArray[i].end);
+		m_stats.taskCount = static_cast<uint32_t>(m_rangeArray.size());
+		m_stats.threadCount = 1;
+		return ;
+	}
+
+	SplitRanges();
+
+	const size_t taskCount = m_taskArray.size();
+
+	// ĂяoXbh[J[ƂĎg. [J[͔͈̐͂̐Ɋ֌WȂۂ, ][J[͉ɑҋ@ɖ߂
+	StartWorkers(workerCount - 1);
+
+	m_nextTask = 0;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_jobSerial++;
+		m_runningCount = static_cast<uint32_t>(m_workerArray.size());
+	}
+	m_jobCondition.notify_all();
+
+	RunTasks();
+
+	// ̌Ăяom_taskArraŷ, SẴ[J[܂ő҂
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_doneCondition.wait(lock, [this]{ return m_runningCount == 0; });
+	}
+
+	if(workerCount > taskCount)
+		workerCount = static_cast<unsigned int>(std::max(taskCount, static_cast<size_t>(1)));
+
+	m_stats.taskCount = static_cast<uint32_t>(taskCount);
+	m_stats.threadCount = workerCount;
+}
+
+void CFBXHierarchy::StartWorkers(const size_t workerCount)
+{
+	if(m_workerArray.size() == workerCount)
+		return ;
+
+	StopWorkers();
+
+	// [J[܂ł̍XVVdƌȂȂ悤, ̔ԍn
+	for(size_t i=0;i<workerCount;i++)
+		m_workerArray.push_back(std::thread(&CFBXHierarchy::WorkerThread, this, m_jobSerial));
+}
+
+void CFBXHierarchy::StopWorkers()
+{
+	if(m_workerArray.empty())
+		return ;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopWorkers = true;
+	}
+	m_jobCondition.notify_all();
+
+	for(size_t i=0;i<m_workerArray.size();i++)
+		m_workerArray[i].join();
+	m_workerArray.clear();
+
+	m_stopWorkers = false;
+}
+
+// eXbh͋󂢂Ă͈͂Ɏɍs
+void CFBXHierarchy::RunTasks()
+{
+	const size_t taskCount = m_taskArray.size();
+	for(;;)
+	{
+		const size_t i = m_nextTask.fetch_add(1);
+		if(i >= taskCount)
+			break;
+
+		UpdateRange(m_taskArray[i].first, m_taskArray[i].end);
+	}
+}
+
+void CFBXHierarchy::WorkerThread(uint32_t jobSerial)
+{
+	for(;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_jobCondition.wait(lock, [&]{ return m_stopWorkers || m_jobSerial != jobSerial; });
+			if(m_stopWorkers)
+				return ;
+
+			jobSerial = m_jobSerial;
+		}
+
+		RunTasks();
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if(--m_runningCount == 0)
+			m_doneCondition.notify_one();
+	}
+}
+
+}	// namespace FBX_LOADER
@@ -0,0 +1,134 @@
+// *********************************************************************************************************************
+///
+/// @file 		CFBXHierarchy.h
+/// @brief		Rm[hKw. ύXm[h̕؂[hsvZ
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+#include <windows.h>
+#include <DirectXMath.h>
+
+namespace FBX_LOADER
+{
+
+// OUpdate/UpdateParallelōs
+struct HIERARCHY_UPDATE_STATS
+{
+	uint32_t	dirtyRootCount;		// vZ؂̐(̕؂Ɋ܂܂̂)
+	uint32_t	updatedNodeCount;	// [hsvZm[h
+	uint32_t	taskCount;			// 񎞂ɕ͈͂̐
+	uint32_t	threadCount;
+
+	HIERARCHY_UPDATE_STATS()
+	{
+		Reset();
+	}
+
+	void Reset()
+	{
+		dirtyRootCount = 0;
+		updatedNodeCount = 0;
+		taskCount = 0;
+		threadCount = 0;
+	}
+};
+
+// m[h͐[D̍s(CFBXLoader, CFBXRendererDX11̃m[hƓ), e͎qO, ؂[i, GetSubtreeEnd(i))ɘA.
+// [Jsƃ[hs̓m[h̕ʁX̔zɎ, SetLocalm[hoĂ.
+// Update͕ύXm[hבւ, c悪ύXĂȂ̕؂O珇ɌvZ
+class CFBXHierarchy
+{
+public:
+	enum
+	{
+		PARALLEL_GRAIN = 1024,			// 񎞂1͈̖̔͂ڈ. 傫ȕ؂͍ɌvZĎq̕؂ɕ
+		PARALLEL_MIN_NODES = 8192,		// vZm[hꖢȂɂȂ
+	};
+
+private:
+	// [first, end)OvZ. first̐e͌vZς݂ł邱
+	struct UPDATE_RANGE
+	{
+		uint32_t	first;
+		uint32_t	end;
+	};
+
+	std::vector<int32_t>				m_parentArray;		// -1
+	std::vector<uint32_t>				m_subtreeEndArray;	// ؂̏I(܂܂Ȃ)
+	std::vector<DirectX::XMFLOAT4X4>	m_localArray;
+	std::vector<DirectX::XMFLOAT4X4>	m_worldArray;
+	std::vector<uint8_t>				m_dirtyArray;		// SetLocalĂ܂UpdateĂȂ
+	std::vector<uint32_t>				m_dirtyList;		// m_dirtyArrayĂm[h(dȂ)
+
+	std::vector<UPDATE_RANGE>			m_rangeArray;		// Update̍Ɨ̈. vZ镔
+	std::vector<UPDATE_RANGE>			m_taskArray;		// UpdateParallel̍Ɨ̈. Xbhɔz͈
+	std::vector<uint32_t>				m_splitStack;
+
+	HIERARCHY_UPDATE_STATS				m_stats;
+
+	// UpdateParallel̃[J[. ŏ̕XVō, Release܂őҋ@Ă
+	std::vector<std::thread>			m_workerArray;
+	std::mutex							m_mutex;
+	std::condition_variable				m_jobCondition;
+	std::condition_variable				m_doneCondition;	// m_runningCount0ɂȂ
+	uint32_t							m_jobSerial;		// XVzxɑ₷
+	uint32_t							m_runningCount;		// ̍XV܂IĂȂ[J[
+	bool								m_stopWorkers;
+	std::atomic<size_t>					m_nextTask;			// Ɏm_taskArray̓Y
+
+	void CollectDirtyRanges();
+	void SplitRanges();
+	void UpdateRange(const uint32_t first, const uint32_t end);
+
+	void StartWorkers(const size_t workerCount);
+	void StopWorkers();
+	void RunTasks();
+	void WorkerThread(uint32_t jobSerial);
+
+	CFBXHierarchy(const CFBXHierarchy&);
+	CFBXHierarchy& operator=(const CFBXHierarchy&);
+
+public:
+	CFBXHierarchy();
+	~CFBXHierarchy();
+
+	void Release();
+
+	// pParents͐e̓Y(-1), pWorlds͊em[h̃[hs(FBX_MESH_NODE::mat4x4Ȃ).
+	// [Js͐ẽ[hs̋ts|ċ߂. тsłȂE_INVALIDARG
+	HRESULT Initialize(const size_t nodeCount, const int32_t* pParents, const DirectX::XMFLOAT4X4* pWorlds);
+
+	// Update, ̃m[hƎq̃[hsvZ
+	void SetLocal(const uint32_t nodeId, const DirectX::XMFLOAT4X4& local);
+
+	void Update();
+	// ύXꂽ؂PARALLEL_GRAINx͈̔͂ɕăXbhŌvZ.
+	// threadCount0Ȃn[hEFAXbh. ĂяoXbh̑threadCount-1̃[J[ŏ̌Ăяoō,
+	// ͎g(threadCountςƍ蒼). [J[ReleasefXgN^Ŏ~߂
+	void UpdateParallel(const unsigned int threadCount = 0);
+
+	size_t GetNodeCount() const { return m_parentArray.size(); }
+	int32_t GetParent(const uint32_t nodeId) const { return m_parentArray[nodeId]; }
+	uint32_t GetSubtreeEnd(const uint32_t nodeId) const { return m_subtreeEndArray[nodeId]; }
+	const DirectX::XMFLOAT4X4& GetLocal(const uint32_t nodeId) const { return m_localArray[nodeId]; }
+	// OUpdatě
+	const DirectX::XMFLOAT4X4& GetWorld(const uint32_t nodeId) const { return m_worldArray[nodeId]; }
+	// CFBXRenderQueue::SubmitAllpNodeMatricesɂ̂܂ܓn
+	const DirectX::XMFLOAT4X4* GetWorldArray() const { return m_worldArray.empty() ? nullptr : &m_worldArray[0]; }
+	bool IsDirty() const { return !m_dirtyList.empty(); }
+	const HIERARCHY_UPDATE_STATS& GetStats() const { return m_stats; }
+};
+
+}	// namespace FBX_LOADER
@@ -0,0 +1,296 @@
+// *********************************************************************************************************************
+///
+/// @file 		CFBXInstanceBuffer.cpp
+/// @brief		CX^VOp̃[hs\obt@. JOƕύX̃Abv[hs
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#include "CFBXInstanceBuffer.h"
+
+#include <algorithm>
+
+namespace FBX_LOADER
+{
+
+static const uint32_t INVALID_SLOT = 0xffffffff;
+
+CFBXInstanceBuffer::CFBXInstanceBuffer()
+{
+	for(int i=0;i<BUFFER_COUNT;i++)
+	{
+		m_bufferArray[i].pBuffer = nullptr;
+		m_bufferArray[i].pSRV = nullptr;
+	}
+	m_capacity = 0;
+	m_front = 0;
+	m_version = 0;
+	m_boundsCenter = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+	m_boundsRadius = 0.0f;
+}
+
+CFBXInstanceBuffer::~CFBXInstanceBuffer()
+{
+	Release();
+}
+
+HRESULT CFBXInstanceBuffer::Initialize(ID3D11Device* pd3dDevice, const uint32_t capacity)
+{
+	if(!pd3dDevice)
+		return E_FAIL;
+
+	Release();
+
+	return CreateBuffers(pd3dDevice, capacity > 0 ? capacity : static_cast<uint32_t>(DEFAULT_CAPACITY));
+}
+
+void CFBXInstanceBuffer::Release()
+{
+	ReleaseBuffers();
+
+	m_instanceArray.clear();
+	m_versionArray.clear();
+	m_visibleArray.clear();
+	m_uploadArray.clear();
+	m_stats.Reset();
+}
+
+void CFBXInstanceBuffer::ReleaseBuffers()
+{
+	for(int i=0;i<BUFFER_COUNT;i++)
+	{
+		GPU_BUFFER& buffer = m_bufferArray[i];
+		if(buffer.pSRV)
+		{
+			buffer.pSRV->Release();
+			buffer.pSRV = nullptr;
+		}
+		if(buffer.pBuffer)
+		{
+			buffer.pBuffer->Release();
+			buffer.pBuffer = nullptr;
+		}
+		buffer.slotInstanceArray.clear();
+		buffer.slotVersionArray.clear();
+	}
+	m_capacity = 0;
+	m_front = 0;
+}
+
+// 蒼ƒg͖Ȃ̂, SXbgɂĎUpdateőS
+HRESULT CFBXInstanceBuffer::CreateBuffers(ID3D11Device* pd3dDevice, const uint32_t capacity)
+{
+	ReleaseBuffers();
+
+	const uint32_t stride = static_cast<uint32_t>(sizeof(INSTANCE_DATA));
+
+	for(int i=0;i<BUFFER_COUNT;i++)
+	{
+		GPU_BUFFER& buffer = m_bufferArray[i];
+
+		// Iɏ̂DYNAMIC(ŜDISCARD)ł͂ȂDEFAULTɂUpdateSubresourceŔ͈͂𑗂
+		D3D11_BUFFER_DESC bd;
+		ZeroMemory(&bd, sizeof(bd));
+		bd.Usage = D3D11_USAGE_DEFAULT;
+		bd.ByteWidth = stride * capacity;
+		bd.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+		bd.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+		bd.StructureByteStride = stride;
+		HRESULT hr = pd3dDevice->CreateBuffer(&bd, nullptr, &buffer.pBuffer);
+		if(FAILED(hr))
+		{
+			ReleaseBuffers();
+			return hr;
+		}
+
+		D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc;
+		ZeroMemory(&srvDesc, sizeof(srvDesc));
+		srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFEREX;
+		srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+		srvDesc.BufferEx.FirstElement = 0;
+		srvDesc.BufferEx.NumElements = capacity;
+		hr = pd3dDevice->CreateShaderResourceView(buffer.pBuffer, &srvDesc, &buffer.pSRV);
+		if(FAILED(hr))
+		{
+			ReleaseBuffers();
+			return hr;
+		}
+
+		buffer.slotInstanceArray.assign(capacity, INVALID_SLOT);
+		buffer.slotVersionArray.assign(capacity, 0);
+	}
+
+	m_capacity = capacity;
+	m_uploadArray.resize(capacity);
+
+	return S_OK;
+}
+
+uint32_t CFBXInstanceBuffer::AddInstance(const DirectX::XMFLOAT4X4& world)
+{
+	INSTANCE_DATA data;
+	data.world = world;
+	m_instanceArray.push_back(data);
+	m_versionArray.push_back(++m_version);
+	return static_cast<uint32_t>(m_instanceArray.size() - 1);
+}
+
+void CFBXInstanceBuffer::SetInstance(const uint32_t instanceId, const DirectX::XMFLOAT4X4& world)
+{
+	if(instanceId >= m_instanceArray.size())
+		return ;
+
+	m_instanceArray[instanceId].world = world;
+	m_versionArray[instanceId] = ++m_version;
+}
+
+// ԍg񂳂̂, ł͖߂Ȃ(XbgɎcĂÂłƈvȂ悤)
+void CFBXInstanceBuffer::Clear()
+{
+	m_instanceArray.clear();
+	m_versionArray.clear();
+	m_visibleArray.clear();
+}
+
+void CFBXInstanceBuffer::SetLocalBounds(const DirectX::XMFLOAT3& center, const float radius)
+{
+	m_boundsCenter = center;
+	m_boundsRadius = radius;
+}
+
+void CFBXInstanceBuffer::SetLocalBounds(const FBX_BOUNDS& bounds)
+{
+	SetLocalBounds(DirectX::XMFLOAT3(bounds.sphereCenter.x, bounds.sphereCenter.y, bounds.sphereCenter.z),
+		bounds.IsValid() ? bounds.sphereRadius : 0.0f);
+}
+
+// ECX^X̍sœĂ, world * view * projection̎Ƃ܂Ƃ߂Ĕׂ
+void CFBXInstanceBuffer::Cull(const DirectX::XMFLOAT4X4& world, const DirectX::XMFLOAT4X4& view, const DirectX::XMFLOAT4X4& projection)
+{
+	const uint32_t instanceCount = static_cast<uint32_t>(m_instanceArray.size());
+
+	m_visibleArray.clear();
+	if(m_boundsRadius <= 0.0f)
+	{
+		for(uint32_t i=0;i<instanceCount;i++)
+			m_visibleArray.push_back(i);
+		return ;
+	}
+
+	DirectX::XMFLOAT4X4 worldViewProjection;
+	DirectX::XMStoreFloat4x4(&worldViewProjection, DirectX::XMMatrixMultiply(DirectX::XMMatrixMultiply(
+		DirectX::XMLoadFloat4x4(&world), DirectX::XMLoadFloat4x4(&view)), DirectX::XMLoadFloat4x4(&projection)));
+
+	CFBXFrustum frustum;
+	frustum.SetMatrix(worldViewProjection);
+
+	const DirectX::XMFLOAT4A localSphere(m_boundsCenter.x, m_boundsCenter.y, m_boundsCenter.z, m_boundsRadius);
+	m_sphereArray.resize(instanceCount);
+	for(uint32_t i=0;i<instanceCount;i++)
+		CFBXFrustum::TransformSphere(localSphere, DirectX::XMLoadFloat4x4(&m_instanceArray[i].world), &m_sphereArray[i]);
+
+	if(instanceCount==0)
+		return ;
+
+	m_visibleArray.resize(instanceCount);
+	m_visibleArray.resize(frustum.CullSpheres(&m_sphereArray[0], instanceCount, &m_visibleArray[0]));
+}
+
+// Xbg[first, last]𑗂. ͈͓̕ςĂȂXbglŏ㏑
+void CFBXInstanceBuffer::Upload(ID3D11DeviceContext* pContext, GPU_BUFFER& buffer, const uint32_t first, const uint32_t last)
+{
+	for(uint32_t s=first;s<=last;s++)
+	{
+		const uint32_t instanceId = m_visibleArray[s];
+		m_uploadArray[s] = m_instanceArray[instanceId];
+		buffer.slotInstanceArray[s] = instanceId;
+		buffer.slotVersionArray[s] = m_versionArray[instanceId];
+	}
+
+	const UINT stride = static_cast<UINT>(sizeof(INSTANCE_DATA));
+
+	D3D11_BOX box;
+	box.left = first * stride;
+	box.right = (last + 1) * stride;
+	box.top = 0;
+	box.bottom = 1;
+	box.front = 0;
+	box.back = 1;
+	pContext->UpdateSubresource(buffer.pBuffer, 0, &box, &m_uploadArray[first], 0, 0);
+
+	m_stats.uploadCount += last - first + 1;
+	m_stats.uploadRangeCount++;
+	m_stats.uploadBytes += box.right - box.left;
+}
+
+HRESULT CFBXInstanceBuffer::Update(ID3D11DeviceContext* pContext, const DirectX::XMFLOAT4X4& world,
+	const DirectX::XMFLOAT4X4& view, const DirectX::XMFLOAT4X4& projection)
+{
+	if(!pContext)
+		return E_FAIL;
+
+	m_stats.Reset();
+	m_stats.instanceCount = static_cast<uint32_t>(m_instanceArray.size());
+
+	Cull(world, view, projection);
+
+	const uint32_t visibleCount = static_cast<uint32_t>(m_visibleArray.size());
+	m_stats.visibleCount = visibleCount;
+	m_stats.culledCount = m_stats.instanceCount - visibleCount;
+
+	// {XōL, CX^XĂԂ̍蒼炷
+	if(visibleCount > m_capacity)
+	{
+		uint32_t capacity = std::max(m_capacity, static_cast<uint32_t>(DEFAULT_CAPACITY));
+		while(capacity < visibleCount)
+			capacity *= 2;
+
+		ID3D11Device* pd3dDevice = nullptr;
+		pContext->GetDevice(&pd3dDevice);
+		HRESULT hr = CreateBuffers(pd3dDevice, capacity);
+		pd3dDevice->Release();
+		if(FAILED(hr))
+		{
+			m_visibleArray.clear();
+			return hr;
+		}
+		m_stats.growCount++;
+	}
+
+	// `撆(Õt[Ŏg)łȂɏ
+	const uint32_t back = (m_front + 1) % BUFFER_COUNT;
+	GPU_BUFFER& buffer = m_bufferArray[back];
+
+	// ςXbg͈͂ɂ܂Ƃ߂. MERGE_GAPȉ̌ԂȂ瑱đ
+	bool hasRange = false;
+	uint32_t first = 0;
+	uint32_t last = 0;
+	for(uint32_t s=0;s<visibleCount;s++)
+	{
+		const uint32_t instanceId = m_visibleArray[s];
+		if(buffer.slotInstanceArray[s]==instanceId && buffer.slotVersionArray[s]==m_versionArray[instanceId])
+			continue;
+
+		if(hasRange && s - last > MERGE_GAP)
+		{
+			Upload(pContext, buffer, first, last);
+			hasRange = false;
+		}
+		if(!hasRange)
+		{
+			first = s;
+			hasRange = true;
+		}
+		last = s;
+	}
+	if(hasRange)
+		Upload(pContext, buffer, first, last);
+
+	m_front = back;
+
+	return S_OK;
+}
+
+}	// namespace FBX_LOADER
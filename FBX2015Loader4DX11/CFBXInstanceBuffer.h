@@ -0,0 +1,137 @@
+// *********************************************************************************************************************
+///
+/// @file 		CFBXInstanceBuffer.h
+/// @brief		CX^VOp̃[hs\obt@. JOƕύX̃Abv[hs
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include <d3d11.h>
+#include <DirectXMath.h>
+
+#include "CFBXFrustum.h"
+
+namespace FBX_LOADER
+{
+
+// simpleRenderInstancingVS.hlslPerInstanceData(t0)Ɠ. sXMMATRIX̂܂(]uȂ)
+struct INSTANCE_DATA
+{
+	DirectX::XMFLOAT4X4	world;
+};
+
+// OUpdateōs
+struct INSTANCE_BUFFER_STATS
+{
+	uint32_t	instanceCount;
+	uint32_t	visibleCount;		// JO. `悷CX^X
+	uint32_t	culledCount;
+	uint32_t	uploadCount;		// GPUɑCX^X(Ԃ𖄂߂܂)
+	uint32_t	uploadRangeCount;	// UpdateSubresourcẻ
+	uint64_t	uploadBytes;
+	uint32_t	growCount;			// eʂ肸Ƀobt@蒼
+
+	INSTANCE_BUFFER_STATS()
+	{
+		Reset();
+	}
+
+	void Reset()
+	{
+		instanceCount = 0;
+		visibleCount = 0;
+		culledCount = 0;
+		uploadCount = 0;
+		uploadRangeCount = 0;
+		uploadBytes = 0;
+		growCount = 0;
+	}
+};
+
+// CX^X̍sCPUɎ, UpdateŌ̂l߂GPUɑ.
+// GPŨobt@2݂Ɏg, `撆̃obt@ɂ͏܂Ȃ.
+// obt@ɊeXbg֍ŌɏCX^XƔłoĂ, ςXbg͈͂ł܂Ƃ߂đ.
+// s񂪕ς炸, CX^XςȂ, 2t[ڂ͉Ȃ
+class CFBXInstanceBuffer
+{
+public:
+	enum
+	{
+		BUFFER_COUNT = 2,
+		DEFAULT_CAPACITY = 256,
+		MERGE_GAP = 8,			// ȉ̌ԂȂύX͈͂1UpdateSubresourceɂ܂Ƃ߂
+	};
+
+private:
+	struct GPU_BUFFER
+	{
+		ID3D11Buffer*				pBuffer;
+		ID3D11ShaderResourceView*	pSRV;
+		std::vector<uint32_t>		slotInstanceArray;	// XbgɓĂCX^X. INVALID_SLOT
+		std::vector<uint32_t>		slotVersionArray;	// 񂾎̔
+	};
+
+	GPU_BUFFER		m_bufferArray[BUFFER_COUNT];
+	uint32_t		m_capacity;		// 1obt@ɓCX^X
+	uint32_t		m_front;		// `Ɏgobt@
+
+	std::vector<INSTANCE_DATA>	m_instanceArray;
+	std::vector<uint32_t>		m_versionArray;		// CX^X. sςxɐVłɂ
+	uint32_t					m_version;
+
+	std::vector<uint32_t>		m_visibleArray;		// JOʂCX^X. ̏ŃXbgɋl߂
+	std::vector<INSTANCE_DATA>	m_uploadArray;		// ͈͂l߂Ɨ̈. XbgƓY
+	FBX_SPHERE_STREAM			m_sphereArray;		// JOp. CX^X̋E(world|O̍W)
+
+	// JOp1CX^X̋E(CX^X̃[JW). a0ȉȂJOȂ
+	DirectX::XMFLOAT3	m_boundsCenter;
+	float				m_boundsRadius;
+
+	INSTANCE_BUFFER_STATS	m_stats;
+
+	CFBXInstanceBuffer(const CFBXInstanceBuffer&);
+	CFBXInstanceBuffer& operator=(const CFBXInstanceBuffer&);
+
+	HRESULT CreateBuffers(ID3D11Device* pd3dDevice, const uint32_t capacity);
+	void ReleaseBuffers();
+	void Cull(const DirectX::XMFLOAT4X4& world, const DirectX::XMFLOAT4X4& view, const DirectX::XMFLOAT4X4& projection);
+	void Upload(ID3D11DeviceContext* pContext, GPU_BUFFER& buffer, const uint32_t first, const uint32_t last);
+
+public:
+	CFBXInstanceBuffer();
+	~CFBXInstanceBuffer();
+
+	HRESULT Initialize(ID3D11Device* pd3dDevice, const uint32_t capacity = DEFAULT_CAPACITY);
+	void Release();
+
+	// CX^X̔ԍԂ. ԍClear܂ŕςȂ
+	uint32_t AddInstance(const DirectX::XMFLOAT4X4& world);
+	void SetInstance(const uint32_t instanceId, const DirectX::XMFLOAT4X4& world);
+	const DirectX::XMFLOAT4X4& GetInstance(const uint32_t instanceId) const { return m_instanceArray[instanceId].world; }
+	void Clear();
+	size_t GetInstanceCount() const { return m_instanceArray.size(); }
+
+	void SetLocalBounds(const DirectX::XMFLOAT3& center, const float radius);
+	// m[h̋Eg(CFBXRenderDX11::GetNodeBounds)
+	void SetLocalBounds(const FBX_BOUNDS& bounds);
+
+	// JOĕ`Ɏgobt@XV. world̓CX^X̍šɊ|s(CFBXRenderQueueworldƓ).
+	// eʂȂpContext̃foCXō蒼
+	HRESULT Update(ID3D11DeviceContext* pContext, const DirectX::XMFLOAT4X4& world,
+		const DirectX::XMFLOAT4X4& view, const DirectX::XMFLOAT4X4& projection);
+
+	// OUpdatě. _VF[_t0ɐݒ肵, GetVisibleCount̃CX^Xŕ`悷
+	ID3D11ShaderResourceView* GetSRV() const { return m_bufferArray[m_front].pSRV; }
+	uint32_t GetVisibleCount() const { return static_cast<uint32_t>(m_visibleArray.size()); }
+	uint32_t GetCapacity() const { return m_capacity; }
+	const INSTANCE_BUFFER_STATS& GetStats() const { return m_stats; }
+};
+
+}	// namespace FBX_LOADER
@@ -0,0 +1,293 @@
+// *********************************************************************************************************************
+///
+/// @file 		CFBXLoadStats.cpp
+/// @brief		ǂݍ݂̒iKƂ̏vԂƃJE^
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#include "CFBXLoadStats.h"
+
+#include <stdio.h>
+#include <algorithm>
+
+namespace FBX_LOADER
+{
+
+static const char* s_stageName[FBX_LOAD_STAGE_MAX] =
+{
+	"sdkInitialize",
+	"importerInitialize",
+	"import",
+	"axisConvert",
+	"unitConvert",
+	"triangulate",
+	"setup",
+	"buildNodes",
+	"animationBake",
+	"createNodes",
+	"meshCacheRead",
+	"meshCacheWrite",
+};
+
+static FBX_LOAD_STATS::ALLOCATION_COUNTER s_pAllocationCounter = nullptr;
+
+void FBX_LOAD_STATS::Reset()
+{
+	for(int i=0;i<FBX_LOAD_STAGE_MAX;i++)
+	{
+		stageTime[i] = 0.0;
+		stageAllocCount[i] = 0;
+	}
+
+	nodeCount = 0;
+	meshNodeCount = 0;
+	triangulatedCount = 0;
+	buildThreadCount = 0;
+	sourceVertexCount = 0;
+	vertexCount = 0;
+	indexCount = 0;
+	vertexDataBytes = 0;
+	skinnedNodeCount = 0;
+	skinBoneCount = 0;
+	animatedNodeCount = 0;
+	animationFrameCount = 0;
+	animationBytes = 0;
+	animationRawBytes = 0;
+	animationMaxError = 0.0f;
+
+	bufferVertexCount = 0;
+	bufferIndexCount = 0;
+	bufferBytes = 0;
+	indexBytesSaved = 0;
+	bufferCreateCount = 0;
+	vertexStride = 0;
+	vertexPositionError = 0.0f;
+	vertexNormalError = 0.0f;
+	vertexTexcoordError = 0.0f;
+	scratchBytes = 0;
+	scratchPeakBytes = 0;
+	scratchHeapAllocCount = 0;
+	sharedStateCount = 0;
+	sharedStateHitCount = 0;
+	textureHitCount = 0;
+	textureLoadCount = 0;
+	textureFailCount = 0;
+	textureBytesRead = 0;
+	texturePendingCount = 0;
+	meshCacheHit = 0;
+}
+
+void FBX_LOAD_STATS::Add(const FBX_LOAD_STATS& other)
+{
+	for(int i=0;i<FBX_LOAD_STAGE_MAX;i++)
+	{
+		stageTime[i] += other.stageTime[i];
+		stageAllocCount[i] += other.stageAllocCount[i];
+	}
+
+	nodeCount += other.nodeCount;
+	meshNodeCount += other.meshNodeCount;
+	triangulatedCount += other.triangulatedCount;
+	buildThreadCount = std::max(buildThreadCount, other.buildThreadCount);
+	sourceVertexCount += other.sourceVertexCount;
+	vertexCount += other.vertexCount;
+	indexCount += other.indexCount;
+	vertexDataBytes += other.vertexDataBytes;
+	skinnedNodeCount += other.skinnedNodeCount;
+	skinBoneCount += other.skinBoneCount;
+	animatedNodeCount += other.animatedNodeCount;
+	animationFrameCount = std::max(animationFrameCount, other.animationFrameCount);
+	animationBytes += other.animationBytes;
+	animationRawBytes += other.animationRawBytes;
+	animationMaxError = std::max(animationMaxError, other.animationMaxError);
+
+	bufferVertexCount += other.bufferVertexCount;
+	bufferIndexCount += other.bufferIndexCount;
+	bufferBytes += other.bufferBytes;
+	indexBytesSaved += other.indexBytesSaved;
+	bufferCreateCount += other.bufferCreateCount;
+	vertexStride = std::max(vertexStride, other.vertexStride);
+	vertexPositionError = std::max(vertexPositionError, other.vertexPositionError);
+	vertexNormalError = std::max(vertexNormalError, other.vertexNormalError);
+	vertexTexcoordError = std::max(vertexTexcoordError, other.vertexTexcoordError);
+	scratchBytes = std::max(scratchBytes, other.scratchBytes);
+	scratchPeakBytes = std::max(scratchPeakBytes, other.scratchPeakBytes);
+	scratchHeapAllocCount += other.scratchHeapAllocCount;
+	sharedStateCount = std::max(sharedStateCount, other.sharedStateCount);
+	sharedStateHitCount += other.sharedStateHitCount;
+	textureHitCount += other.textureHitCount;
+	textureLoadCount += other.textureLoadCount;
+	textureFailCount += other.textureFailCount;
+	textureBytesRead += other.textureBytesRead;
+	texturePendingCount += other.texturePendingCount;
+	meshCacheHit |= other.meshCacheHit;
+}
+
+double FBX_LOAD_STATS::GetTotalTime() const
+{
+	double total = 0.0;
+	for(int i=0;i<FBX_LOAD_STAGE_MAX;i++)
+		total += stageTime[i];
+	return total;
+}
+
+const char* FBX_LOAD_STATS::GetStageName(const FBX_LOAD_STAGE stage)
+{
+	if(stage < 0 || stage >= FBX_LOAD_STAGE_MAX)
+		return "";
+	return s_stageName[stage];
+}
+
+void FBX_LOAD_STATS::SetAllocationCounter(ALLOCATION_COUNTER pCounter)
+{
+	s_pAllocationCounter = pCounter;
+}
+
+uint64_t FBX_LOAD_STATS::GetAllocationCount()
+{
+	return s_pAllocationCounter ? s_pAllocationCounter() : 0;
+}
+
+std::string FBX_LOAD_STATS::ToJSON() const
+{
+	char buf[256];
+	std::string json = "{\n\t\"stageTimeMs\": {\n";
+
+	for(int i=0;i<FBX_LOAD_STAGE_MAX;i++)
+	{
+		sprintf_s(buf, sizeof(buf), "\t\t\"%s\": %.3f,\n", s_stageName[i], stageTime[i]);
+		json += buf;
+	}
+	sprintf_s(buf, sizeof(buf), "\t\t\"total\": %.3f\n\t},\n", GetTotalTime());
+	json += buf;
+
+	json += "\t\"stageAllocCount\": {\n";
+	for(int i=0;i<FBX_LOAD_STAGE_MAX;i++)
+	{
+		sprintf_s(buf, sizeof(buf), "\t\t\"%s\": %llu%s\n", s_stageName[i], stageAllocCount[i], (i+1 < FBX_LOAD_STAGE_MAX) ? "," : "");
+		json += buf;
+	}
+	json += "\t},\n";
+
+	sprintf_s(buf, sizeof(buf), "\t\"nodeCount\": %u,\n", nodeCount);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"meshNodeCount\": %u,\n", meshNodeCount);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"triangulatedCount\": %u,\n", triangulatedCount);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"buildThreadCount\": %u,\n", buildThreadCount);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"sourceVertexCount\": %llu,\n", sourceVertexCount);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"vertexCount\": %llu,\n", vertexCount);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"indexCount\": %llu,\n", indexCount);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"vertexDataBytes\": %llu,\n", vertexDataBytes);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"skinnedNodeCount\": %u,\n", skinnedNodeCount);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"skinBoneCount\": %u,\n", skinBoneCount);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"animatedNodeCount\": %u,\n", animatedNodeCount);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"animationFrameCount\": %u,\n", animationFrameCount);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"animationBytes\": %llu,\n", animationBytes);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"animationRawBytes\": %llu,\n", animationRawBytes);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"animationMaxError\": %g,\n", animationMaxError);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"bufferVertexCount\": %llu,\n", bufferVertexCount);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"bufferIndexCount\": %llu,\n", bufferIndexCount);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"bufferBytes\": %llu,\n", bufferBytes);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"indexBytesSaved\": %llu,\n", indexBytesSaved);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"bufferCreateCount\": %u,\n", bufferCreateCount);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"vertexStride\": %u,\n", vertexStride);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"vertexPositionError\": %g,\n", vertexPositionError);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"vertexNormalErrorDegree\": %g,\n", vertexNormalError);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"vertexTexcoordError\": %g,\n", vertexTexcoordError);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"scratchBytes\": %llu,\n", scratchBytes);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"scratchPeakBytes\": %llu,\n", scratchPeakBytes);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"scratchHeapAllocCount\": %u,\n", scratchHeapAllocCount);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"sharedStateCount\": %u,\n", sharedStateCount);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"sharedStateHitCount\": %u,\n", sharedStateHitCount);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"textureHitCount\": %u,\n", textureHitCount);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"textureLoadCount\": %u,\n", textureLoadCount);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"textureFailCount\": %u,\n", textureFailCount);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"textureBytesRead\": %llu,\n", textureBytesRead);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"texturePendingCount\": %u,\n", texturePendingCount);
+	json += buf;
+	sprintf_s(buf, sizeof(buf), "\t\"meshCacheHit\": %s\n}\n", meshCacheHit ? "true" : "false");
+	json += buf;
+
+	return json;
+}
+
+HRESULT FBX_LOAD_STATS::WriteJSON(const char* filename) const
+{
+	if(!filename)
+		return E_INVALIDARG;
+
+	FILE* fp = nullptr;
+	if(fopen_s(&fp, filename, "w") != 0 || !fp)
+		return E_FAIL;
+
+	const std::string json = ToJSON();
+	bool succeeded = fwrite(json.c_str(), 1, json.size(), fp) == json.size();
+	succeeded &= fclose(fp) == 0;
+
+	return succeeded ? S_OK : E_FAIL;
+}
+
+//
+CFBXStageTimer::CFBXStageTimer(FBX_LOAD_STATS* pStats, const FBX_LOAD_STAGE stage)
+{
+	m_pStats = pStats;
+	m_stage = stage;
+	m_beginAllocCount = FBX_LOAD_STATS::GetAllocationCount();
+	QueryPerformanceCounter(&m_begin);
+}
+
+CFBXStageTimer::~CFBXStageTimer()
+{
+	Stop();
+}
+
+void CFBXStageTimer::Stop()
+{
+	if(!m_pStats)
+		return ;
+
+	LARGE_INTEGER end, frequency;
+	QueryPerformanceCounter(&end);
+	QueryPerformanceFrequency(&frequency);
+
+	m_pStats->stageTime[m_stage] += static_cast<double>(end.QuadPart - m_begin.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart);
+	m_pStats->stageAllocCount[m_stage] += FBX_LOAD_STATS::GetAllocationCount() - m_beginAllocCount;
+	m_pStats = nullptr;
+}
+
+}	// namespace FBX_LOADER
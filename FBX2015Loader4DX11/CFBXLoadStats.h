@@ -0,0 +1,126 @@
+// *********************************************************************************************************************
+///
+/// @file 		CFBXLoadStats.h
+/// @brief		ǂݍ݂̒iKƂ̏vԂƃJE^
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+#include <Windows.h>
+
+namespace FBX_LOADER
+{
+
+// ǂݍ݂̒iK
+enum FBX_LOAD_STAGE
+{
+	FBX_LOAD_STAGE_SDK_INITIALIZE = 0,		// FbxManager, FbxScene쐬
+	FBX_LOAD_STAGE_IMPORTER_INITIALIZE,		// FbxImporter::Initialize
+	FBX_LOAD_STAGE_IMPORT,					// FbxImporter::Import
+	FBX_LOAD_STAGE_AXIS_CONVERT,			// WnConvertScene
+	FBX_LOAD_STAGE_UNIT_CONVERT,			// PʌnConvertScene
+	FBX_LOAD_STAGE_TRIANGULATE,
+	FBX_LOAD_STAGE_SETUP,					// FBX SDK̒_EXLE}eÃRs[(VOXbh)
+	FBX_LOAD_STAGE_BUILD_NODES,				// n, XLEFCg, E(CFBXLoader::SetThreadCountŕ)
+	FBX_LOAD_STAGE_ANIMATION_BAKE,			// m[hAj[V̏Ă
+	FBX_LOAD_STAGE_CREATE_NODES,			// œKD3D11obt@쐬
+	FBX_LOAD_STAGE_MESH_CACHE_READ,			// nbVvZ, LbṼobt@쐬
+	FBX_LOAD_STAGE_MESH_CACHE_WRITE,
+
+	FBX_LOAD_STAGE_MAX,
+};
+
+struct FBX_LOAD_STATS
+{
+	double		stageTime[FBX_LOAD_STAGE_MAX];	// ~b
+	uint64_t	stageAllocCount[FBX_LOAD_STAGE_MAX];	// iK̃q[vmۉ(SetAllocationCounter0)
+
+	// CFBXLoader
+	uint32_t	nodeCount;				// Hm[h
+	uint32_t	meshNodeCount;			// _m[h
+	uint32_t	triangulatedCount;		// Op`Agr[g
+	uint32_t	buildThreadCount;		// FBX_LOAD_STAGE_BUILD_NODESŎgXbh
+	uint64_t	sourceVertexCount;		// nڑO̒_(|S̊p̐)
+	uint64_t	vertexCount;
+	uint64_t	indexCount;
+	uint64_t	vertexDataBytes;		// FBX_MESH_NODE̒_ECfbNXz̊mۗ
+	uint32_t	skinnedNodeCount;		// XLEFCgm[h
+	uint32_t	skinBoneCount;			// SXL̃{[̍v
+	uint32_t	animatedNodeCount;		// Aj[VĂ񂾃m[h
+	uint32_t	animationFrameCount;
+	uint64_t	animationBytes;			// Ă񂾃L[ƃm[h̃TCY(k)
+	uint64_t	animationRawBytes;		// kȂꍇ̃TCY
+	float		animationMaxError;		// kɂKw̋Ԃł̍ő덷
+
+	// CFBXRenderDX11
+	uint64_t	bufferVertexCount;		// _obt@ɓꂽ_(œK)
+	uint64_t	bufferIndexCount;
+	uint64_t	bufferBytes;			// _ECfbNXobt@̍vTCY
+	uint64_t	indexBytesSaved;		// 16bitCfbNXɂČoCg
+	uint32_t	bufferCreateCount;		// _ECfbNXobt@CreateBuffer
+	uint32_t	vertexStride;			// _obt@1_̃oCg(FBX_VERTEX_FORMAT)
+	float		vertexPositionError;	// ʎqɂfloat32̍ő덷. LbVǂ񂾏ꍇ0
+	float		vertexNormalError;		// x
+	float		vertexTexcoordError;
+	uint64_t	scratchBytes;			// bV\z̍Ɨ̈̊mۗ
+	uint64_t	scratchPeakBytes;		// 1m[hŎgő
+	uint32_t	scratchHeapAllocCount;	// Ɨ̈q[vmۂ(f1ɂ1ȉ)
+	uint32_t	sharedStateCount;		// foCXŋLĂ̓CAEg, Tv[, }eAE_̒萔obt@̐
+	uint32_t	sharedStateHitCount;	// ̃fō炸ɋL
+	uint32_t	textureHitCount;		// ǂݍݍς݂̃eNX`L(pXev)
+	uint32_t	textureLoadCount;		// V쐬eNX`̐(񓯊͓̕ǂݍ݂I܂łɍ쐬ł)
+	uint32_t	textureFailCount;		// Ȃ, ܂͍쐬łȂeNX`̐
+	uint64_t	textureBytesRead;		// eNX`t@Cǂ񂾃oCg
+	uint32_t	texturePendingCount;	// ǂݍ݂I_Ŕ񓯊ǂݍݒ̃}eA̐(SRVŕ`)
+	uint32_t	meshCacheHit;			// LbVǂݍ񂾂1
+
+	FBX_LOAD_STATS()
+	{
+		Reset();
+	}
+
+	void Reset();
+
+	// iK̎ԂƃJE^𑫂
+	void Add(const FBX_LOAD_STATS& other);
+
+	double GetTotalTime() const;
+
+	std::string ToJSON() const;
+	HRESULT WriteJSON(const char* filename) const;
+
+	static const char* GetStageName(const FBX_LOAD_STAGE stage);
+
+	// vZXŜ̃q[vmۉ񐔂Ԃ֐(x`}[Noperator new𐔂Ȃ).
+	// ݒ肷CFBXStageTimeriKƂ̍stageAllocCountɑ. nullptrŎ~߂
+	typedef uint64_t (*ALLOCATION_COUNTER)();
+	static void SetAllocationCounter(ALLOCATION_COUNTER pCounter);
+	static uint64_t GetAllocationCount();
+};
+
+// XR[v𔲂܂ł̎Ԃw̒iKɉZ
+class CFBXStageTimer
+{
+	FBX_LOAD_STATS*	m_pStats;
+	FBX_LOAD_STAGE	m_stage;
+	LARGE_INTEGER	m_begin;
+	uint64_t		m_beginAllocCount;
+
+	CFBXStageTimer(const CFBXStageTimer&);
+	CFBXStageTimer& operator=(const CFBXStageTimer&);
+
+public:
+	CFBXStageTimer(FBX_LOAD_STATS* pStats, const FBX_LOAD_STAGE stage);
+	~CFBXStageTimer();
+
+	void Stop();
+};
+
+}	// namespace FBX_LOADER
@@ -10,6 +10,12 @@
 
 
 #include "CFBXLoader.h"
+#include "CFBXAnimation.h"
+
+#include <math.h>
+#include <algorithm>
+#include <thread>
+#include <atomic>
 
 namespace FBX_LOADER
 {
@@ -18,17 +24,29 @@ CFBXLoader::CFBXLoader()
 {
 	mSdkManager = nullptr;
 	mScene = nullptr;
+	mImporter = nullptr;
+	mCurrentAnimLayer = nullptr;
+	m_threadCount = 1;
+	m_pAnimation = new CFBXAnimation;
+	m_animationSampleRate = 30.0f;
+	m_animationTolerance = 0.01f;
 }
 
 CFBXLoader::~CFBXLoader()
 {
 	Release();
+
+	delete m_pAnimation;
+	m_pAnimation = nullptr;
 }
 
 //
 void CFBXLoader::Release()
 {
 	m_meshNodeArray.clear();
+	m_nodeIdMap.clear();
+	m_pAnimation->Release();
+	mCurrentAnimLayer = nullptr;
 
 	if(mImporter)
 	{
@@ -56,11 +74,16 @@ HRESULT CFBXLoader::LoadFBX(const char* filename, const eAXIS_SYSTEM axis)
 
 	HRESULT hr = S_OK;
 
+	m_loadStats.Reset();
+
+	CFBXStageTimer sdkTimer(&m_loadStats, FBX_LOAD_STAGE_SDK_INITIALIZE);
 	InitializeSdkObjects( mSdkManager, mScene );
 	if(!mSdkManager)
 		return E_FAIL;
+	sdkTimer.Stop();
 
 	// C|[^쐬
+	CFBXStageTimer importerTimer(&m_loadStats, FBX_LOAD_STAGE_IMPORTER_INITIALIZE);
     int lFileFormat = -1;
     mImporter = FbxImporter::Create(mSdkManager,"");
 
@@ -73,10 +96,13 @@ HRESULT CFBXLoader::LoadFBX(const char* filename, const eAXIS_SYSTEM axis)
      // Initialize the importer by providing a filename.
     if(!mImporter || mImporter->Initialize(filename, lFileFormat) == false)
 		return E_FAIL;
+	importerTimer.Stop();
   
 	//
+	CFBXStageTimer importTimer(&m_loadStats, FBX_LOAD_STAGE_IMPORT);
 	if( !mImporter || mImporter->Import(mScene) == false )
 		return E_FAIL;
+	importTimer.Stop();
 
 	FbxAxisSystem OurAxisSystem = FbxAxisSystem::DirectX;
 
@@ -84,25 +110,45 @@ HRESULT CFBXLoader::LoadFBX(const char* filename, const eAXIS_SYSTEM axis)
 		OurAxisSystem = FbxAxisSystem::OpenGL;
 		
 	// DirectXn
+	CFBXStageTimer axisTimer(&m_loadStats, FBX_LOAD_STAGE_AXIS_CONVERT);
     FbxAxisSystem SceneAxisSystem = mScene->GetGlobalSettings().GetAxisSystem();
 	if(SceneAxisSystem != OurAxisSystem)
 	{
 		FbxAxisSystem::DirectX.ConvertScene(mScene);
 	}
+	axisTimer.Stop();
 
     // Pʌn̓
 	// svł
+	CFBXStageTimer unitTimer(&m_loadStats, FBX_LOAD_STAGE_UNIT_CONVERT);
     FbxSystemUnit SceneSystemUnit = mScene->GetGlobalSettings().GetSystemUnit();
     if( SceneSystemUnit.GetScaleFactor() != 1.0 )
     {
         // Z`[^[PʂɃRo[g
         FbxSystemUnit::cm.ConvertScene( mScene );
     }
+	unitTimer.Stop();
 
 	// Op`(Op`ȊÕf[^łRňS)
-	TriangulateRecursive(mScene->GetRootNode());
-
-	Setup();
+	CFBXStageTimer triangulateTimer(&m_loadStats, FBX_LOAD_STAGE_TRIANGULATE);
+	TriangulateScene();
+	triangulateTimer.Stop();
+
+	std::vector<FbxNode*>			nodeList;
+	std::vector<FBX_NODE_SOURCE>	sourceArray;
+	CFBXStageTimer setupTimer(&m_loadStats, FBX_LOAD_STAGE_SETUP);
+	Setup(nodeList, sourceArray);
+	setupTimer.Stop();
+
+	// SDKǂݏoz񂾂ĝŕɂł
+	CFBXStageTimer buildTimer(&m_loadStats, FBX_LOAD_STAGE_BUILD_NODES);
+	BuildNodesParallel(sourceArray);
+	buildTimer.Stop();
+
+	// m[h̕т܂ĂĂ(AnimEvaluatorĝŃVOXbh)
+	CFBXStageTimer animationTimer(&m_loadStats, FBX_LOAD_STAGE_ANIMATION_BAKE);
+	BakeAnimation(nodeList);
+	animationTimer.Stop();
 
 	return hr;
 }
@@ -136,33 +182,56 @@ void CFBXLoader::InitializeSdkObjects(FbxManager*& pManager, FbxScene*& pScene)
     }
 }
 
-// Op`
-void CFBXLoader::TriangulateRecursive(FbxNode* pNode)
+// Op`. SetupŒHm[ȟ`󂾂Ώۂ, V[Ŝ1񂾂s
+void CFBXLoader::TriangulateScene()
+{
+	std::vector<FbxNodeAttribute*>	targetList;
+	if(mScene->GetRootNode())
+	{
+		CollectTriangulateTarget(mScene->GetRootNode(), targetList);
+	}
+
+	FbxGeometryConverter lConverter(mSdkManager);
+	for(size_t i=0;i<targetList.size();i++)
+	{
+		// łǂȌ`Op`(̃Agr[g͒u)
+		if(lConverter.Triangulate(targetList[i], true))
+			m_loadStats.triangulatedCount++;
+	}
+}
+
+// Op`KvȃAgr[gW߂. m[hŋLĂĂ1񂾂
+void CFBXLoader::CollectTriangulateTarget(FbxNode* pNode, std::vector<FbxNodeAttribute*>& targetList)
 {
 	FbxNodeAttribute* lNodeAttribute = pNode->GetNodeAttribute();
 
-    if (lNodeAttribute)
-    {
-        if (lNodeAttribute->GetAttributeType() == FbxNodeAttribute::eMesh ||
-            lNodeAttribute->GetAttributeType() == FbxNodeAttribute::eNurbs ||
-            lNodeAttribute->GetAttributeType() == FbxNodeAttribute::eNurbsSurface ||
-            lNodeAttribute->GetAttributeType() == FbxNodeAttribute::ePatch)
-        {
-			FbxGeometryConverter lConverter(pNode->GetFbxManager());
-			// łǂȌ`Op`
-#if 0
-            lConverter.TriangulateInPlace(pNode);	// Â@
-#endif // 0
-			lConverter.Triangulate( mScene, true );
-        }
-    }
+	if (lNodeAttribute)
+	{
+		const FbxNodeAttribute::EType lType = lNodeAttribute->GetAttributeType();
+		bool isTarget = false;
+		if (lType == FbxNodeAttribute::eMesh)
+		{
+			// SOp`Ȃ炻̂܂܎g
+			isTarget = !static_cast<FbxMesh*>(lNodeAttribute)->IsTriangleMesh();
+		}
+		else if (lType == FbxNodeAttribute::eNurbs ||
+			lType == FbxNodeAttribute::eNurbsSurface ||
+			lType == FbxNodeAttribute::ePatch)
+		{
+			// bVւ̕ϊ˂
+			isTarget = true;
+		}
+
+		if (isTarget && std::find(targetList.begin(), targetList.end(), lNodeAttribute) == targetList.end())
+			targetList.push_back(lNodeAttribute);
+	}
 
 	const int lChildCount = pNode->GetChildCount();
-    for (int lChildIndex = 0; lChildIndex < lChildCount; ++lChildIndex)
-    {
+	for (int lChildIndex = 0; lChildIndex < lChildCount; ++lChildIndex)
+	{
 		// qm[hT
-        TriangulateRecursive(pNode->GetChild(lChildIndex));
-    }
+		CollectTriangulateTarget(pNode->GetChild(lChildIndex), targetList);
+	}
 }
 
 //
@@ -171,26 +240,145 @@ FbxNode&	CFBXLoader::GetRootNode()
 	return *mScene->GetRootNode();
 }
 
-void CFBXLoader::Setup()
+// FBX SDK̓XbhZ[tł͂Ȃ̂, m[h̗񋓂SDK̓ǂݏo͑SĂōs
+void CFBXLoader::Setup(std::vector<FbxNode*>& nodeList, std::vector<FBX_NODE_SOURCE>& sourceArray)
 {
-	// RootNodeTĂ
+	// 1iK: RootNodeTăm[h̕тƍsm肳
+	nodeList.clear();
+	m_nodeIdMap.clear();
+	m_meshNodeArray.reserve(mScene->GetNodeCount());
+	nodeList.reserve(mScene->GetNodeCount());
 	if(mScene->GetRootNode())
 	{
-		SetupNode(mScene->GetRootNode(), "null");
+		CollectNode(mScene->GetRootNode(), "null", -1, nodeList);
+	}
+
+	// 2iK: _EXLE}eAf̔zɃRs[
+	sourceArray.clear();
+	sourceArray.resize(nodeList.size());
+	for(size_t i=0;i<nodeList.size();i++)
+	{
+		SetupNode(nodeList[i], &m_meshNodeArray[i], &sourceArray[i]);
 	}
 }
 
-void CFBXLoader::SetupNode(FbxNode* pNode, std::string parentName)
+// m[h[Dŗ񋓂. o͏͏]SetupNode̍ċAƓ(sȂ̂ŕ؂͘A)
+void CFBXLoader::CollectNode(FbxNode* pNode, const std::string& parentName, const int parentId, std::vector<FbxNode*>& nodeList)
 {
 	if(!pNode)
 		return ;
 
-	FBX_MESH_NODE meshNode;
+	// zŒڍ\z(q̒TōĊmۂꂤ̂ŖO̓[JɎĂ)
+	const std::string name = pNode->GetName();
 
-	meshNode.name = pNode->GetName();
+	const int nodeId = static_cast<int>(m_meshNodeArray.size());
+	m_meshNodeArray.emplace_back();
+	FBX_MESH_NODE& meshNode = m_meshNodeArray.back();
+	meshNode.name = name;
 	meshNode.parentName = parentName;
+	meshNode.parentId = parentId;
+	m_nodeIdMap[pNode] = nodeId;
+
+	// AnimEvaluator̓XbhZ[tł͂Ȃ̂ōs͂ŌvZĂ
+	ComputeNodeMatrix(pNode, &meshNode);
+
+	nodeList.push_back(pNode);
+
+	const int lCount = pNode->GetChildCount();
+	for (int i = 0; i < lCount; i++)
+	{
+		CollectNode(pNode->GetChild(i), name, nodeId, nodeList);
+	}
+}
+
+// eXbh͋󂢂Ăm[hɎɍs, m_meshNodeArraysourceArray̑ΉXbgɂG.
+// FBX SDKĂ΂Ȃ
+void CFBXLoader::BuildNodesParallel(std::vector<FBX_NODE_SOURCE>& sourceArray)
+{
+	const size_t nodeCount = sourceArray.size();
+
+	unsigned int threadCount = m_threadCount;
+	if(threadCount==0)
+		threadCount = std::thread::hardware_concurrency();
+	if(threadCount==0)
+		threadCount = 1;
+	if(threadCount > nodeCount)
+		threadCount = static_cast<unsigned int>(std::max(nodeCount, static_cast<size_t>(1)));
+
+	std::atomic<size_t> nextNode(0);
+	auto worker = [&]()
+	{
+		for(;;)
+		{
+			const size_t i = nextNode.fetch_add(1);
+			if(i >= nodeCount)
+				break;
+
+			BuildNode(&sourceArray[i], &m_meshNodeArray[i]);
+		}
+	};
+
+	// ĂяoXbh[J[ƂĎg
+	std::vector<std::thread> threads;
+	for(unsigned int i=1;i<threadCount;i++)
+	{
+		threads.push_back(std::thread(worker));
+	}
+
+	worker();
+
+	for(size_t i=0;i<threads.size();i++)
+	{
+		threads[i].join();
+	}
+
+	// nڑO̒_Ȃ
+	m_loadStats.nodeCount = static_cast<uint32_t>(m_meshNodeArray.size());
+	m_loadStats.buildThreadCount = threadCount;
+	for(size_t i=0;i<m_meshNodeArray.size();i++)
+	{
+		const FBX_MESH_NODE& meshNode = m_meshNodeArray[i];
+		if(meshNode.m_positionArray.size() > 0)
+			m_loadStats.meshNodeCount++;
+		if(meshNode.m_skinArray.size() > 0)
+		{
+			m_loadStats.skinnedNodeCount++;
+			m_loadStats.skinBoneCount += static_cast<uint32_t>(meshNode.m_boneArray.size());
+		}
+
+		m_loadStats.sourceVertexCount += meshNode.sourceVertexCount;
+		m_loadStats.vertexCount += meshNode.m_positionArray.size();
+		m_loadStats.indexCount += meshNode.indexArray.size();
+		m_loadStats.vertexDataBytes += meshNode.m_positionArray.capacity() * sizeof(FBX_FLOAT3) +
+			meshNode.m_normalArray.capacity() * sizeof(FBX_FLOAT3) +
+			meshNode.m_texcoordArray.capacity() * sizeof(FBX_FLOAT2) +
+			meshNode.indexArray.capacity() * sizeof(meshNode.indexArray[0]) +
+			meshNode.m_skinArray.capacity() * sizeof(FBX_SKIN_WEIGHT);
+	}
+}
+
+// nڂĂXLEFCgnڌ̒_ɔz, E߂
+void CFBXLoader::BuildNode(FBX_NODE_SOURCE* pSource, FBX_MESH_NODE* meshNode)
+{
+	if(!pSource || !meshNode)
+		return ;
+
+	if(!pSource->cornerControlPoint.empty())
+	{
+		std::vector<int>	vertexControlPoint;
+		WeldVertices(*pSource, meshNode, &vertexControlPoint);
+		BuildSkinWeights(*pSource, vertexControlPoint, meshNode);
+
+		meshNode->bounds.Compute(meshNode->m_positionArray.empty() ? nullptr : &meshNode->m_positionArray[0], meshNode->m_positionArray.size());
+	}
 
-	ZeroMemory( &meshNode.elements, sizeof(MESH_ELEMENTS) );
+	pSource->Release();
+}
+
+void CFBXLoader::SetupNode(FbxNode* pNode, FBX_MESH_NODE* meshNode, FBX_NODE_SOURCE* pSource)
+{
+	if(!pNode || !meshNode || !pSource)
+		return ;
 
 	FbxMesh* lMesh = pNode->GetMesh();	
 
@@ -201,33 +389,20 @@ void CFBXLoader::SetupNode(FbxNode* pNode, std::string parentName)
 		if (lVertexCount>0)
 		{
 			// _Ȃm[hɃRs[
-			CopyVertexData(lMesh, &meshNode);
+			CopyVertexData(lMesh, meshNode, pSource);
 		}
 	}
 
-	// }eA
+	// }eA. ʂ̃}eAԍƓY킹邽, ̃Xbgl߂Ɏc
 	const int lMaterialCount = pNode->GetMaterialCount();
+	meshNode->m_materialArray.resize(lMaterialCount);
 	for(int i=0;i<lMaterialCount;i++)
 	{
 		FbxSurfaceMaterial* mat = pNode->GetMaterial(i);
 		if(!mat)
 			continue;
 
-		FBX_MATERIAL_NODE destMat;
-		CopyMatrialData(mat, &destMat);
-
-		meshNode.m_materialArray.push_back(destMat);
-	}
-
-	//
-	ComputeNodeMatrix(pNode, &meshNode);
-
-	m_meshNodeArray.push_back(meshNode);
-
-	const int lCount = pNode->GetChildCount();
-	for (int i = 0; i < lCount; i++)
-	{
-		SetupNode(pNode->GetChild(i), meshNode.name);
+		CopyMatrialData(mat, &meshNode->m_materialArray[i]);
 	}
 }
 
@@ -392,68 +567,561 @@ void CFBXLoader::ComputeNodeMatrix(FbxNode* pNode, FBX_MESH_NODE* meshNode)
 	}
 }
 
-//
-void CFBXLoader::CopyVertexData(FbxMesh*	pMesh, FBX_MESH_NODE* meshNode)
+static void FBXMatrixToFloat4x4(const FbxAMatrix& src, DirectX::XMFLOAT4X4* pDest)
 {
-	if(!pMesh)
+	for(int i=0;i<4;i++)
+	{
+		for(int j=0;j<4;j++)
+			pDest->m[i][j] = static_cast<float>(src.Get(i,j));
+	}
+}
+
+// 擪̃Aj[VX^bN̐擪C[ŃJ[um[h̃[JTRS, ԊuőSt[o.
+// m[h̕тm_meshNodeArrayƓ. [g͍sPʍsɂĂ̂łłȂ
+void CFBXLoader::BakeAnimation(const std::vector<FbxNode*>& nodeList)
+{
+	m_pAnimation->Release();
+	mCurrentAnimLayer = nullptr;
+
+	FbxAnimStack* pStack = mScene->GetSrcObject<FbxAnimStack>(0);
+	if(!pStack || pStack->GetMemberCount<FbxAnimLayer>() <= 0 || m_animationSampleRate <= 0.0f)
 		return ;
 
-	int lPolygonCount = pMesh->GetPolygonCount();
+	mScene->SetCurrentAnimationStack(pStack);
+	mCurrentAnimLayer = pStack->GetMember<FbxAnimLayer>(0);
 
-	FbxVector4 pos, nor;
-	
-	meshNode->elements.numPosition = 1;
-	meshNode->elements.numNormal = 1;
+	// e̓YƃgbN(J[um[h)߂
+	std::vector<int32_t>	parentArray(nodeList.size(), -1);
+	std::vector<int32_t>	trackArray(nodeList.size(), -1);
+	std::vector<size_t>		trackNodeArray;
+	for(size_t i=0;i<nodeList.size();i++)
+	{
+		FbxNode* pNode = nodeList[i];
+		parentArray[i] = m_meshNodeArray[i].parentId;
 
-	unsigned int indx = 0;
-	
-	for(int i=0;i<lPolygonCount;i++)
+		if(pNode == mScene->GetRootNode())
+			continue;
+
+		if(pNode->LclTranslation.GetCurveNode(mCurrentAnimLayer) ||
+			pNode->LclRotation.GetCurveNode(mCurrentAnimLayer) ||
+			pNode->LclScaling.GetCurveNode(mCurrentAnimLayer))
+		{
+			trackArray[i] = static_cast<int32_t>(trackNodeArray.size());
+			trackNodeArray.push_back(i);
+		}
+	}
+
+	if(trackNodeArray.empty())
+		return ;
+
+	// Ō̃t[͏Iɍ킹(̓t[Pʂɐ؂オ)
+	const FbxTimeSpan timeSpan = pStack->GetLocalTimeSpan();
+	const double start = timeSpan.GetStart().GetSecondDouble();
+	const double stop = timeSpan.GetStop().GetSecondDouble();
+	const double duration = std::max(stop - start, 0.0);
+	const uint32_t frameCount = static_cast<uint32_t>(ceil(duration * m_animationSampleRate)) + 1;
+
+	m_pAnimation->Initialize(nodeList.size(), static_cast<uint32_t>(trackNodeArray.size()), frameCount, m_animationSampleRate);
+
+	// Ȃm[h͊̎̃[Js
+	DirectX::XMFLOAT4X4 local;
+	for(size_t i=0;i<nodeList.size();i++)
 	{
-		// |S̒_(ꉞAOp`Ă̂3_̂͂`FbN)
-		int lPolygonsize = pMesh->GetPolygonSize(i);
+		if(nodeList[i] == mScene->GetRootNode())
+			DirectX::XMStoreFloat4x4(&local, DirectX::XMMatrixIdentity());
+		else
+			FBXMatrixToFloat4x4(nodeList[i]->EvaluateLocalTransform(), &local);
+		m_pAnimation->SetNode(i, parentArray[i], trackArray[i], local);
+	}
 
-		for(int pol=0;pol<lPolygonsize;pol++)
+	FbxTime time;
+	for(uint32_t frame=0;frame<frameCount;frame++)
+	{
+		time.SetSecondDouble(std::min(start + frame / static_cast<double>(m_animationSampleRate), stop));
+
+		FBX_ANIMATION_KEY* pKeys = m_pAnimation->GetKeys(frame);
+		const FBX_ANIMATION_KEY* pPrevKeys = frame > 0 ? m_pAnimation->GetKeys(frame - 1) : nullptr;
+		for(size_t t=0;t<trackNodeArray.size();t++)
 		{
-			int index = pMesh->GetPolygonVertex(i, pol);
-			meshNode->indexArray.push_back(indx);
+			const FbxAMatrix& lLocal = nodeList[trackNodeArray[t]]->EvaluateLocalTransform(time);
+			const FbxVector4 lT = lLocal.GetT();
+			const FbxQuaternion lQ = lLocal.GetQ();
+			const FbxVector4 lS = lLocal.GetS();
+
+			FBX_ANIMATION_KEY& key = pKeys[t];
+			key.translation = DirectX::XMFLOAT4A(static_cast<float>(lT[0]), static_cast<float>(lT[1]), static_cast<float>(lT[2]), 0.0f);
+			key.rotation = DirectX::XMFLOAT4A(static_cast<float>(lQ[0]), static_cast<float>(lQ[1]), static_cast<float>(lQ[2]), static_cast<float>(lQ[3]));
+			key.scale = DirectX::XMFLOAT4A(static_cast<float>(lS[0]), static_cast<float>(lS[1]), static_cast<float>(lS[2]), 0.0f);
+
+			// q  -q ͓]Ȃ̂, Õt[ƓςȂ甽]ĕԂ肵Ȃ悤ɂ
+			if(pPrevKeys)
+			{
+				const DirectX::XMFLOAT4A& prev = pPrevKeys[t].rotation;
+				if(prev.x*key.rotation.x + prev.y*key.rotation.y + prev.z*key.rotation.z + prev.w*key.rotation.w < 0.0f)
+				{
+					key.rotation.x = -key.rotation.x;
+					key.rotation.y = -key.rotation.y;
+					key.rotation.z = -key.rotation.z;
+					key.rotation.w = -key.rotation.w;
+				}
+			}
+		}
+	}
 
-			pos = pMesh->GetControlPointAt(index);
-			pMesh->GetPolygonVertexNormal(i,pol,nor);
+	m_pAnimation->Finalize();
 
-			meshNode->m_positionArray.push_back( pos );
-			meshNode->m_normalArray.push_back( nor );
-	
-			++indx;
+	// kÕTCYƌ덷FBX_LOAD_STATSŕԂ(CFBXAnimation::GetRawKeySize, GetKeySize, GetMaxErrorł)
+	const size_t rawBytes = m_pAnimation->GetMemorySize();
+	if(m_animationTolerance > 0.0f)
+		m_pAnimation->Compress(m_animationTolerance);
+
+	m_loadStats.animatedNodeCount = m_pAnimation->GetTrackCount();
+	m_loadStats.animationFrameCount = m_pAnimation->GetFrameCount();
+	m_loadStats.animationBytes = m_pAnimation->GetMemorySize();
+	m_loadStats.animationRawBytes = rawBytes;
+	m_loadStats.animationMaxError = m_pAnimation->GetMaxError();
+}
+
+// }bsO[hƃt@X[hς݂̃C[GgQ
+template<class T>
+struct LAYER_ELEMENT_ACCESSOR
+{
+	const FbxLayerElementArrayTemplate<T>*		pDirect;
+	const FbxLayerElementArrayTemplate<int>*	pIndex;		// eDirectȂnullptr
+	FbxLayerElement::EMappingMode				mappingMode;
+
+	LAYER_ELEMENT_ACCESSOR()
+	{
+		pDirect = nullptr;
+		pIndex = nullptr;
+		mappingMode = FbxLayerElement::eNone;
+	}
+
+	bool Setup(const FbxLayerElementTemplate<T>* pElement)
+	{
+		if(!pElement)
+			return false;
+
+		mappingMode = pElement->GetMappingMode();
+		pDirect = &pElement->GetDirectArray();
+		pIndex = nullptr;
+		if(pElement->GetReferenceMode() != FbxLayerElement::eDirect)
+			pIndex = &pElement->GetIndexArray();
+
+		return true;
+	}
+
+	bool IsValid() const { return pDirect!=nullptr; }
+
+	T Get(const int controlPoint, const int polygonVertex, const int polygon) const
+	{
+		int index = 0;
+		switch(mappingMode)
+		{
+		case FbxLayerElement::eByControlPoint:	index = controlPoint;	break;
+		case FbxLayerElement::eByPolygonVertex:	index = polygonVertex;	break;
+		case FbxLayerElement::eByPolygon:		index = polygon;		break;
+		default:								index = 0;				break;
 		}
+
+		if(pIndex)
+			index = pIndex->GetAt(index);
+
+		return pDirect->GetAt(index);
 	}
+};
+
+static inline void ToFloat3(const FbxVector4& src, FBX_FLOAT3& dest)
+{
+	dest.x = static_cast<float>(src.mData[0]);
+	dest.y = static_cast<float>(src.mData[1]);
+	dest.z = static_cast<float>(src.mData[2]);
+}
+
+static inline void ToFloat2(const FbxVector2& src, FBX_FLOAT2& dest)
+{
+	dest.x = static_cast<float>(src.mData[0]);
+	dest.y = static_cast<float>(src.mData[1]);
+}
+
+// |S_̑ƃRg[|Cg, ʂ̃}eAԍ, XLSDKǂݏo. nڂBuildNodeōs
+void CFBXLoader::CopyVertexData(FbxMesh*	pMesh, FBX_MESH_NODE* meshNode, FBX_NODE_SOURCE* pSource)
+{
+	if(!pMesh)
+		return ;
+
+	const int lPolygonCount = pMesh->GetPolygonCount();
+	const int lCornerCount = pMesh->GetPolygonVertexCount();
+	const int* pPolygonVertices = pMesh->GetPolygonVertices();
+	if(lCornerCount<=0 || !pPolygonVertices)
+		return ;
+
+	meshNode->elements.numPosition = 1;
+	meshNode->elements.numNormal = 1;
+
+	// @UṼ}bsO/t@X[h̓bVɈx
+	LAYER_ELEMENT_ACCESSOR<FbxVector4>	normalElement;
+	normalElement.Setup(pMesh->GetElementNormal(0));
 
-	// UV(UV2ȏ゠ꍇ̂ŕʏ)
 	FbxStringList	uvsetName;
 	pMesh->GetUVSetNames(uvsetName);
-	int numUVSet = uvsetName.GetCount();
+	const int numUVSet = uvsetName.GetCount();
 	meshNode->elements.numUVSet = numUVSet;
 
-	bool unmapped = false;
-
+	std::vector<LAYER_ELEMENT_ACCESSOR<FbxVector2>>	uvElement(numUVSet);
 	for(int uv=0;uv<numUVSet;uv++)
 	{
 		meshNode->uvsetID[uvsetName.GetStringAt(uv)] = uv;
+		uvElement[uv].Setup(pMesh->GetElementUV(uvsetName.GetStringAt(uv)));
+	}
+
+	// |S_̑1pXŏW߂
+	const FBX_FLOAT3 zero3 = { 0.0f, 0.0f, 0.0f };
+	const FBX_FLOAT2 zero2 = { 0.0f, 0.0f };
+	std::vector<int>&		cornerControlPoint = pSource->cornerControlPoint;
+	FBX_FLOAT3_STREAM&		cornerNormal = pSource->cornerNormal;
+	FBX_FLOAT2_STREAM&		cornerUV = pSource->cornerUV;
+	cornerControlPoint.assign(lCornerCount, 0);
+	cornerNormal.assign(lCornerCount, zero3);
+	cornerUV.assign(lCornerCount*numUVSet, zero2);
+
+	for(int i=0;i<lPolygonCount;i++)
+	{
+		// |S̒_(ꉞAOp`Ă̂3_̂͂`FbN)
+		const int lPolygonsize = pMesh->GetPolygonSize(i);
+		const int lPolygonStart = pMesh->GetPolygonVertexIndex(i);
+
+		for(int pol=0;pol<lPolygonsize;pol++)
+		{
+			const int corner = lPolygonStart + pol;
+			const int index = pPolygonVertices[corner];
+
+			cornerControlPoint[corner] = index;
+
+			if(normalElement.IsValid())
+				ToFloat3(normalElement.Get(index, corner, i), cornerNormal[corner]);
+
+			for(int uv=0;uv<numUVSet;uv++)
+			{
+				if(uvElement[uv].IsValid())
+					ToFloat2(uvElement[uv].Get(index, corner, i), cornerUV[uv*lCornerCount + corner]);
+			}
+		}
+	}
+
+	// ʖ̃}eAԍ(Op`ς݂Ȃ̂Ń|S11)
+	const FbxGeometryElementMaterial* pMaterialElement = pMesh->GetElementMaterial(0);
+	if(pMaterialElement)
+	{
+		const FbxLayerElementArrayTemplate<int>& materialIndices = pMaterialElement->GetIndexArray();
+		const bool isAllSame = pMaterialElement->GetMappingMode() == FbxLayerElement::eAllSame;
+		const int materialIndexCount = materialIndices.GetCount();
+
+		meshNode->materialIndexArray.resize(lPolygonCount);
 		for(int i=0;i<lPolygonCount;i++)
 		{
-			int lPolygonsize = pMesh->GetPolygonSize(i);
+			const int index = isAllSame ? 0 : i;
+			const int material = index < materialIndexCount ? materialIndices.GetAt(index) : 0;
+			meshNode->materialIndexArray[i] = material > 0 ? static_cast<unsigned int>(material) : 0;
+		}
+	}
+
+	const int lControlPointCount = pMesh->GetControlPointsCount();
+	const FbxVector4* pControlPoints = pMesh->GetControlPoints();
+	pSource->controlPointArray.resize(pControlPoints ? lControlPointCount : 0);
+	for(size_t i=0;i<pSource->controlPointArray.size();i++)
+		ToFloat3(pControlPoints[i], pSource->controlPointArray[i]);
+
+	CopySkinData(pMesh, meshNode, pSource);
+}
+
+void FBX_BOUNDS::Compute(const FBX_FLOAT3* pPositions, const size_t count)
+{
+	Reset();
+	if(!pPositions || count==0)
+		return ;
+
+	FBX_FLOAT3 minPos = pPositions[0];
+	FBX_FLOAT3 maxPos = pPositions[0];
+	for(size_t i=1;i<count;i++)
+	{
+		minPos.x = std::min(minPos.x, pPositions[i].x);
+		minPos.y = std::min(minPos.y, pPositions[i].y);
+		minPos.z = std::min(minPos.z, pPositions[i].z);
+		maxPos.x = std::max(maxPos.x, pPositions[i].x);
+		maxPos.y = std::max(maxPos.y, pPositions[i].y);
+		maxPos.z = std::max(maxPos.z, pPositions[i].z);
+	}
+
+	boxCenter.x = (minPos.x + maxPos.x) * 0.5f;
+	boxCenter.y = (minPos.y + maxPos.y) * 0.5f;
+	boxCenter.z = (minPos.z + maxPos.z) * 0.5f;
+	boxExtents.x = (maxPos.x - minPos.x) * 0.5f;
+	boxExtents.y = (maxPos.y - minPos.y) * 0.5f;
+	boxExtents.z = (maxPos.z - minPos.z) * 0.5f;
+
+	float radiusSq = 0.0f;
+	for(size_t i=0;i<count;i++)
+	{
+		const float dx = pPositions[i].x - boxCenter.x;
+		const float dy = pPositions[i].y - boxCenter.y;
+		const float dz = pPositions[i].z - boxCenter.z;
+		radiusSq = std::max(radiusSq, dx*dx + dy*dy + dz*dz);
+	}
+	sphereCenter = boxCenter;
+	sphereRadius = sqrtf(radiusSq);
+}
+
+// _̃rbg񂩂nbVl(FNV-1a)
+static inline size_t HashBytes(size_t hash, const void* pData, size_t size)
+{
+	const unsigned char* p = static_cast<const unsigned char*>(pData);
+	for(size_t i=0;i<size;i++)
+	{
+		hash ^= p[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+// (Rg[|Cg, @, SUVSetUV)v|S_1̒_ɂ܂Ƃ߂
+void CFBXLoader::WeldVertices(const FBX_NODE_SOURCE& source, FBX_MESH_NODE* meshNode, std::vector<int>* pVertexControlPoint)
+{
+	const std::vector<int>&		cornerControlPoint = source.cornerControlPoint;
+	const FBX_FLOAT3_STREAM&	cornerNormal = source.cornerNormal;
+	const FBX_FLOAT2_STREAM&	cornerUV = source.cornerUV;
+	const size_t cornerCount = cornerControlPoint.size();
+	const size_t numUVSet = meshNode->elements.numUVSet;
+
+	meshNode->sourceVertexCount = static_cast<unsigned int>(cornerCount);
+	if(cornerCount==0 || source.controlPointArray.empty())
+		return ;
+
+	// nbVe[u(`FC@). oPbg2ׂ̂
+	size_t bucketCount = 1;
+	while(bucketCount < cornerCount*2)
+		bucketCount <<= 1;
+
+	const unsigned int INVALID = 0xffffffff;
+	std::vector<unsigned int>	bucketHead(bucketCount, INVALID);
+	std::vector<unsigned int>	nextVertex;
+	std::vector<unsigned int>	firstCorner;	// nڌ̒_ -> \|S_
+	nextVertex.reserve(cornerCount);
+	firstCorner.reserve(cornerCount);
+
+	meshNode->indexArray.resize(cornerCount);
+
+	for(size_t c=0;c<cornerCount;c++)
+	{
+		size_t hash = 2166136261u;
+		hash = HashBytes(hash, &cornerControlPoint[c], sizeof(int));
+		hash = HashBytes(hash, &cornerNormal[c], sizeof(FBX_FLOAT3));
+		for(size_t uv=0;uv<numUVSet;uv++)
+			hash = HashBytes(hash, &cornerUV[uv*cornerCount + c], sizeof(FBX_FLOAT2));
+
+		const size_t bucket = hash & (bucketCount-1);
+
+		unsigned int found = INVALID;
+		for(unsigned int v=bucketHead[bucket];v!=INVALID;v=nextVertex[v])
+		{
+			const size_t other = firstCorner[v];
+			if(cornerControlPoint[other] != cornerControlPoint[c])
+				continue;
+			if(memcmp(&cornerNormal[other], &cornerNormal[c], sizeof(FBX_FLOAT3)) != 0)
+				continue;
 
-			for(int pol=0;pol<lPolygonsize;pol++)
+			bool sameUV = true;
+			for(size_t uv=0;uv<numUVSet && sameUV;uv++)
 			{
-				FbxString name = uvsetName.GetStringAt(uv);
-				FbxVector2 texCoord;
-				pMesh->GetPolygonVertexUV( i, pol, name, texCoord, unmapped);
-				meshNode->m_texcoordArray.push_back(texCoord);
+				sameUV = memcmp(&cornerUV[uv*cornerCount + other],
+					&cornerUV[uv*cornerCount + c], sizeof(FBX_FLOAT2)) == 0;
+			}
+
+			if(sameUV)
+			{
+				found = v;
+				break;
 			}
 		}
+
+		if(found == INVALID)
+		{
+			found = static_cast<unsigned int>(firstCorner.size());
+			firstCorner.push_back(static_cast<unsigned int>(c));
+			nextVertex.push_back(bucketHead[bucket]);
+			bucketHead[bucket] = found;
+		}
+
+		meshNode->indexArray[c] = found;
+	}
+
+	// nڌ̒_o
+	const size_t vertexCount = firstCorner.size();
+	meshNode->m_positionArray.resize(vertexCount);
+	meshNode->m_normalArray.resize(vertexCount);
+	meshNode->m_texcoordArray.resize(vertexCount*numUVSet);
+	pVertexControlPoint->resize(vertexCount);
+
+	for(size_t v=0;v<vertexCount;v++)
+	{
+		const size_t c = firstCorner[v];
+		(*pVertexControlPoint)[v] = cornerControlPoint[c];
+		meshNode->m_positionArray[v] = source.controlPointArray[cornerControlPoint[c]];
+		meshNode->m_normalArray[v] = cornerNormal[c];
+
+		for(size_t uv=0;uv<numUVSet;uv++)
+			meshNode->m_texcoordArray[uv*vertexCount + v] = cornerUV[uv*cornerCount + c];
+	}
+}
+
+// 擪̃XL̃NX^{[, NX^̃Rg[|CgƃEFCgǂݏo.
+// _̑IʂƗʎqBuildSkinWeightsōs
+void CFBXLoader::CopySkinData(FbxMesh* pMesh, FBX_MESH_NODE* meshNode, FBX_NODE_SOURCE* pSource)
+{
+	if(!pMesh || pMesh->GetDeformerCount(FbxDeformer::eSkin) <= 0)
+		return ;
+
+	FbxSkin* pSkin = static_cast<FbxSkin*>(pMesh->GetDeformer(0, FbxDeformer::eSkin));
+	const int controlPointCount = pMesh->GetControlPointsCount();
+	int clusterCount = pSkin ? pSkin->GetClusterCount() : 0;
+	if(clusterCount <= 0 || controlPointCount <= 0)
+		return ;
+
+	if(clusterCount > static_cast<int>(FBX_SKIN_BONE_MAX))
+	{
+		FBXSDK_printf("Warning: %s has %d bones. Only the first %u are used\n", meshNode->name.c_str(), clusterCount, FBX_SKIN_BONE_MAX);
+		clusterCount = FBX_SKIN_BONE_MAX;
 	}
+
+	meshNode->m_boneArray.reserve(clusterCount);
+	pSource->clusterStartArray.reserve(clusterCount + 1);
+	for(int i=0;i<clusterCount;i++)
+	{
+		FbxCluster* pCluster = pSkin->GetCluster(i);
+		pSource->clusterStartArray.push_back(static_cast<uint32_t>(pSource->clusterPointArray.size()));
+
+		FBX_SKIN_BONE bone;
+		bone.nodeId = -1;
+		if(pCluster && pCluster->GetLink())
+		{
+			std::unordered_map<FbxNode*, int>::const_iterator it = m_nodeIdMap.find(pCluster->GetLink());
+			if(it != m_nodeIdMap.end())
+				bone.nodeId = it->second;
+		}
+
+		// bṼoChsƃ{[̃oChs̋ts(sxNg mesh * bone^-1)
+		FbxAMatrix lMeshBind, lBoneBind;
+		lMeshBind.SetIdentity();
+		lBoneBind.SetIdentity();
+		if(pCluster)
+		{
+			pCluster->GetTransformMatrix(lMeshBind);
+			pCluster->GetTransformLinkMatrix(lBoneBind);
+		}
+		FbxMatrix lInverseBind = lBoneBind.Inverse() * lMeshBind;
+		FBXMatrixToFloat16(&lInverseBind, bone.inverseBind);
+		meshNode->m_boneArray.push_back(bone);
+
+		if(!pCluster)
+			continue;
+
+		const int indexCount = pCluster->GetControlPointIndicesCount();
+		const int* pIndices = pCluster->GetControlPointIndices();
+		const double* pWeights = pCluster->GetControlPointWeights();
+		if(!pIndices || !pWeights)
+			continue;
+
+		for(int k=0;k<indexCount;k++)
+		{
+			const int cp = pIndices[k];
+			if(cp < 0 || cp >= controlPointCount)
+				continue;
+
+			pSource->clusterPointArray.push_back(cp);
+			pSource->clusterWeightArray.push_back(static_cast<float>(pWeights[k]));
+		}
+	}
+	pSource->clusterStartArray.push_back(static_cast<uint32_t>(pSource->clusterPointArray.size()));
+}
+
+// ȇ傫FBX_SKIN_INFLUENCE_MAX܂ŎcƗp
+struct SKIN_INFLUENCE
+{
+	int		bone[FBX_SKIN_INFLUENCE_MAX];
+	float	weight[FBX_SKIN_INFLUENCE_MAX];
+
+	void Add(const int boneId, const float w)
+	{
+		if(w <= weight[FBX_SKIN_INFLUENCE_MAX - 1])
+			return ;
+
+		int i = FBX_SKIN_INFLUENCE_MAX - 1;
+		for(;i>0 && weight[i-1] < w;i--)
+		{
+			bone[i] = bone[i-1];
+			weight[i] = weight[i-1];
+		}
+		bone[i] = boneId;
+		weight[i] = w;
+	}
+};
+
+// _ɑ傫4܂ł̃EFCgc.
+// EFCg͍v255ɂȂ悤ۂ, ۂ߂̌덷͈ԑ傫EFCgɑ
+void CFBXLoader::BuildSkinWeights(const FBX_NODE_SOURCE& source, const std::vector<int>& vertexControlPoint, FBX_MESH_NODE* meshNode)
+{
+	const size_t controlPointCount = source.controlPointArray.size();
+	if(vertexControlPoint.empty() || source.clusterStartArray.size() < 2 || controlPointCount==0)
+		return ;
+
+	SKIN_INFLUENCE empty;
+	for(unsigned int i=0;i<FBX_SKIN_INFLUENCE_MAX;i++)
+	{
+		empty.bone[i] = 0;
+		empty.weight[i] = 0.0f;
+	}
+	std::vector<SKIN_INFLUENCE>	influenceArray(controlPointCount, empty);
+
+	const size_t clusterCount = source.clusterStartArray.size() - 1;
+	for(size_t i=0;i<clusterCount;i++)
+	{
+		for(uint32_t k=source.clusterStartArray[i];k<source.clusterStartArray[i + 1];k++)
+		{
+			const int cp = source.clusterPointArray[k];
+			if(cp >= 0 && static_cast<size_t>(cp) < controlPointCount)
+				influenceArray[cp].Add(static_cast<int>(i), source.clusterWeightArray[k]);
+		}
+	}
+
+	// Rg[|CgɗʎqĂ, nڌ̒_ɔz
+	std::vector<FBX_SKIN_WEIGHT>	controlPointSkin(controlPointCount);
+	for(size_t cp=0;cp<controlPointCount;cp++)
+	{
+		const SKIN_INFLUENCE& influence = influenceArray[cp];
+		FBX_SKIN_WEIGHT& skin = controlPointSkin[cp];
+
+		float sum = 0.0f;
+		for(unsigned int i=0;i<FBX_SKIN_INFLUENCE_MAX;i++)
+			sum += influence.weight[i];
+
+		int total = 0;
+		for(unsigned int i=0;i<FBX_SKIN_INFLUENCE_MAX;i++)
+		{
+			const int quantized = sum > 0.0f ? static_cast<int>(influence.weight[i] / sum * 255.0f + 0.5f) : 0;
+			skin.index[i] = static_cast<uint8_t>(influence.bone[i]);
+			skin.weight[i] = static_cast<uint8_t>(quantized);
+			total += quantized;
+		}
+		if(total > 0)
+			skin.weight[0] = static_cast<uint8_t>(skin.weight[0] + 255 - total);
+	}
+
+	meshNode->m_skinArray.resize(vertexControlPoint.size());
+	for(size_t v=0;v<vertexControlPoint.size();v++)
+		meshNode->m_skinArray[v] = controlPointSkin[vertexControlPoint[v]];
 }
 
-FBX_MESH_NODE& CFBXLoader::GetNode(const unsigned int id)
+const FBX_MESH_NODE& CFBXLoader::GetNode(const unsigned int id) const
 {
 	return m_meshNodeArray[id];
 }
@@ -14,6 +14,7 @@
 #include <string>
 #include <memory>
 #include <unordered_map>
+#include <malloc.h>
 
 #ifndef FBXSDK_NEW_API
 #define FBXSDK_NEW_API	// Vo[WgƂp
@@ -22,6 +23,8 @@
 #include <fbxsdk.h>
 #include <Windows.h>
 
+#include "CFBXLoadStats.h"
+
 // UVSet, _UVZbg
 typedef std::tr1::unordered_map<std::string, int> UVsetID;
 // UVSet, eNX`pX(PUVSetɕ̃eNX`Ԃ牺Ă邱Ƃ)
@@ -30,6 +33,110 @@ typedef std::tr1::unordered_map<std::string, std::vector<std::string>> TextureSe
 namespace FBX_LOADER
 {
 
+class CFBXAnimation;
+
+// 16byteACgŃmۂAP[^(SIMDňꊇ邽)
+template<class T, size_t Alignment = 16>
+struct ALIGNED_ALLOCATOR
+{
+	typedef T			value_type;
+	typedef T*			pointer;
+	typedef const T*	const_pointer;
+	typedef T&			reference;
+	typedef const T&	const_reference;
+	typedef size_t		size_type;
+	typedef ptrdiff_t	difference_type;
+
+	template<class U> struct rebind { typedef ALIGNED_ALLOCATOR<U, Alignment> other; };
+
+	ALIGNED_ALLOCATOR() {}
+	template<class U> ALIGNED_ALLOCATOR(const ALIGNED_ALLOCATOR<U, Alignment>&) {}
+
+	pointer address(reference r) const { return &r; }
+	const_pointer address(const_reference r) const { return &r; }
+
+	pointer allocate(size_type n, const void* = 0)
+	{
+		void* p = _aligned_malloc(n*sizeof(T), Alignment);
+		if(!p)
+			throw std::bad_alloc();
+		return static_cast<pointer>(p);
+	}
+
+	void deallocate(pointer p, size_type) { _aligned_free(p); }
+
+	size_type max_size() const { return static_cast<size_type>(-1) / sizeof(T); }
+
+	void construct(pointer p, const T& v) { new(static_cast<void*>(p)) T(v); }
+	void destroy(pointer p) { p->~T(); }
+
+	template<class U> bool operator==(const ALIGNED_ALLOCATOR<U, Alignment>&) const { return true; }
+	template<class U> bool operator!=(const ALIGNED_ALLOCATOR<U, Alignment>&) const { return false; }
+};
+
+// [_[̒_(float32)
+struct FBX_FLOAT3
+{
+	float x, y, z;
+};
+
+struct FBX_FLOAT2
+{
+	float x, y;
+};
+
+typedef std::vector<FBX_FLOAT3, ALIGNED_ALLOCATOR<FBX_FLOAT3>>	FBX_FLOAT3_STREAM;
+typedef std::vector<FBX_FLOAT2, ALIGNED_ALLOCATOR<FBX_FLOAT2>>	FBX_FLOAT2_STREAM;
+
+// 1_̃{[̉e, 1bṼ{[(CfbNXUINT8Ȃ̂256܂)̏
+const unsigned int FBX_SKIN_INFLUENCE_MAX = 4;
+const unsigned int FBX_SKIN_BONE_MAX = 256;
+
+// _̃XLEFCg. weight͍v255ɐKUNORM8ő傫. gȂ0.
+// e{[_weightS0(bV̍s񂾂œ)
+struct FBX_SKIN_WEIGHT
+{
+	uint8_t		index[FBX_SKIN_INFLUENCE_MAX];		// FBX_MESH_NODE::m_boneArray̓Y
+	uint8_t		weight[FBX_SKIN_INFLUENCE_MAX];
+};
+
+typedef std::vector<FBX_SKIN_WEIGHT>	FBX_SKIN_STREAM;
+
+struct FBX_SKIN_BONE
+{
+	int		nodeId;				// {[̃m[h(CFBXLoader::GetNode̓Y). Ȃ-1
+	float	inverseBind[16];	// oCh|[Ył̃bV̍W  {[̍W
+};
+
+// m[h̃[JW(_ƓW)̋E.
+// box*DirectX::BoundingBox(Center, Extents), sphere*DirectX::BoundingSphere(Center, Radius)Ɠ.
+// _sphereRadius. XLœ_͊܂܂Ȃ(oCh|[Y)
+struct FBX_BOUNDS
+{
+	FBX_FLOAT3	boxCenter;
+	FBX_FLOAT3	boxExtents;
+	FBX_FLOAT3	sphereCenter;
+	float		sphereRadius;
+
+	FBX_BOUNDS()
+	{
+		Reset();
+	}
+
+	void Reset()
+	{
+		boxCenter.x = boxCenter.y = boxCenter.z = 0.0f;
+		boxExtents.x = boxExtents.y = boxExtents.z = 0.0f;
+		sphereCenter.x = sphereCenter.y = sphereCenter.z = 0.0f;
+		sphereRadius = -1.0f;
+	}
+
+	bool IsValid() const { return sphereRadius >= 0.0f; }
+
+	// ͒_̍ŏEő. ͔̒Sԉ_܂ł̋𔼌aɂ
+	void Compute(const FBX_FLOAT3* pPositions, const size_t count);
+};
+
 struct FBX_MATRIAL_ELEMENT
 {
 	enum MATERIAL_ELEMENT_TYPE
@@ -47,9 +154,38 @@ struct FBX_MATRIAL_ELEMENT
 
 	FBX_MATRIAL_ELEMENT()
 	{
+		type = ELEMENT_NONE;
+		r = g = b = a = 0.0f;
 		textureSetArray.clear();
 	}
 
+	FBX_MATRIAL_ELEMENT(const FBX_MATRIAL_ELEMENT& src)
+	{
+		*this = src;
+	}
+
+	// VS2013̓[uRXgN^Ȃ̂ŖIɏ
+	FBX_MATRIAL_ELEMENT(FBX_MATRIAL_ELEMENT&& src)
+	{
+		*this = std::move(src);
+	}
+
+	FBX_MATRIAL_ELEMENT& operator=(const FBX_MATRIAL_ELEMENT& src)
+	{
+		type = src.type;
+		r = src.r;	g = src.g;	b = src.b;	a = src.a;
+		textureSetArray = src.textureSetArray;
+		return *this;
+	}
+
+	FBX_MATRIAL_ELEMENT& operator=(FBX_MATRIAL_ELEMENT&& src)
+	{
+		type = src.type;
+		r = src.r;	g = src.g;	b = src.b;	a = src.a;
+		textureSetArray = std::move(src.textureSetArray);
+		return *this;
+	}
+
 	~FBX_MATRIAL_ELEMENT()
 	{
 		Release();
@@ -83,6 +219,47 @@ struct FBX_MATERIAL_NODE
 
 	float shininess;
 	float TransparencyFactor;		// ߓx
+
+	FBX_MATERIAL_NODE()
+	{
+		type = MATERIAL_LAMBERT;
+		shininess = 0.0f;
+		TransparencyFactor = 0.0f;
+	}
+
+	FBX_MATERIAL_NODE(const FBX_MATERIAL_NODE& src)
+	{
+		*this = src;
+	}
+
+	FBX_MATERIAL_NODE(FBX_MATERIAL_NODE&& src)
+	{
+		*this = std::move(src);
+	}
+
+	FBX_MATERIAL_NODE& operator=(const FBX_MATERIAL_NODE& src)
+	{
+		type = src.type;
+		ambient = src.ambient;
+		diffuse = src.diffuse;
+		emmisive = src.emmisive;
+		specular = src.specular;
+		shininess = src.shininess;
+		TransparencyFactor = src.TransparencyFactor;
+		return *this;
+	}
+
+	FBX_MATERIAL_NODE& operator=(FBX_MATERIAL_NODE&& src)
+	{
+		type = src.type;
+		ambient = std::move(src.ambient);
+		diffuse = std::move(src.diffuse);
+		emmisive = std::move(src.emmisive);
+		specular = std::move(src.specular);
+		shininess = src.shininess;
+		TransparencyFactor = src.TransparencyFactor;
+		return *this;
+	}
 };
 
 // bV\vf
@@ -98,18 +275,63 @@ struct FBX_MESH_NODE
 {
 	std::string		name;			// m[h
 	std::string		parentName;		// em[h(eȂȂ"null"Ƃ̂.rootm[h̑Ή)
+	int				parentId;		// em[h̓Y(CFBXLoader::GetNode). e͕KOɂ, ؂͘Aĕ. root-1
 	
 	MESH_ELEMENTS	elements;		// bVێf[^\
 	std::vector<FBX_MATERIAL_NODE> m_materialArray;		// }eA
 	UVsetID		uvsetID;
 
 	std::vector<unsigned int>		indexArray;				// CfbNXz
-	std::vector<FbxVector4>			m_positionArray;		// |WVz
-	std::vector<FbxVector4>			m_normalArray;			// @z
-	std::vector<FbxVector2>			m_texcoordArray;		// eNX`Wz
+	std::vector<unsigned int>		materialIndexArray;		// (Op`)m_materialArray̓Y. ȂS0
+	FBX_FLOAT3_STREAM				m_positionArray;		// |WVz
+	FBX_FLOAT3_STREAM				m_normalArray;			// @z
+	FBX_FLOAT2_STREAM				m_texcoordArray;		// eNX`Wz(UVSetɒ_)
+	FBX_SKIN_STREAM					m_skinArray;			// XLEFCg(_). XL΋
+	std::vector<FBX_SKIN_BONE>		m_boneArray;			// XL̃{[(NX^)
+
+	unsigned int	sourceVertexCount;	// nڑO̒_(|S_)
+	FBX_BOUNDS		bounds;				// m_positionArray̋E
 
 	float	mat4x4[16];	// Matrix
 
+	FBX_MESH_NODE()
+	{
+		ZeroMemory( &elements, sizeof(MESH_ELEMENTS) );
+		parentId = -1;
+		sourceVertexCount = 0;
+		ZeroMemory( mat4x4, sizeof(mat4x4) );
+	}
+
+	// _zĂ̂ŃRs[͋֎~. [û
+	FBX_MESH_NODE(FBX_MESH_NODE&& src)
+	{
+		*this = std::move(src);
+	}
+
+	FBX_MESH_NODE& operator=(FBX_MESH_NODE&& src)
+	{
+		if(this == &src)
+			return *this;
+
+		name = std::move(src.name);
+		parentName = std::move(src.parentName);
+		parentId = src.parentId;
+		elements = src.elements;
+		m_materialArray = std::move(src.m_materialArray);
+		uvsetID = std::move(src.uvsetID);
+		indexArray = std::move(src.indexArray);
+		materialIndexArray = std::move(src.materialIndexArray);
+		m_positionArray = std::move(src.m_positionArray);
+		m_normalArray = std::move(src.m_normalArray);
+		m_texcoordArray = std::move(src.m_texcoordArray);
+		m_skinArray = std::move(src.m_skinArray);
+		m_boneArray = std::move(src.m_boneArray);
+		sourceVertexCount = src.sourceVertexCount;
+		bounds = src.bounds;
+		memcpy( mat4x4, src.mat4x4, sizeof(mat4x4) );
+		return *this;
+	}
+
 	~FBX_MESH_NODE()
 	{
 		Release();
@@ -121,8 +343,41 @@ struct FBX_MESH_NODE
 		m_texcoordArray.clear();
 		m_materialArray.clear();
 		indexArray.clear();
+		materialIndexArray.clear();
 		m_positionArray.clear();
 		m_normalArray.clear();
+		m_skinArray.clear();
+		m_boneArray.clear();
+		bounds.Reset();
+	}
+
+private:
+	FBX_MESH_NODE(const FBX_MESH_NODE&);
+	FBX_MESH_NODE& operator=(const FBX_MESH_NODE&);
+};
+
+// SetupFBX SDKǂݏom[h1̒_ƃXL̐f[^.
+// SDK̃IuWFNgQƂȂ̂, nڂȂǂ͂ꂾĕɍs
+struct FBX_NODE_SOURCE
+{
+	FBX_FLOAT3_STREAM		controlPointArray;		// Rg[|Cg̍W
+	std::vector<int>		cornerControlPoint;		// |S_  Rg[|Cg
+	FBX_FLOAT3_STREAM		cornerNormal;			// |S_̖@
+	FBX_FLOAT2_STREAM		cornerUV;				// |S_UV(UVSetɃ|S_)
+	std::vector<uint32_t>	clusterStartArray;		// NX^clusterPointArraẙJnʒu(NX^+1). XL΋
+	std::vector<int>		clusterPointArray;		// NX^eRg[|Cg(SNX^A)
+	std::vector<float>		clusterWeightArray;		// clusterPointArrayƓ
+
+	void Release()
+	{
+		// nڌ͗vȂ̂Ŋmۂ̈悲ƕԂ
+		FBX_FLOAT3_STREAM().swap(controlPointArray);
+		std::vector<int>().swap(cornerControlPoint);
+		FBX_FLOAT3_STREAM().swap(cornerNormal);
+		FBX_FLOAT2_STREAM().swap(cornerUV);
+		std::vector<uint32_t>().swap(clusterStartArray);
+		std::vector<int>().swap(clusterPointArray);
+		std::vector<float>().swap(clusterWeightArray);
 	}
 };
 
@@ -143,16 +398,36 @@ protected:
     FbxAnimLayer * mCurrentAnimLayer;
 
 	std::vector<FBX_MESH_NODE>		m_meshNodeArray;
+	std::unordered_map<FbxNode*, int>	m_nodeIdMap;	// FbxNode  m_meshNodeArray̓Y. CollectNodeō, ȍ~͓ǂނ
+
+	unsigned int	m_threadCount;		// BuildNodesParallelŎgXbh(0Ȃn[hEFAXbh)
+
+	CFBXAnimation*	m_pAnimation;		// SetupŏĂ񂾃Aj[V
+	float			m_animationSampleRate;	// Ă݂1b̃t[(0ȂĂ܂Ȃ)
+	float			m_animationTolerance;	// Ă񂾃L[k鎞̋e덷(0Ȃ爳kȂ)
+
+	FBX_LOAD_STATS	m_loadStats;
 
 	void InitializeSdkObjects(FbxManager*& pManager, FbxScene*& pScene);
-	void TriangulateRecursive(FbxNode* pNode);
+	void TriangulateScene();
+	void CollectTriangulateTarget(FbxNode* pNode, std::vector<FbxNodeAttribute*>& targetList);
 
-	void SetupNode(FbxNode* pNode, std::string parentName);
-	void Setup();
+	// FBX SDKG鏈(VOXbh)
+	void CollectNode(FbxNode* pNode, const std::string& parentName, const int parentId, std::vector<FbxNode*>& nodeList);
+	void SetupNode(FbxNode* pNode, FBX_MESH_NODE* meshNode, FBX_NODE_SOURCE* pSource);
+	void Setup(std::vector<FbxNode*>& nodeList, std::vector<FBX_NODE_SOURCE>& sourceArray);
+	void BakeAnimation(const std::vector<FbxNode*>& nodeList);
 
-	void CopyVertexData(FbxMesh*	pMesh, FBX_MESH_NODE* meshNode);
+	void CopyVertexData(FbxMesh*	pMesh, FBX_MESH_NODE* meshNode, FBX_NODE_SOURCE* pSource);
+	void CopySkinData(FbxMesh* pMesh, FBX_MESH_NODE* meshNode, FBX_NODE_SOURCE* pSource);
 	void CopyMatrialData(FbxSurfaceMaterial* mat, FBX_MATERIAL_NODE* destMat);
 
+	// FBX_NODE_SOURCE鏈()
+	void BuildNodesParallel(std::vector<FBX_NODE_SOURCE>& sourceArray);
+	static void BuildNode(FBX_NODE_SOURCE* pSource, FBX_MESH_NODE* meshNode);
+	static void WeldVertices(const FBX_NODE_SOURCE& source, FBX_MESH_NODE* meshNode, std::vector<int>* pVertexControlPoint);
+	static void BuildSkinWeights(const FBX_NODE_SOURCE& source, const std::vector<int>& vertexControlPoint, FBX_MESH_NODE* meshNode);
+
 	void ComputeNodeMatrix(FbxNode* pNode, FBX_MESH_NODE* meshNode);
 
 	void SetFbxColor(FBX_MATRIAL_ELEMENT& destColor, const FbxDouble3 srcColor);
@@ -185,9 +460,28 @@ public:
 	HRESULT LoadFBX(const char* filename, const eAXIS_SYSTEM axis);
 	FbxNode&	GetRootNode();
 
+	// nځEXLEFCgEĚvZ̕(1. 0Ȃn[hEFAXbh).
+	// FBX SDK̓XbhZ[tł͂Ȃ̂, SDK̓ǂݏo͂̐ݒɊւ炸VOXbh
+	void SetThreadCount(const unsigned int threadCount){ m_threadCount = threadCount; }
+	unsigned int GetThreadCount() const { return m_threadCount; }
+
+	// Aj[V̏Ă݊Ԋu. LoadFBX̑Oɐݒ肷
+	void SetAnimationSampleRate(const float sampleRate){ m_animationSampleRate = sampleRate; }
+	float GetAnimationSampleRate() const { return m_animationSampleRate; }
+
+	// Ă񂾃L[̈k̋e덷(V[̒P). CFBXAnimation::CompressQ
+	void SetAnimationCompression(const float tolerance){ m_animationTolerance = tolerance; }
+	float GetAnimationCompression() const { return m_animationTolerance; }
+
+	// Ă񂾃Aj[V(m[h̕тGetNodeƓ). m[hIsAnimatedfalse
+	const CFBXAnimation* GetAnimation() const { return m_pAnimation; }
+
+	// OLoadFBX̒iKƂ̎ԂƃJE^
+	const FBX_LOAD_STATS& GetLoadStats() const { return m_loadStats; }
+
 	size_t GetNodesCount(){ return m_meshNodeArray.size(); };		// m[h̎擾
 
-	FBX_MESH_NODE&	GetNode(const unsigned int id);
+	const FBX_MESH_NODE&	GetNode(const unsigned int id) const;
 };
 
 }	// FBX_LOADER
\ No newline at end of file
@@ -0,0 +1,635 @@
+// *********************************************************************************************************************
+///
+/// @file 		CFBXMeshCache.cpp
+/// @brief		œKς݃bṼoCiLbV(FBX SDKʂɓǂݍނ)
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#include "CFBXMeshCache.h"
+
+#include <stdio.h>
+
+namespace FBX_LOADER
+{
+
+static const uint64_t FNV_OFFSET_BASIS_64 = 14695981039346656037ULL;
+static const uint64_t FNV_PRIME_64 = 1099511628211ULL;
+
+static inline uint64_t AlignUp(const uint64_t value, const uint64_t alignment)
+{
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+//
+CMappedView::CMappedView()
+{
+	m_pBase = nullptr;
+	m_pData = nullptr;
+	m_size = 0;
+}
+
+CMappedView::~CMappedView()
+{
+	Unmap();
+}
+
+void CMappedView::Unmap()
+{
+	if(m_pBase)
+	{
+		UnmapViewOfFile(m_pBase);
+		m_pBase = nullptr;
+	}
+
+	m_pData = nullptr;
+	m_size = 0;
+}
+
+//
+CMappedFile::CMappedFile()
+{
+	m_hFile = INVALID_HANDLE_VALUE;
+	m_hMapping = nullptr;
+	m_pData = nullptr;
+	m_size = 0;
+	m_fileSize = 0;
+}
+
+CMappedFile::~CMappedFile()
+{
+	Close();
+}
+
+HRESULT CMappedFile::Open(const char* filename, const bool mapWholeFile)
+{
+	Close();
+
+	if(!filename)
+		return E_INVALIDARG;
+
+	m_hFile = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if(m_hFile == INVALID_HANDLE_VALUE)
+		return HRESULT_FROM_WIN32(GetLastError());
+
+	LARGE_INTEGER fileSize;
+	if(!GetFileSizeEx(m_hFile, &fileSize) || fileSize.QuadPart <= 0)
+	{
+		Close();
+		return E_FAIL;
+	}
+	m_fileSize = static_cast<uint64_t>(fileSize.QuadPart);
+
+	m_hMapping = CreateFileMappingA(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if(!m_hMapping)
+	{
+		HRESULT hr = HRESULT_FROM_WIN32(GetLastError());
+		Close();
+		return hr;
+	}
+
+	if(!mapWholeFile)
+		return S_OK;
+
+	m_pData = static_cast<const BYTE*>(MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0));
+	if(!m_pData)
+	{
+		HRESULT hr = HRESULT_FROM_WIN32(GetLastError());
+		Close();
+		return hr;
+	}
+	m_size = static_cast<size_t>(m_fileSize);
+
+	return S_OK;
+}
+
+void CMappedFile::Close()
+{
+	if(m_pData)
+	{
+		UnmapViewOfFile(m_pData);
+		m_pData = nullptr;
+	}
+
+	if(m_hMapping)
+	{
+		CloseHandle(m_hMapping);
+		m_hMapping = nullptr;
+	}
+
+	if(m_hFile != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(m_hFile);
+		m_hFile = INVALID_HANDLE_VALUE;
+	}
+
+	m_size = 0;
+	m_fileSize = 0;
+}
+
+HRESULT CMappedFile::MapView(const uint64_t offset, const size_t size, CMappedView* pView) const
+{
+	if(!pView || !m_hMapping || size == 0 || offset + size > m_fileSize)
+		return E_INVALIDARG;
+
+	pView->Unmap();
+
+	// MapViewOfFilẽItZbg͊蓖ėx(ʏ64KB)̔{łȂ΂ȂȂ
+	SYSTEM_INFO systemInfo;
+	GetSystemInfo(&systemInfo);
+	const uint64_t viewOffset = offset - (offset % systemInfo.dwAllocationGranularity);
+	const size_t delta = static_cast<size_t>(offset - viewOffset);
+
+	const BYTE* pBase = static_cast<const BYTE*>(MapViewOfFile(m_hMapping, FILE_MAP_READ,
+		static_cast<DWORD>(viewOffset >> 32), static_cast<DWORD>(viewOffset & 0xffffffff), delta + size));
+	if(!pBase)
+		return HRESULT_FROM_WIN32(GetLastError());
+
+	pView->m_pBase = pBase;
+	pView->m_pData = pBase + delta;
+	pView->m_size = size;
+
+	return S_OK;
+}
+
+//
+void FBX_MESH_CACHE_SOURCE_NODE::SetNode(const FBX_MESH_NODE& fbxNode)
+{
+	name = fbxNode.name;
+	parentName = fbxNode.parentName;
+	parentId = fbxNode.parentId;
+	memcpy( mat4x4, fbxNode.mat4x4, sizeof(mat4x4) );
+	bounds = fbxNode.bounds;
+
+	materialArray = fbxNode.m_materialArray;
+	subsetArray.clear();
+}
+
+void FBX_MESH_CACHE_SOURCE_NODE::SetVertices(const void* pVertices, const uint32_t stride, const uint32_t count)
+{
+	vertexCount = count;
+	vertices.resize(static_cast<size_t>(stride) * count);
+	if(vertices.size() > 0)
+		memcpy(&vertices[0], pVertices, vertices.size());
+}
+
+void FBX_MESH_CACHE_SOURCE_NODE::SetPositionDequant(const float* pScale, const float* pOffset)
+{
+	memcpy( positionScale, pScale, sizeof(positionScale) );
+	memcpy( positionOffset, pOffset, sizeof(positionOffset) );
+}
+
+void FBX_MESH_CACHE_SOURCE_NODE::SetIndices(const void* pIndices, const uint32_t stride, const uint32_t count)
+{
+	indexCount = count;
+	indexStride = stride;
+	indices.resize(static_cast<size_t>(stride) * count);
+	if(indices.size() > 0)
+		memcpy(&indices[0], pIndices, indices.size());
+}
+
+void FBX_MESH_CACHE_SOURCE_NODE::AddSubset(const uint32_t startIndex, const uint32_t indexCount, const uint32_t materialId)
+{
+	FBX_MESH_CACHE_SUBSET subset;
+	subset.startIndex = startIndex;
+	subset.indexCount = indexCount;
+	subset.materialId = materialId;
+	subsetArray.push_back(subset);
+}
+
+//
+CFBXMeshCacheWriter::CFBXMeshCacheWriter()
+{
+}
+
+CFBXMeshCacheWriter::~CFBXMeshCacheWriter()
+{
+	Release();
+}
+
+void CFBXMeshCacheWriter::Release()
+{
+	for(size_t i=0;i<m_nodeArray.size();i++)
+	{
+		delete m_nodeArray[i];
+	}
+	m_nodeArray.clear();
+}
+
+FBX_MESH_CACHE_SOURCE_NODE* CFBXMeshCacheWriter::AddNode()
+{
+	FBX_MESH_CACHE_SOURCE_NODE* pNode = new FBX_MESH_CACHE_SOURCE_NODE;
+	m_nodeArray.push_back(pNode);
+	return pNode;
+}
+
+static uint32_t AddString(std::vector<char>& stringArea, const std::string& str)
+{
+	const uint32_t offset = static_cast<uint32_t>(stringArea.size());
+	stringArea.insert(stringArea.end(), str.begin(), str.end());
+	stringArea.push_back('\0');
+	return offset;
+}
+
+static void SetColor(float dest[4], const FBX_MATRIAL_ELEMENT& src)
+{
+	dest[0] = src.r;
+	dest[1] = src.g;
+	dest[2] = src.b;
+	dest[3] = src.a;
+}
+
+HRESULT CFBXMeshCacheWriter::Write(const char* filename, const uint64_t sourceHash, const uint64_t sourceSize,
+		const uint32_t flags, const uint32_t vertexFormat, const uint32_t vertexStride)
+{
+	if(!filename)
+		return E_INVALIDARG;
+
+	const uint32_t nodeCount = static_cast<uint32_t>(m_nodeArray.size());
+
+	// m[h, }eA, TuZbg̃e[uƕ̈
+	std::vector<FBX_MESH_CACHE_NODE>		nodeTable(nodeCount);
+	std::vector<FBX_MESH_CACHE_MATERIAL>	materialTable;
+	std::vector<FBX_MESH_CACHE_SUBSET>		subsetTable;
+	std::vector<char>						stringArea;
+
+	for(uint32_t i=0;i<nodeCount;i++)
+	{
+		const FBX_MESH_CACHE_SOURCE_NODE& src = *m_nodeArray[i];
+		FBX_MESH_CACHE_NODE& dest = nodeTable[i];
+		ZeroMemory( &dest, sizeof(FBX_MESH_CACHE_NODE) );
+
+		memcpy( dest.mat4x4, src.mat4x4, sizeof(dest.mat4x4) );
+		memcpy( dest.positionScale, src.positionScale, sizeof(dest.positionScale) );
+		memcpy( dest.positionOffset, src.positionOffset, sizeof(dest.positionOffset) );
+		dest.bounds = src.bounds;
+
+		dest.nameOffset = AddString(stringArea, src.name);
+		dest.parentNameOffset = AddString(stringArea, src.parentName);
+		dest.parentId = src.parentId;
+
+		// `摤ƓDiffuse̐擪̃eNX`
+		dest.materialStart = static_cast<uint32_t>(materialTable.size());
+		dest.materialCount = static_cast<uint32_t>(src.materialArray.size());
+		for(size_t m=0;m<src.materialArray.size();m++)
+		{
+			const FBX_MATERIAL_NODE& srcMaterial = src.materialArray[m];
+
+			FBX_MESH_CACHE_MATERIAL material;
+			ZeroMemory( &material, sizeof(material) );
+			material.materialType = static_cast<uint32_t>(srcMaterial.type);
+			SetColor(material.ambient, srcMaterial.ambient);
+			SetColor(material.diffuse, srcMaterial.diffuse);
+			SetColor(material.specular, srcMaterial.specular);
+			SetColor(material.emmisive, srcMaterial.emmisive);
+			material.shininess = srcMaterial.shininess;
+			material.TransparencyFactor = srcMaterial.TransparencyFactor;
+
+			std::string diffuseTexture;
+			TextureSet::const_iterator it = srcMaterial.diffuse.textureSetArray.begin();
+			if(it != srcMaterial.diffuse.textureSetArray.end() && it->second.size())
+				diffuseTexture = it->second[0];
+			material.diffuseTextureOffset = AddString(stringArea, diffuseTexture);
+
+			materialTable.push_back(material);
+		}
+
+		dest.subsetStart = static_cast<uint32_t>(subsetTable.size());
+		dest.subsetCount = static_cast<uint32_t>(src.subsetArray.size());
+		subsetTable.insert(subsetTable.end(), src.subsetArray.begin(), src.subsetArray.end());
+
+		dest.vertexCount = src.vertexCount;
+		dest.indexCount = src.indexCount;
+		dest.indexStride = src.indexStride;
+	}
+
+	FBX_MESH_CACHE_HEADER header;
+	ZeroMemory( &header, sizeof(header) );
+	header.magic = FBX_MESH_CACHE_MAGIC;
+	header.version = FBX_MESH_CACHE_VERSION;
+	header.sourceHash = sourceHash;
+	header.sourceSize = sourceSize;
+	header.flags = flags;
+	header.vertexStride = vertexStride;
+	header.vertexFormat = vertexFormat;
+	header.nodeCount = nodeCount;
+	header.materialCount = static_cast<uint32_t>(materialTable.size());
+	header.subsetCount = static_cast<uint32_t>(subsetTable.size());
+	header.stringOffset = static_cast<uint32_t>(sizeof(FBX_MESH_CACHE_HEADER) +
+		sizeof(FBX_MESH_CACHE_NODE) * nodeCount +
+		sizeof(FBX_MESH_CACHE_MATERIAL) * materialTable.size() +
+		sizeof(FBX_MESH_CACHE_SUBSET) * subsetTable.size());
+	header.stringSize = static_cast<uint32_t>(stringArea.size());
+
+	// _ECfbNX̃ZNV͂ꂼy[WEɒu
+	uint64_t offset = header.stringOffset + header.stringSize;
+	for(uint32_t i=0;i<nodeCount;i++)
+	{
+		const FBX_MESH_CACHE_SOURCE_NODE& src = *m_nodeArray[i];
+
+		offset = AlignUp(offset, FBX_MESH_CACHE_SECTION_ALIGNMENT);
+		nodeTable[i].vertexOffset = offset;
+		offset += src.vertices.size();
+
+		offset = AlignUp(offset, FBX_MESH_CACHE_SECTION_ALIGNMENT);
+		nodeTable[i].indexOffset = offset;
+		offset += src.indices.size();
+	}
+
+	// o. rŎsꍇ͉ꂽLbVcȂ
+	FILE* fp = nullptr;
+	if(fopen_s(&fp, filename, "wb") != 0 || !fp)
+		return E_FAIL;
+
+	bool succeeded = true;
+	succeeded &= fwrite(&header, sizeof(header), 1, fp) == 1;
+	if(nodeCount > 0)
+		succeeded &= fwrite(&nodeTable[0], sizeof(FBX_MESH_CACHE_NODE), nodeCount, fp) == nodeCount;
+	if(materialTable.size() > 0)
+		succeeded &= fwrite(&materialTable[0], sizeof(FBX_MESH_CACHE_MATERIAL), materialTable.size(), fp) == materialTable.size();
+	if(subsetTable.size() > 0)
+		succeeded &= fwrite(&subsetTable[0], sizeof(FBX_MESH_CACHE_SUBSET), subsetTable.size(), fp) == subsetTable.size();
+	if(stringArea.size() > 0)
+		succeeded &= fwrite(&stringArea[0], 1, stringArea.size(), fp) == stringArea.size();
+
+	const BYTE padding[FBX_MESH_CACHE_SECTION_ALIGNMENT] = { 0 };
+	uint64_t written = header.stringOffset + header.stringSize;
+	for(uint32_t i=0;i<nodeCount && succeeded;i++)
+	{
+		const FBX_MESH_CACHE_SOURCE_NODE& src = *m_nodeArray[i];
+
+		const std::vector<BYTE>* payloads[2] = { &src.vertices, &src.indices };
+		const uint64_t payloadOffsets[2] = { nodeTable[i].vertexOffset, nodeTable[i].indexOffset };
+		for(int j=0;j<2;j++)
+		{
+			const size_t padSize = static_cast<size_t>(payloadOffsets[j] - written);
+			if(padSize > 0)
+				succeeded &= fwrite(padding, 1, padSize, fp) == padSize;
+
+			if(payloads[j]->size() > 0)
+				succeeded &= fwrite(&(*payloads[j])[0], 1, payloads[j]->size(), fp) == payloads[j]->size();
+
+			written = payloadOffsets[j] + payloads[j]->size();
+		}
+	}
+
+	succeeded &= fclose(fp) == 0;
+
+	if(!succeeded)
+	{
+		DeleteFileA(filename);
+		return E_FAIL;
+	}
+
+	return S_OK;
+}
+
+//
+CFBXMeshCache::CFBXMeshCache()
+{
+	m_pHeader = nullptr;
+	m_pNodes = nullptr;
+	m_pMaterials = nullptr;
+	m_pSubsets = nullptr;
+}
+
+CFBXMeshCache::~CFBXMeshCache()
+{
+	Close();
+}
+
+HRESULT CFBXMeshCache::OpenFile(const char* filename)
+{
+	Close();
+
+	HRESULT hr = m_file.Open(filename, false);
+	if(FAILED(hr))
+		return hr;
+
+	if(m_file.GetFileSize() < sizeof(FBX_MESH_CACHE_HEADER))
+	{
+		Close();
+		return E_FAIL;
+	}
+
+	// ܂wb_, _ECfbNXO̕܂Ƃ߂ă}bv
+	uint64_t headerAreaSize = 0;
+	{
+		CMappedView view;
+		hr = m_file.MapView(0, sizeof(FBX_MESH_CACHE_HEADER), &view);
+		if(FAILED(hr))
+		{
+			Close();
+			return hr;
+		}
+
+		const FBX_MESH_CACHE_HEADER* pHeader = reinterpret_cast<const FBX_MESH_CACHE_HEADER*>(view.GetData());
+		if(pHeader->magic != FBX_MESH_CACHE_MAGIC || pHeader->version != FBX_MESH_CACHE_VERSION)
+		{
+			Close();
+			return E_FAIL;
+		}
+		headerAreaSize = static_cast<uint64_t>(pHeader->stringOffset) + pHeader->stringSize;
+	}
+
+	if(headerAreaSize < sizeof(FBX_MESH_CACHE_HEADER) || headerAreaSize > m_file.GetFileSize())
+	{
+		Close();
+		return E_FAIL;
+	}
+
+	hr = m_file.MapView(0, static_cast<size_t>(headerAreaSize), &m_headerView);
+	if(FAILED(hr))
+	{
+		Close();
+		return hr;
+	}
+
+	m_pHeader = reinterpret_cast<const FBX_MESH_CACHE_HEADER*>(m_headerView.GetData());
+	m_pNodes = reinterpret_cast<const FBX_MESH_CACHE_NODE*>(m_headerView.GetData() + sizeof(FBX_MESH_CACHE_HEADER));
+	m_pMaterials = reinterpret_cast<const FBX_MESH_CACHE_MATERIAL*>(m_pNodes + m_pHeader->nodeCount);
+	m_pSubsets = reinterpret_cast<const FBX_MESH_CACHE_SUBSET*>(m_pMaterials + m_pHeader->materialCount);
+
+	return S_OK;
+}
+
+HRESULT CFBXMeshCache::Open(const char* filename, const uint64_t sourceHash, const uint64_t sourceSize,
+		const uint32_t flags, const uint32_t vertexFormat, const uint32_t vertexStride)
+{
+	HRESULT hr = OpenFile(filename);
+	if(FAILED(hr))
+		return hr;
+
+	if(m_pHeader->sourceHash != sourceHash || m_pHeader->sourceSize != sourceSize ||
+		m_pHeader->flags != flags || !Validate(vertexFormat, vertexStride))
+	{
+		Close();
+		return E_FAIL;
+	}
+
+	return S_OK;
+}
+
+HRESULT CFBXMeshCache::OpenBaked(const char* filename, const uint32_t vertexFormat, const uint32_t vertexStride)
+{
+	HRESULT hr = OpenFile(filename);
+	if(FAILED(hr))
+		return hr;
+
+	if(!Validate(vertexFormat, vertexStride))
+	{
+		Close();
+		return E_FAIL;
+	}
+
+	return S_OK;
+}
+
+// m[he[u, , eZNVt@C͈̔͂Ɏ܂Ă邩mF
+bool CFBXMeshCache::Validate(const uint32_t vertexFormat, const uint32_t vertexStride) const
+{
+	const uint64_t fileSize = m_file.GetFileSize();
+
+	if(m_pHeader->vertexFormat != vertexFormat || m_pHeader->vertexStride != vertexStride)
+		return false;
+
+	const uint64_t tableEnd = sizeof(FBX_MESH_CACHE_HEADER) +
+		static_cast<uint64_t>(sizeof(FBX_MESH_CACHE_NODE)) * m_pHeader->nodeCount +
+		static_cast<uint64_t>(sizeof(FBX_MESH_CACHE_MATERIAL)) * m_pHeader->materialCount +
+		static_cast<uint64_t>(sizeof(FBX_MESH_CACHE_SUBSET)) * m_pHeader->subsetCount;
+	if(m_pHeader->stringOffset < tableEnd)
+		return false;
+	if(m_pHeader->stringSize == 0 || m_headerView.GetData()[m_pHeader->stringOffset + m_pHeader->stringSize - 1] != '\0')
+		return false;
+
+	for(uint32_t i=0;i<m_pHeader->nodeCount;i++)
+	{
+		const FBX_MESH_CACHE_NODE& node = m_pNodes[i];
+
+		if(node.nameOffset >= m_pHeader->stringSize || node.parentNameOffset >= m_pHeader->stringSize)
+			return false;
+
+		// e͕KOɂ
+		if(node.parentId < -1 || node.parentId >= static_cast<int32_t>(i))
+			return false;
+
+		if(static_cast<uint64_t>(node.materialStart) + node.materialCount > m_pHeader->materialCount ||
+			static_cast<uint64_t>(node.subsetStart) + node.subsetCount > m_pHeader->subsetCount)
+			return false;
+
+		for(uint32_t m=0;m<node.materialCount;m++)
+		{
+			if(m_pMaterials[node.materialStart + m].diffuseTextureOffset >= m_pHeader->stringSize)
+				return false;
+		}
+
+		for(uint32_t s=0;s<node.subsetCount;s++)
+		{
+			const FBX_MESH_CACHE_SUBSET& subset = m_pSubsets[node.subsetStart + s];
+			if(static_cast<uint64_t>(subset.startIndex) + subset.indexCount > node.indexCount)
+				return false;
+		}
+
+		if(node.indexStride != sizeof(uint16_t) && node.indexStride != sizeof(uint32_t))
+			return false;
+
+		if(node.vertexOffset % FBX_MESH_CACHE_SECTION_ALIGNMENT != 0 || node.indexOffset % FBX_MESH_CACHE_SECTION_ALIGNMENT != 0)
+			return false;
+
+		const uint64_t vertexSize = static_cast<uint64_t>(node.vertexCount) * vertexStride;
+		const uint64_t indexSize = static_cast<uint64_t>(node.indexCount) * node.indexStride;
+		if(node.vertexOffset + vertexSize > fileSize || node.indexOffset + indexSize > fileSize)
+			return false;
+	}
+
+	return true;
+}
+
+void CFBXMeshCache::Close()
+{
+	m_pHeader = nullptr;
+	m_pNodes = nullptr;
+	m_pMaterials = nullptr;
+	m_pSubsets = nullptr;
+	m_headerView.Unmap();
+	m_file.Close();
+}
+
+const char* CFBXMeshCache::GetString(const uint32_t offset) const
+{
+	return reinterpret_cast<const char*>(m_headerView.GetData() + m_pHeader->stringOffset + offset);
+}
+
+HRESULT CFBXMeshCache::MapVertices(const FBX_MESH_CACHE_NODE& node, CMappedView* pView) const
+{
+	return m_file.MapView(node.vertexOffset, static_cast<size_t>(node.vertexCount) * m_pHeader->vertexStride, pView);
+}
+
+HRESULT CFBXMeshCache::MapIndices(const FBX_MESH_CACHE_NODE& node, CMappedView* pView) const
+{
+	return m_file.MapView(node.indexOffset, static_cast<size_t>(node.indexCount) * node.indexStride, pView);
+}
+
+static void GetColor(FBX_MATRIAL_ELEMENT& dest, const float src[4])
+{
+	dest.r = src[0];
+	dest.g = src[1];
+	dest.b = src[2];
+	dest.a = src[3];
+}
+
+void CFBXMeshCache::GetMaterial(const FBX_MESH_CACHE_NODE& node, const uint32_t materialId, FBX_MATERIAL_NODE* pMaterial) const
+{
+	if(!pMaterial || materialId >= node.materialCount)
+		return ;
+
+	const FBX_MESH_CACHE_MATERIAL& material = m_pMaterials[node.materialStart + materialId];
+
+	pMaterial->type = static_cast<FBX_MATERIAL_NODE::eMATERIAL_TYPE>(material.materialType);
+	GetColor(pMaterial->ambient, material.ambient);
+	GetColor(pMaterial->diffuse, material.diffuse);
+	GetColor(pMaterial->specular, material.specular);
+	GetColor(pMaterial->emmisive, material.emmisive);
+	pMaterial->shininess = material.shininess;
+	pMaterial->TransparencyFactor = material.TransparencyFactor;
+
+	const char* texture = GetString(material.diffuseTextureOffset);
+	if(texture[0] != '\0')
+		pMaterial->diffuse.textureSetArray[""].push_back(texture);
+}
+
+HRESULT CFBXMeshCache::HashFile(const char* filename, uint64_t* pHash, uint64_t* pSize)
+{
+	if(!filename || !pHash || !pSize)
+		return E_INVALIDARG;
+
+	CMappedFile file;
+	HRESULT hr = file.Open(filename);
+	if(FAILED(hr))
+		return hr;
+
+	uint64_t hash = FNV_OFFSET_BASIS_64;
+	const BYTE* p = file.GetData();
+	const size_t size = file.GetSize();
+	for(size_t i=0;i<size;i++)
+	{
+		hash ^= p[i];
+		hash *= FNV_PRIME_64;
+	}
+
+	*pHash = hash;
+	*pSize = size;
+
+	return S_OK;
+}
+
+std::string CFBXMeshCache::GetCachePath(const char* filename)
+{
+	std::string path = filename ? filename : "";
+	path += ".meshcache";
+	return path;
+}
+
+}	// namespace FBX_LOADER
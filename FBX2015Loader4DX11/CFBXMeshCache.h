@@ -0,0 +1,251 @@
+// *********************************************************************************************************************
+///
+/// @file 		CFBXMeshCache.h
+/// @brief		œKς݃bṼoCiLbV(FBX SDKʂɓǂݍނ)
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include <string>
+
+#include "CFBXLoader.h"
+
+namespace FBX_LOADER
+{
+
+class CMappedFile;
+
+// t@C̈ꕔ}bvr[. Unmap_Ńy[W
+class CMappedView
+{
+	friend class CMappedFile;
+
+	const BYTE*	m_pBase;		// MapViewOfFile̖߂l(蓖ėxɑĂ)
+	const BYTE*	m_pData;		// vItZbg̈ʒu
+	size_t		m_size;
+
+	CMappedView(const CMappedView&);
+	CMappedView& operator=(const CMappedView&);
+
+public:
+	CMappedView();
+	~CMappedView();
+
+	void Unmap();
+
+	const BYTE*	GetData() const { return m_pData; }
+	size_t		GetSize() const { return m_size; }
+};
+
+// ǂݍݐp̃}bvht@C
+class CMappedFile
+{
+	HANDLE		m_hFile;
+	HANDLE		m_hMapping;
+	const BYTE*	m_pData;
+	size_t		m_size;
+	uint64_t	m_fileSize;
+
+	CMappedFile(const CMappedFile&);
+	CMappedFile& operator=(const CMappedFile&);
+
+public:
+	CMappedFile();
+	~CMappedFile();
+
+	// mapWholeFilefalsȅꍇ̓}bsO, gMapViewŕKvȔ͈͂QƂ
+	HRESULT Open(const char* filename, const bool mapWholeFile = true);
+	void Close();
+
+	HRESULT MapView(const uint64_t offset, const size_t size, CMappedView* pView) const;
+
+	const BYTE*	GetData() const { return m_pData; }
+	size_t		GetSize() const { return m_size; }
+	uint64_t	GetFileSize() const { return m_fileSize; }
+};
+
+const uint32_t FBX_MESH_CACHE_MAGIC = 0x43584246;		// 'FBXC'
+const uint32_t FBX_MESH_CACHE_VERSION = 9;
+
+// _ECfbNX̊eZNV̓y[WEn߂.
+// m[hPʂŃ}bv/A}bvɗׂ̃ZNṼy[W܂Ȃ
+const uint32_t FBX_MESH_CACHE_SECTION_ALIGNMENT = 4096;
+
+// LbV쐬̏(vȂ΃LbV͎gȂ)
+enum FBX_MESH_CACHE_FLAG
+{
+	FBX_MESH_CACHE_OPTIMIZE = 0x0001,		// DirectXMeshōœKς
+};
+
+// t@C擪
+struct FBX_MESH_CACHE_HEADER
+{
+	uint32_t	magic;
+	uint32_t	version;
+	uint64_t	sourceHash;			// FBXt@C̓ẽnbVl
+	uint64_t	sourceSize;			// FBXt@C̃TCY
+	uint32_t	flags;				// FBX_MESH_CACHE_FLAG
+	uint32_t	vertexStride;		// _1̃oCg
+	uint32_t	vertexFormat;		// FBX_VERTEX_FORMAT::GetCode
+	uint32_t	nodeCount;
+	uint32_t	materialCount;		// }eAe[u̗vf(Sm[h)
+	uint32_t	subsetCount;		// TuZbge[u̗vf(Sm[h)
+	uint32_t	stringOffset;		// ̈̐擪
+	uint32_t	stringSize;
+};
+
+// m[h1.
+// wb_̒nodeCount, ă}eAe[u, TuZbge[u, ̈̏ɕ
+struct FBX_MESH_CACHE_NODE
+{
+	float		mat4x4[16];
+	float		positionScale[3];		// ʎqʒu̕p(VERTEX_DEQUANT_DATA)
+	float		positionOffset[3];
+	FBX_BOUNDS	bounds;					// m[h̃[JW̋E(ʎqÖʒu狁߂)
+
+	// ͕̈悩̃ItZbg(nullI[)
+	uint32_t	nameOffset;
+	uint32_t	parentNameOffset;
+
+	uint32_t	materialStart;			// }eAe[u̐擪
+	uint32_t	materialCount;
+	uint32_t	subsetStart;			// TuZbge[u̐擪
+	uint32_t	subsetCount;
+
+	uint32_t	vertexCount;
+	uint32_t	indexCount;
+	uint32_t	indexStride;			// CfbNX1̃oCg(24)
+	int32_t		parentId;				// em[h̔ԍ. -1
+	uint64_t	vertexOffset;			// t@C擪̃ItZbg(FBX_MESH_CACHE_SECTION_ALIGNMENTE)
+	uint64_t	indexOffset;
+};
+
+struct FBX_MESH_CACHE_MATERIAL
+{
+	uint32_t	materialType;
+	float		ambient[4];
+	float		diffuse[4];
+	float		specular[4];
+	float		emmisive[4];
+	float		shininess;
+	float		TransparencyFactor;
+	uint32_t	diffuseTextureOffset;	// Diffuse̐擪̃eNX`. ΋󕶎
+};
+
+// }eAɂ܂Ƃ߂ʂ͈̔
+struct FBX_MESH_CACHE_SUBSET
+{
+	uint32_t	startIndex;
+	uint32_t	indexCount;
+	uint32_t	materialId;				// m[h̃}eAԍ
+};
+
+// op1m[h𗭂߂Ă
+struct FBX_MESH_CACHE_SOURCE_NODE
+{
+	std::string		name;
+	std::string		parentName;
+	int32_t			parentId;
+	float			mat4x4[16];
+	float			positionScale[3];
+	float			positionOffset[3];
+	FBX_BOUNDS		bounds;
+
+	std::vector<FBX_MATERIAL_NODE>		materialArray;
+	std::vector<FBX_MESH_CACHE_SUBSET>	subsetArray;
+
+	uint32_t				vertexCount;
+	std::vector<BYTE>		vertices;
+	uint32_t				indexCount;
+	uint32_t				indexStride;
+	std::vector<BYTE>		indices;
+
+	FBX_MESH_CACHE_SOURCE_NODE()
+	{
+		parentId = -1;
+		ZeroMemory( mat4x4, sizeof(mat4x4) );
+		ZeroMemory( positionOffset, sizeof(positionOffset) );
+		positionScale[0] = positionScale[1] = positionScale[2] = 1.0f;
+		vertexCount = 0;
+		indexCount = 0;
+		indexStride = sizeof(uint32_t);
+	}
+
+	void SetNode(const FBX_MESH_NODE& fbxNode);
+	void SetVertices(const void* pVertices, const uint32_t stride, const uint32_t count);
+	void SetPositionDequant(const float* pScale, const float* pOffset);
+	void SetIndices(const void* pIndices, const uint32_t stride, const uint32_t count);
+	void AddSubset(const uint32_t startIndex, const uint32_t indexCount, const uint32_t materialId);
+};
+
+// LbVt@C̏o
+class CFBXMeshCacheWriter
+{
+	std::vector<FBX_MESH_CACHE_SOURCE_NODE*>	m_nodeArray;
+
+	CFBXMeshCacheWriter(const CFBXMeshCacheWriter&);
+	CFBXMeshCacheWriter& operator=(const CFBXMeshCacheWriter&);
+
+public:
+	CFBXMeshCacheWriter();
+	~CFBXMeshCacheWriter();
+
+	void Release();
+
+	// ߂lWriteRelease܂ŗL
+	FBX_MESH_CACHE_SOURCE_NODE* AddNode();
+
+	HRESULT Write(const char* filename, const uint64_t sourceHash, const uint64_t sourceSize,
+		const uint32_t flags, const uint32_t vertexFormat, const uint32_t vertexStride);
+};
+
+// LbVt@C̓ǂݍ.
+// _ECfbNX̓Rs[, m[hƂɃ}bvy[Ŵ܂܎QƂ
+class CFBXMeshCache
+{
+	CMappedFile						m_file;
+	CMappedView						m_headerView;		// wb_, m[he[u, ̈
+	const FBX_MESH_CACHE_HEADER*	m_pHeader;
+	const FBX_MESH_CACHE_NODE*		m_pNodes;
+	const FBX_MESH_CACHE_MATERIAL*	m_pMaterials;
+	const FBX_MESH_CACHE_SUBSET*	m_pSubsets;
+
+	HRESULT OpenFile(const char* filename);
+	bool Validate(const uint32_t vertexFormat, const uint32_t vertexStride) const;
+
+public:
+	CFBXMeshCache();
+	~CFBXMeshCache();
+
+	// wb_̓esourceHash, sourceSize, flags, vertexFormat, vertexStrideƈvȂΎs
+	HRESULT Open(const char* filename, const uint64_t sourceHash, const uint64_t sourceSize,
+		const uint32_t flags, const uint32_t vertexFormat, const uint32_t vertexStride);
+	// xCNς݃AZbgƂĊJ. FBXƂ̏ƍ͂, _tH[}bgmF
+	HRESULT OpenBaked(const char* filename, const uint32_t vertexFormat, const uint32_t vertexStride);
+	void Close();
+
+	uint32_t GetNodeCount() const { return m_pHeader ? m_pHeader->nodeCount : 0; }
+	const FBX_MESH_CACHE_NODE& GetNode(const uint32_t id) const { return m_pNodes[id]; }
+
+	const char* GetString(const uint32_t offset) const;
+	// Ԃr[GetData()D3D11_SUBRESOURCE_DATA::pSysMemɂ̂܂ܓn
+	HRESULT MapVertices(const FBX_MESH_CACHE_NODE& node, CMappedView* pView) const;
+	HRESULT MapIndices(const FBX_MESH_CACHE_NODE& node, CMappedView* pView) const;
+
+	// materialId, subsetId̓m[h̔ԍ
+	void GetMaterial(const FBX_MESH_CACHE_NODE& node, const uint32_t materialId, FBX_MATERIAL_NODE* pMaterial) const;
+	const FBX_MESH_CACHE_SUBSET& GetSubset(const FBX_MESH_CACHE_NODE& node, const uint32_t subsetId) const { return m_pSubsets[node.subsetStart + subsetId]; }
+
+	// FBXt@C̓enbVlvZ(FNV-1a 64bit)
+	static HRESULT HashFile(const char* filename, uint64_t* pHash, uint64_t* pSize);
+	// FBXt@Cׂ̗ɒuLbVt@C
+	static std::string GetCachePath(const char* filename);
+};
+
+}	// namespace FBX_LOADER
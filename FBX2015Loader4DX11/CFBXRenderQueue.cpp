@@ -0,0 +1,496 @@
+// *********************************************************************************************************************
+///
+/// @file 		CFBXRenderQueue.cpp
+/// @brief		`L[. m[h\[gL[ɕ, OƓXe[g̐ݒȂĕ`悷
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#include "CFBXRenderQueue.h"
+
+#include <algorithm>
+
+namespace FBX_LOADER
+{
+
+// \[gL[Ȃς񂾏ɕ`
+static bool CompareItem(const RENDER_QUEUE_ITEM& a, const RENDER_QUEUE_ITEM& b)
+{
+	if(a.sortKey != b.sortKey)
+		return a.sortKey < b.sortKey;
+	if(a.objectId != b.objectId)
+		return a.objectId < b.objectId;
+	return a.pSubset < b.pSubset;
+}
+
+// pNodeMatrices΂, Γǂݍ񂾎̃m[h̍s
+static const DirectX::XMFLOAT4X4& GetNodeMatrix(const CFBXRenderDX11& renderer, const DirectX::XMFLOAT4X4* pNodeMatrices, const size_t nodeId)
+{
+	if(pNodeMatrices)
+		return pNodeMatrices[nodeId];
+	return *reinterpret_cast<const DirectX::XMFLOAT4X4*>(renderer.GetNode(static_cast<int>(nodeId)).mat4x4);
+}
+
+// FlushɍŌɐݒ肵Xe[g
+struct BOUND_STATE
+{
+	ID3D11InputLayout*			pInputLayout;
+	ID3D11Buffer*				pVB;
+	UINT						vertexStride;
+	ID3D11Buffer*				pIB;
+	DXGI_FORMAT					indexFormat;
+	ID3D11Buffer*				pDequantCb;
+	uint32_t					objectId;
+	ID3D11ShaderResourceView*	pSRV;
+	ID3D11SamplerState*			pSampler;
+	ID3D11Buffer*				pMaterialCb;
+};
+
+CFBXRenderQueue::CFBXRenderQueue()
+{
+	m_pObjectCb = nullptr;
+	m_ringObjectCount = 0;
+	m_ringCursor = 0;
+	m_useOffset = false;
+	m_useNoOverwrite = false;
+	m_useCulling = true;
+
+	DirectX::XMStoreFloat4x4(&m_view, DirectX::XMMatrixIdentity());
+	DirectX::XMStoreFloat4x4(&m_projection, DirectX::XMMatrixIdentity());
+}
+
+CFBXRenderQueue::~CFBXRenderQueue()
+{
+	Release();
+}
+
+void CFBXRenderQueue::Release()
+{
+	if(m_pObjectCb)
+	{
+		m_pObjectCb->Release();
+		m_pObjectCb = nullptr;
+	}
+	m_ringObjectCount = 0;
+	m_ringCursor = 0;
+
+	m_itemArray.clear();
+	m_worldArray.clear();
+	m_sphereArray.clear();
+	m_cullNodeArray.clear();
+	m_visibleArray.clear();
+}
+
+HRESULT CFBXRenderQueue::Initialize(ID3D11Device* pd3dDevice, const uint32_t ringObjectCount)
+{
+	if(!pd3dDevice)
+		return E_FAIL;
+
+	Release();
+
+	// D3D11.1̃^CłȂΗfalsê܂
+	D3D11_FEATURE_DATA_D3D11_OPTIONS options;
+	ZeroMemory(&options, sizeof(options));
+	if(SUCCEEDED(pd3dDevice->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))))
+	{
+		m_useOffset = options.ConstantBufferOffsetting != FALSE;
+		m_useNoOverwrite = options.MapNoOverwriteOnDynamicConstantBuffer != FALSE;
+	}
+
+	return CreateObjectBuffer(pd3dDevice, m_useOffset ? std::max(ringObjectCount, 1u) : 1);
+}
+
+HRESULT CFBXRenderQueue::CreateObjectBuffer(ID3D11Device* pd3dDevice, const uint32_t objectCount)
+{
+	if(m_pObjectCb)
+	{
+		m_pObjectCb->Release();
+		m_pObjectCb = nullptr;
+	}
+
+	D3D11_BUFFER_DESC bufDesc;
+	ZeroMemory( &bufDesc, sizeof(bufDesc) );
+	bufDesc.Usage = D3D11_USAGE_DYNAMIC;
+	bufDesc.ByteWidth = sizeof(OBJECT_CONSTANT_DATA) * objectCount;
+	bufDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+	bufDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+	HRESULT hr = pd3dDevice->CreateBuffer( &bufDesc, nullptr, &m_pObjectCb );
+	if(FAILED(hr))
+	{
+		m_ringObjectCount = 0;
+		return hr;
+	}
+
+	m_ringObjectCount = objectCount;
+	m_ringCursor = 0;
+
+	return hr;
+}
+
+void CFBXRenderQueue::Begin(const DirectX::XMFLOAT4X4& view, const DirectX::XMFLOAT4X4& projection)
+{
+	m_view = view;
+	m_projection = projection;
+
+	DirectX::XMFLOAT4X4 viewProjection;
+	DirectX::XMStoreFloat4x4(&viewProjection, DirectX::XMMatrixMultiply(DirectX::XMLoadFloat4x4(&view), DirectX::XMLoadFloat4x4(&projection)));
+	m_frustum.SetMatrix(viewProjection);
+
+	// clear͗eʂĉ, Õt[ȉ̐Ȃmۂ͋NȂ
+	m_itemArray.clear();
+	m_worldArray.clear();
+	m_stats.Reset();
+}
+
+uint64_t CFBXRenderQueue::MakeSortKey(const uint8_t layer, const uint32_t layoutId, const uint32_t geometryId, const uint32_t materialId)
+{
+	// ӂꂵԍ͕т邾ŕ`挋ʂ͕ςȂ
+	return (static_cast<uint64_t>(layer) << SORT_KEY_LAYER_SHIFT)
+		| (static_cast<uint64_t>(layoutId & 0xfff) << SORT_KEY_LAYOUT_SHIFT)
+		| (static_cast<uint64_t>(geometryId & 0xfffff) << SORT_KEY_GEOMETRY_SHIFT)
+		| (static_cast<uint64_t>(materialId & 0xffffff) << SORT_KEY_MATERIAL_SHIFT);
+}
+
+void CFBXRenderQueue::SubmitNode(const CFBXRenderDX11& renderer, const size_t nodeId, const DirectX::XMFLOAT4X4& world,
+	const uint8_t layer, const uint32_t instanceCount)
+{
+	if(nodeId >= renderer.GetNodeCount())
+		return ;
+
+	const MESH_NODE& node = renderer.GetNode(static_cast<int>(nodeId));
+	SubmitNode(renderer, nodeId, *reinterpret_cast<const DirectX::XMFLOAT4X4*>(node.mat4x4), world, layer, instanceCount);
+}
+
+void CFBXRenderQueue::SubmitNode(const CFBXRenderDX11& renderer, const size_t nodeId, const DirectX::XMFLOAT4X4& nodeMatrix,
+	const DirectX::XMFLOAT4X4& world, const uint8_t layer, const uint32_t instanceCount)
+{
+	if(nodeId >= renderer.GetNodeCount() || instanceCount==0)
+		return ;
+
+	const MESH_NODE& node = renderer.GetNode(static_cast<int>(nodeId));
+	if(node.vertexCount==0 || node.m_indexBit==MESH_NODE::INDEX_NOINDEX || node.subsetArray.size()==0)
+		return ;
+
+	// m[h̍sɊ|Ă(TuZbg͋L)
+	DirectX::XMFLOAT4X4 nodeWorld;
+	const DirectX::XMMATRIX local = DirectX::XMLoadFloat4x4(&nodeMatrix);
+	DirectX::XMStoreFloat4x4(&nodeWorld, DirectX::XMMatrixMultiply(local, DirectX::XMLoadFloat4x4(&world)));
+
+	const uint32_t objectId = static_cast<uint32_t>(m_worldArray.size());
+	m_worldArray.push_back(nodeWorld);
+
+	for(size_t i=0;i<node.subsetArray.size();i++)
+	{
+		const MESH_SUBSET& subset = node.subsetArray[i];
+
+		uint32_t materialId = 0;
+		if(subset.materialId < node.materialArray.size())
+			materialId = node.materialArray[subset.materialId].sortId;
+
+		// ԍ͓ǂݍݎɃm[hƃ}eAɐU(MESH_NODE::layoutId, geometryId, MATERIAL_DATA::sortId)
+		RENDER_QUEUE_ITEM item;
+		item.sortKey = MakeSortKey(layer, node.layoutId, node.geometryId, materialId);
+		item.pNode = &node;
+		item.pSubset = &subset;
+		item.objectId = objectId;
+		item.vertexStride = renderer.GetVertexLayout().GetStride();
+		item.instanceCount = instanceCount;
+		m_itemArray.push_back(item);
+	}
+}
+
+void CFBXRenderQueue::SubmitAll(const CFBXRenderDX11& renderer, const DirectX::XMFLOAT4X4& world,
+	const uint8_t layer, const uint32_t instanceCount)
+{
+	SubmitCulled(renderer, nullptr, world, layer, instanceCount);
+}
+
+void CFBXRenderQueue::SubmitAll(const CFBXRenderDX11& renderer, const DirectX::XMFLOAT4X4* pNodeMatrices, const DirectX::XMFLOAT4X4& world,
+	const uint8_t layer, const uint32_t instanceCount)
+{
+	SubmitCulled(renderer, pNodeMatrices, world, layer, instanceCount);
+}
+
+// E̖m[h͒_̂, SubmitNodełς܂Ȃ
+void CFBXRenderQueue::SubmitCulled(const CFBXRenderDX11& renderer, const DirectX::XMFLOAT4X4* pNodeMatrices, const DirectX::XMFLOAT4X4& world,
+	const uint8_t layer, const uint32_t instanceCount)
+{
+	const size_t nodeCount = renderer.GetNodeCount();
+	if(!m_useCulling || instanceCount != 1)
+	{
+		for(size_t i=0;i<nodeCount;i++)
+		{
+			SubmitNode(renderer, i, GetNodeMatrix(renderer, pNodeMatrices, i), world, layer, instanceCount);
+		}
+		return ;
+	}
+
+	const DirectX::XMMATRIX worldMatrix = DirectX::XMLoadFloat4x4(&world);
+	m_sphereArray.clear();
+	m_cullNodeArray.clear();
+	for(size_t i=0;i<nodeCount;i++)
+	{
+		const FBX_BOUNDS& bounds = renderer.GetNodeBounds(i);
+		if(!bounds.IsValid())
+			continue;
+
+		const DirectX::XMMATRIX nodeMatrix = DirectX::XMLoadFloat4x4(&GetNodeMatrix(renderer, pNodeMatrices, i));
+
+		DirectX::XMFLOAT4A sphere;
+		CFBXFrustum::TransformSphere(bounds, DirectX::XMMatrixMultiply(nodeMatrix, worldMatrix), &sphere);
+		m_sphereArray.push_back(sphere);
+		m_cullNodeArray.push_back(static_cast<uint32_t>(i));
+	}
+
+	const uint32_t cullCount = static_cast<uint32_t>(m_sphereArray.size());
+	if(cullCount==0)
+		return ;
+
+	m_visibleArray.resize(cullCount);
+	const uint32_t visibleCount = m_frustum.CullSpheres(&m_sphereArray[0], cullCount, &m_visibleArray[0]);
+	m_stats.culledNodeCount += cullCount - visibleCount;
+
+	for(uint32_t v=0;v<visibleCount;v++)
+	{
+		const uint32_t nodeId = m_cullNodeArray[m_visibleArray[v]];
+		SubmitNode(renderer, nodeId, GetNodeMatrix(renderer, pNodeMatrices, nodeId), world, layer, instanceCount);
+	}
+}
+
+void CFBXRenderQueue::BuildObjectConstant(const uint32_t objectId, OBJECT_CONSTANT_DATA* pData) const
+{
+	const DirectX::XMMATRIX world = DirectX::XMLoadFloat4x4(&m_worldArray[objectId]);
+	const DirectX::XMMATRIX view = DirectX::XMLoadFloat4x4(&m_view);
+	const DirectX::XMMATRIX projection = DirectX::XMLoadFloat4x4(&m_projection);
+
+	pData->world = m_worldArray[objectId];
+	pData->view = m_view;
+	pData->projection = m_projection;
+	DirectX::XMStoreFloat4x4(&pData->wvp, DirectX::XMMatrixTranspose(world * view * projection));
+}
+
+HRESULT CFBXRenderQueue::WriteObjectConstants(ID3D11DeviceContext* pContext, uint32_t* pBaseObject)
+{
+	HRESULT hr = S_OK;
+	const uint32_t objectCount = static_cast<uint32_t>(m_worldArray.size());
+
+	// 1Flush肫Ȃ蒼. ȍ~͂̃TCYŉ
+	if(objectCount > m_ringObjectCount)
+	{
+		ID3D11Device* pd3dDevice = nullptr;
+		pContext->GetDevice(&pd3dDevice);
+		hr = CreateObjectBuffer(pd3dDevice, std::max(objectCount, m_ringObjectCount * 2));
+		pd3dDevice->Release();
+		if(FAILED(hr))
+			return hr;
+	}
+
+	// cɎ܂GPUǂłÖ̗c܂܌ɑ
+	D3D11_MAP mapType = D3D11_MAP_WRITE_NO_OVERWRITE;
+	if(!m_useNoOverwrite || m_ringCursor + objectCount > m_ringObjectCount)
+	{
+		mapType = D3D11_MAP_WRITE_DISCARD;
+		m_ringCursor = 0;
+	}
+
+	D3D11_MAPPED_SUBRESOURCE mapped;
+	hr = pContext->Map(m_pObjectCb, 0, mapType, 0, &mapped);
+	if(FAILED(hr))
+		return hr;
+	m_stats.mapCount++;
+
+	OBJECT_CONSTANT_DATA* pData = static_cast<OBJECT_CONSTANT_DATA*>(mapped.pData) + m_ringCursor;
+	for(uint32_t i=0;i<objectCount;i++)
+		BuildObjectConstant(i, &pData[i]);
+
+	pContext->Unmap(m_pObjectCb, 0);
+
+	*pBaseObject = m_ringCursor;
+	m_ringCursor += objectCount;
+
+	return hr;
+}
+
+HRESULT CFBXRenderQueue::WriteObjectConstant(ID3D11DeviceContext* pContext, const uint32_t objectId)
+{
+	D3D11_MAPPED_SUBRESOURCE mapped;
+	HRESULT hr = pContext->Map(m_pObjectCb, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+	if(FAILED(hr))
+		return hr;
+	m_stats.mapCount++;
+
+	BuildObjectConstant(objectId, static_cast<OBJECT_CONSTANT_DATA*>(mapped.pData));
+	pContext->Unmap(m_pObjectCb, 0);
+
+	return hr;
+}
+
+HRESULT CFBXRenderQueue::Flush(ID3D11DeviceContext* pContext)
+{
+	if(!pContext || !m_pObjectCb)
+		return E_FAIL;
+
+	if(m_itemArray.size()==0)
+		return S_OK;
+
+	std::sort(m_itemArray.begin(), m_itemArray.end(), CompareItem);
+
+	HRESULT hr = S_OK;
+
+	ID3D11DeviceContext1* pContext1 = nullptr;
+	if(m_useOffset)
+		pContext->QueryInterface(__uuidof(ID3D11DeviceContext1), reinterpret_cast<void**>(&pContext1));
+
+	uint32_t baseObject = 0;
+	if(pContext1)
+	{
+		hr = WriteObjectConstants(pContext, &baseObject);
+		if(FAILED(hr))
+		{
+			pContext1->Release();
+			return hr;
+		}
+	}
+
+	pContext->IASetPrimitiveTopology( D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST );
+	m_stats.topologyBindCount++;
+
+	// ŏ1͑SĐݒ肷
+	BOUND_STATE bound;
+	ZeroMemory(&bound, sizeof(bound));
+	bool bindAll = true;
+
+	for(size_t i=0;i<m_itemArray.size();i++)
+	{
+		const RENDER_QUEUE_ITEM& item = m_itemArray[i];
+		const MESH_NODE& node = *item.pNode;
+		const MESH_SUBSET& subset = *item.pSubset;
+
+		if(bindAll || bound.pInputLayout != node.m_pInputLayout)
+		{
+			bound.pInputLayout = node.m_pInputLayout;
+			pContext->IASetInputLayout(bound.pInputLayout);
+			m_stats.inputLayoutBindCount++;
+		}
+		else
+			m_stats.skippedBindCount++;
+
+		// ꊇAbv[hm[h͓obt@ItZbg0Ŏg, ʒuDrawStart/BaseŎw肷
+		if(bindAll || bound.pVB != node.m_pVB || bound.vertexStride != item.vertexStride)
+		{
+			bound.pVB = node.m_pVB;
+			bound.vertexStride = item.vertexStride;
+			UINT offset = 0;
+			pContext->IASetVertexBuffers(0, 1, &bound.pVB, &bound.vertexStride, &offset);
+			m_stats.vertexBufferBindCount++;
+		}
+		else
+			m_stats.skippedBindCount++;
+
+		const DXGI_FORMAT indexFormat = node.m_indexBit==MESH_NODE::INDEX_32BIT ? DXGI_FORMAT_R32_UINT : DXGI_FORMAT_R16_UINT;
+		if(bindAll || bound.pIB != node.m_pIB || bound.indexFormat != indexFormat)
+		{
+			bound.pIB = node.m_pIB;
+			bound.indexFormat = indexFormat;
+			pContext->IASetIndexBuffer(bound.pIB, bound.indexFormat, 0);
+			m_stats.indexBufferBindCount++;
+		}
+		else
+			m_stats.skippedBindCount++;
+
+		if(bindAll || bound.pDequantCb != node.m_pDequantCb)
+		{
+			bound.pDequantCb = node.m_pDequantCb;
+			pContext->VSSetConstantBuffers(1, 1, &bound.pDequantCb);
+			m_stats.constantBufferBindCount++;
+		}
+		else
+			m_stats.skippedBindCount++;
+
+		if(bindAll || bound.objectId != item.objectId)
+		{
+			bound.objectId = item.objectId;
+			if(pContext1)
+			{
+				UINT firstConstant = (baseObject + item.objectId) * OBJECT_CONSTANT_COUNT;
+				UINT constantCount = OBJECT_CONSTANT_COUNT;
+				pContext1->VSSetConstantBuffers1(0, 1, &m_pObjectCb, &firstConstant, &constantCount);
+				m_stats.constantBufferBindCount++;
+			}
+			else
+			{
+				hr = WriteObjectConstant(pContext, item.objectId);
+				if(FAILED(hr))
+					break;
+				if(bindAll)
+				{
+					pContext->VSSetConstantBuffers(0, 1, &m_pObjectCb);
+					m_stats.constantBufferBindCount++;
+				}
+			}
+		}
+		else
+			m_stats.skippedBindCount++;
+
+		// }eASRV, Tv[, 萔obt@ʁXɔׂ(LĂ镨͐ݒ肵Ȃ)
+		ID3D11ShaderResourceView*	pSRV = nullptr;
+		ID3D11SamplerState*			pSampler = nullptr;
+		ID3D11Buffer*				pMaterialCb = nullptr;
+		if(subset.materialId < node.materialArray.size())
+		{
+			const MATERIAL_DATA& material = node.materialArray[subset.materialId];
+			pSRV = material.pSRV;
+			pSampler = material.pSampler;
+			pMaterialCb = material.pMaterialCb;
+		}
+
+		if(bindAll || bound.pSRV != pSRV)
+		{
+			bound.pSRV = pSRV;
+			pContext->PSSetShaderResources(0, 1, &bound.pSRV);
+			m_stats.materialBindCount++;
+		}
+		else
+			m_stats.skippedBindCount++;
+
+		if(bindAll || bound.pSampler != pSampler)
+		{
+			bound.pSampler = pSampler;
+			pContext->PSSetSamplers(0, 1, &bound.pSampler);
+			m_stats.materialBindCount++;
+		}
+		else
+			m_stats.skippedBindCount++;
+
+		if(bindAll || bound.pMaterialCb != pMaterialCb)
+		{
+			bound.pMaterialCb = pMaterialCb;
+			pContext->PSSetConstantBuffers(0, 1, &bound.pMaterialCb);
+			m_stats.materialBindCount++;
+		}
+		else
+			m_stats.skippedBindCount++;
+
+		bindAll = false;
+
+		const UINT startIndex = node.indexStart + subset.startIndex;
+		const INT baseVertex = static_cast<INT>(node.vertexStart);
+		if(item.instanceCount==1)
+			pContext->DrawIndexed(subset.indexCount, startIndex, baseVertex);
+		else
+			pContext->DrawIndexedInstanced(subset.indexCount, item.instanceCount, startIndex, baseVertex, 0);
+		m_stats.drawCount++;
+	}
+
+	m_stats.itemCount += static_cast<uint32_t>(m_itemArray.size());
+
+	if(pContext1)
+		pContext1->Release();
+
+	return hr;
+}
+
+}	// namespace FBX_LOADER
@@ -0,0 +1,171 @@
+// *********************************************************************************************************************
+///
+/// @file 		CFBXRenderQueue.h
+/// @brief		`L[. m[h\[gL[ɕ, OƓXe[g̐ݒȂĕ`悷
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#pragma once
+
+#include "CFBXRendererDX11.h"
+#include "CFBXFrustum.h"
+
+#include <d3d11_1.h>
+
+namespace FBX_LOADER
+{
+
+// IuWFNg̒萔. simpleRenderVS.hlslcbGlobal(b0)Ɠ.
+// world, view, projection͂̂܂(CX^VOpVF[_VF[_őgݗĂ), wvp]uς.
+// 傤256byte(VSSetConstantBuffers1̃ItZbgP)
+struct OBJECT_CONSTANT_DATA
+{
+	DirectX::XMFLOAT4X4	world;
+	DirectX::XMFLOAT4X4	view;
+	DirectX::XMFLOAT4X4	projection;
+	DirectX::XMFLOAT4X4	wvp;
+};
+
+// L[ɐς񂾃TuZbg1̕`
+struct RENDER_QUEUE_ITEM
+{
+	uint64_t			sortKey;
+	const MESH_NODE*	pNode;
+	const MESH_SUBSET*	pSubset;
+	uint32_t			objectId;		// 萔([hs)̔ԍ. m[h̃TuZbg͋L
+	uint32_t			vertexStride;
+	uint32_t			instanceCount;
+};
+
+// FlushŎۂɌĂAPỈ(Begin0ɖ߂)
+struct RENDER_QUEUE_STATS
+{
+	uint32_t	itemCount;
+	uint32_t	culledNodeCount;			// SubmitAllŎ̊Om[h
+	uint32_t	drawCount;
+	uint32_t	topologyBindCount;
+	uint32_t	inputLayoutBindCount;
+	uint32_t	vertexBufferBindCount;
+	uint32_t	indexBufferBindCount;
+	uint32_t	constantBufferBindCount;	// VSb0(IuWFNg萔), b1(_̕p)
+	uint32_t	materialBindCount;			// PSSRV, Tv[, 萔obt@(1ɂ1)
+	uint32_t	mapCount;
+	uint32_t	skippedBindCount;			// OƓ̂ŏȂݒ
+
+	RENDER_QUEUE_STATS()
+	{
+		Reset();
+	}
+
+	void Reset()
+	{
+		itemCount = 0;
+		culledNodeCount = 0;
+		drawCount = 0;
+		topologyBindCount = 0;
+		inputLayoutBindCount = 0;
+		vertexBufferBindCount = 0;
+		indexBufferBindCount = 0;
+		constantBufferBindCount = 0;
+		materialBindCount = 0;
+		mapCount = 0;
+		skippedBindCount = 0;
+	}
+};
+
+// Begin  Submit*  Flush 𖈃t[s.
+// Flush̓VF[_ȊO(IA, VSb0/b1, PSt0/s0/b0)ݒ肷. VF[_VSSRV͌ĂяoŐݒ肵Ă.
+// IuWFNg萔1̓I萔obt@Oɂ, ItZbgςĎQƂ(D3D11.1).
+// ItZbggȂł̓IuWFNgςxMap(DISCARD)
+class CFBXRenderQueue
+{
+public:
+	enum
+	{
+		OBJECT_CONSTANT_COUNT = sizeof(OBJECT_CONSTANT_DATA) / 16,		// 萔(float4)̐
+		DEFAULT_RING_OBJECT_COUNT = 1024,
+	};
+
+	// \[gL[̕(ʂ). ʂقǐ؂ւdXe[g
+	enum
+	{
+		SORT_KEY_LAYER_SHIFT = 56,			// 8bit	Ăяo̕`揇(sȂ)
+		SORT_KEY_LAYOUT_SHIFT = 44,			// 12bit	̓CAEg
+		SORT_KEY_GEOMETRY_SHIFT = 24,		// 20bit	_ECfbNXobt@
+		SORT_KEY_MATERIAL_SHIFT = 0,		// 24bit	}eA
+	};
+
+private:
+	ID3D11Buffer*		m_pObjectCb;
+	uint32_t			m_ringObjectCount;		// m_pObjectCbɓIuWFNg
+	uint32_t			m_ringCursor;			// ɏރIuWFNg̈ʒu
+	bool				m_useOffset;			// ConstantBufferOffsetting
+	bool				m_useNoOverwrite;		// MapNoOverwriteOnDynamicConstantBuffer
+
+	DirectX::XMFLOAT4X4	m_view;
+	DirectX::XMFLOAT4X4	m_projection;
+
+	bool				m_useCulling;
+	CFBXFrustum			m_frustum;				// Beginview * projection([hW)
+	FBX_SPHERE_STREAM	m_sphereArray;			// SubmitAll̍Ɨ̈. Êm[h̃[hW̋E
+	std::vector<uint32_t>	m_cullNodeArray;	// m_sphereArrayƓт̃m[hԍ
+	std::vector<uint32_t>	m_visibleArray;		// JOʂm_sphereArray̓Y
+
+	std::vector<RENDER_QUEUE_ITEM>		m_itemArray;
+	std::vector<DirectX::XMFLOAT4X4>	m_worldArray;		// objectId. m[hs|[hs
+
+	RENDER_QUEUE_STATS	m_stats;
+
+	CFBXRenderQueue(const CFBXRenderQueue&);
+	CFBXRenderQueue& operator=(const CFBXRenderQueue&);
+
+	HRESULT CreateObjectBuffer(ID3D11Device* pd3dDevice, const uint32_t objectCount);
+	void BuildObjectConstant(const uint32_t objectId, OBJECT_CONSTANT_DATA* pData) const;
+	void SubmitNode(const CFBXRenderDX11& renderer, const size_t nodeId, const DirectX::XMFLOAT4X4& nodeMatrix,
+		const DirectX::XMFLOAT4X4& world, const uint8_t layer, const uint32_t instanceCount);
+	// pNodeMatricesnullptrȂm[h̍sg
+	void SubmitCulled(const CFBXRenderDX11& renderer, const DirectX::XMFLOAT4X4* pNodeMatrices, const DirectX::XMFLOAT4X4& world,
+		const uint8_t layer, const uint32_t instanceCount);
+	// SIuWFNg̒萔Oɏ, 擪̈ʒupBaseObjectɕԂ
+	HRESULT WriteObjectConstants(ID3D11DeviceContext* pContext, uint32_t* pBaseObject);
+	// ItZbggȂp. 1IuWFNg
+	HRESULT WriteObjectConstant(ID3D11DeviceContext* pContext, const uint32_t objectId);
+
+public:
+	CFBXRenderQueue();
+	~CFBXRenderQueue();
+
+	HRESULT Initialize(ID3D11Device* pd3dDevice, const uint32_t ringObjectCount = DEFAULT_RING_OBJECT_COUNT);
+	void Release();
+
+	// ς񂾕`Ɠv̂Ă, ̃t[̃r[Eˉesݒ肷
+	void Begin(const DirectX::XMFLOAT4X4& view, const DirectX::XMFLOAT4X4& projection);
+
+	// m[h̃TuZbgSĐς. worldɂ̓m[h̍s(mat4x4)|.
+	// instanceCount1ȊOȂDrawIndexedInstancedŕ`悷.
+	// SubmitAll̓JOLȂ, Sm[h̋E܂Ƃ߂ĎƔׂČm[hς
+	// (CX^VO̓CX^ẌʒuȂ̂ŃJOȂ. CFBXInstanceBufferg)
+	void SubmitNode(const CFBXRenderDX11& renderer, const size_t nodeId, const DirectX::XMFLOAT4X4& world,
+		const uint8_t layer = 0, const uint32_t instanceCount = 1);
+	void SubmitAll(const CFBXRenderDX11& renderer, const DirectX::XMFLOAT4X4& world,
+		const uint8_t layer = 0, const uint32_t instanceCount = 1);
+	// m[h̍s̑pNodeMatrices[m[hԍ]g(CFBXAnimation::SamplěʂȂ)
+	void SubmitAll(const CFBXRenderDX11& renderer, const DirectX::XMFLOAT4X4* pNodeMatrices, const DirectX::XMFLOAT4X4& world,
+		const uint8_t layer = 0, const uint32_t instanceCount = 1);
+
+	void SetCulling(const bool enable){ m_useCulling = enable; }
+	bool IsCulling() const { return m_useCulling; }
+
+	// \[gĕ`悷. L[͋ɂȂȂ̂, eʂ̃pXłxFlushł
+	HRESULT Flush(ID3D11DeviceContext* pContext);
+
+	const RENDER_QUEUE_STATS& GetStats() const { return m_stats; }
+	size_t GetItemCount() const { return m_itemArray.size(); }
+
+	static uint64_t MakeSortKey(const uint8_t layer, const uint32_t layoutId, const uint32_t geometryId, const uint32_t materialId);
+};
+
+}	// namespace FBX_LOADER
@@ -13,13 +13,33 @@
 #include "DDSTextureLoader.h"
 #include < locale.h >
 #include <DirectXMesh.h>
+#include <atomic>
 
 namespace FBX_LOADER
 {
 
+// \[gL[p̔ԍ. SĂCFBXRenderDX11ŋL, ԍxUȂ(0͖)
+static std::atomic<uint32_t> s_sortIdSerial(0);
+
+static uint32_t NewSortId()
+{
+	uint32_t id = ++s_sortIdSerial;
+	if(id == 0)
+		id = ++s_sortIdSerial;
+	return id;
+}
+
 CFBXRenderDX11::CFBXRenderDX11()
 {
 	m_pFBX = nullptr;
+	m_loadThreadCount = 1;
+	m_animationSampleRate = 30.0f;
+	m_animationTolerance = 0.01f;
+	m_useMeshCache = false;
+	m_packedUpload = false;
+	m_asyncTextureLoad = false;
+	m_pendingTextureCount = 0;
+	m_stateCacheHitBase = 0;
 }
 
 CFBXRenderDX11::~CFBXRenderDX11()
@@ -34,6 +54,14 @@ void CFBXRenderDX11::Release()
 		m_meshNodeArray[i].Release();
 	}
 	m_meshNodeArray.clear();
+	m_pendingTextureCount = 0;
+
+	// CFBXRenderDX11gĂȂ, }eÃeNX`LbV
+	if(m_pStateCache)
+		m_pStateCache->GetTextureCache().Trim();
+
+	m_packedVertices.clear();
+	m_packedIndices.clear();
 
 	if(m_pFBX)
 	{
@@ -49,20 +77,327 @@ HRESULT CFBXRenderDX11::LoadFBX(const char* filename, ID3D11Device*	pd3dDevice,
 
 	HRESULT hr = S_OK;
 
+	m_loadStats.Reset();
+	m_sourceDirectory = CFBXTextureCache::GetDirectory(filename);
+	hr = AcquireStateCache(pd3dDevice);
+	if(FAILED(hr))
+		return hr;
+
+	// LbVFBXƈvĂFBX SDKg킸ɓǂݍ
+	CFBXStageTimer cacheReadTimer(&m_loadStats, FBX_LOAD_STAGE_MESH_CACHE_READ);
+	const uint32_t cacheFlags = isOptimize ? FBX_MESH_CACHE_OPTIMIZE : 0;
+	const std::string cachePath = CFBXMeshCache::GetCachePath(filename);
+	uint64_t sourceHash = 0;
+	uint64_t sourceSize = 0;
+	bool useMeshCache = m_useMeshCache && SUCCEEDED(CFBXMeshCache::HashFile(filename, &sourceHash, &sourceSize));
+
+	if(useMeshCache)
+	{
+		CFBXMeshCache cache;
+		if(SUCCEEDED(cache.Open(cachePath.c_str(), sourceHash, sourceSize, cacheFlags, m_vertexLayout.GetFormat().GetCode(), m_vertexLayout.GetStride())))
+		{
+			hr = CreateNodesFromCache(pd3dDevice, cache);
+			if(SUCCEEDED(hr))
+			{
+				cacheReadTimer.Stop();
+				m_loadStats.meshCacheHit = 1;
+				CountBufferStats();
+				return hr;
+			}
+
+			// sʏ̓ǂݍ݂蒼
+			Release();
+		}
+	}
+	cacheReadTimer.Stop();
+
 	m_pFBX = new CFBXLoader;
+	m_pFBX->SetThreadCount(m_loadThreadCount);
+	m_pFBX->SetAnimationSampleRate(m_animationSampleRate);
+	m_pFBX->SetAnimationCompression(m_animationTolerance);
 	hr = m_pFBX->LoadFBX(filename, CFBXLoader::eAXIS_OPENGL);
+	m_loadStats.Add(m_pFBX->GetLoadStats());
 	if(FAILED(hr))
+	{
+		// r܂œǂ񂾃V[̓ǂݍ݂܂ŎȂ悤̂Ă(v͂̂܂܎c)
+		Release();
 		return hr;
+	}
 
-	hr = CreateNodes(pd3dDevice, pd3dContext, isOptimize);
+	// Ă񂾃Aj[VƃXL({[)̓LbVɓȂ̂, LbVǂނGetAnimation, GetSourceNodegȂ.
+	// V[̓LbVɖFBXǂݍ(ȑÕo[ŴΏ)
+	const CFBXAnimation* pAnimation = m_pFBX->GetAnimation();
+	if(useMeshCache && ((pAnimation && pAnimation->IsAnimated()) || m_loadStats.skinnedNodeCount > 0))
+	{
+		useMeshCache = false;
+		DeleteFileA(cachePath.c_str());
+	}
+
+	CFBXStageTimer createTimer(&m_loadStats, FBX_LOAD_STAGE_CREATE_NODES);
+	CFBXMeshCacheWriter cacheWriter;
+	hr = CreateNodes(pd3dDevice, pd3dContext, isOptimize, useMeshCache ? &cacheWriter : nullptr);
+	createTimer.Stop();
 	if(FAILED(hr))
+	{
+		// r܂ł̃m[h̓LbVɏoɎ̂Ă
+		Release();
 		return hr;
+	}
+
+	CountBufferStats();
+
+	// LbVȂĂǂݍݎ̂͐
+	if(useMeshCache)
+	{
+		CFBXStageTimer cacheWriteTimer(&m_loadStats, FBX_LOAD_STAGE_MESH_CACHE_WRITE);
+		cacheWriter.Write(cachePath.c_str(), sourceHash, sourceSize, cacheFlags, m_vertexLayout.GetFormat().GetCode(), m_vertexLayout.GetStride());
+	}
 
 	return hr;
 }
 
+HRESULT CFBXRenderDX11::LoadBakedMesh(const char* filename, ID3D11Device*	pd3dDevice)
+{
+	if(!filename || !pd3dDevice)
+		return E_FAIL;
+
+	m_loadStats.Reset();
+	m_sourceDirectory = CFBXTextureCache::GetDirectory(filename);
+	HRESULT hr = AcquireStateCache(pd3dDevice);
+	if(FAILED(hr))
+		return hr;
+
+	CFBXStageTimer cacheReadTimer(&m_loadStats, FBX_LOAD_STAGE_MESH_CACHE_READ);
+
+	CFBXMeshCache cache;
+	hr = cache.OpenBaked(filename, m_vertexLayout.GetFormat().GetCode(), m_vertexLayout.GetStride());
+	if(FAILED(hr))
+		return hr;
+
+	hr = CreateNodesFromCache(pd3dDevice, cache);
+	if(FAILED(hr))
+	{
+		Release();
+		return hr;
+	}
+	cacheReadTimer.Stop();
+
+	m_loadStats.meshCacheHit = 1;
+	CountBufferStats();
+
+	return hr;
+}
+
+// foCX̑̃fƋLLbVĂ
+HRESULT CFBXRenderDX11::AcquireStateCache(ID3D11Device* pd3dDevice)
+{
+	if(!m_pStateCache || m_pStateCache->GetDevice() != pd3dDevice)
+		m_pStateCache = CFBXStateCache::Get(pd3dDevice);
+	if(!m_pStateCache)
+		return E_FAIL;
+
+	m_stateCacheHitBase = m_pStateCache->GetHitCount();
+	m_textureStatsBase = m_pStateCache->GetTextureCache().GetStats();
+	return S_OK;
+}
+
+// 쐬obt@̒_ECfbNXƃTCYWv
+void CFBXRenderDX11::CountBufferStats()
+{
+	m_loadStats.vertexStride = m_vertexLayout.GetStride();
+
+	// LXe[g̐̓fĂ, g̈Ⴄ}eA(ʎqʒuȂ狫ËႤm[h)ΑȂ
+	m_loadStats.sharedStateCount = static_cast<uint32_t>(m_pStateCache->GetSamplerCount() + m_pStateCache->GetMaterialBufferCount()
+		+ m_pStateCache->GetDequantBufferCount() + m_pStateCache->GetInputLayoutCount());
+	m_loadStats.sharedStateHitCount = m_pStateCache->GetHitCount() - m_stateCacheHitBase;
+
+	// foCXŕsēǂݍł, ̕
+	const FBX_TEXTURE_CACHE_STATS textureStats = m_pStateCache->GetTextureCache().GetStats();
+	m_loadStats.textureHitCount = (textureStats.pathHitCount + textureStats.contentHitCount) - (m_textureStatsBase.pathHitCount + m_textureStatsBase.contentHitCount);
+	m_loadStats.textureLoadCount = textureStats.loadCount - m_textureStatsBase.loadCount;
+	m_loadStats.textureFailCount = textureStats.failCount - m_textureStatsBase.failCount;
+	m_loadStats.textureBytesRead = textureStats.loadedBytes - m_textureStatsBase.loadedBytes;
+	m_loadStats.texturePendingCount = static_cast<uint32_t>(m_pendingTextureCount);
+
+	for(size_t i=0;i<m_meshNodeArray.size();i++)
+	{
+		const MESH_NODE& meshNode = m_meshNodeArray[i];
+
+		m_loadStats.bufferVertexCount += meshNode.vertexCount;
+		m_loadStats.bufferIndexCount += meshNode.indexCount;
+		m_loadStats.bufferBytes += static_cast<uint64_t>(meshNode.vertexCount) * m_vertexLayout.GetStride();
+		if(meshNode.m_indexBit == MESH_NODE::INDEX_16BIT)
+		{
+			m_loadStats.bufferBytes += static_cast<uint64_t>(meshNode.indexCount) * sizeof(uint16_t);
+			m_loadStats.indexBytesSaved += static_cast<uint64_t>(meshNode.indexCount) * (sizeof(uint32_t) - sizeof(uint16_t));
+		}
+		else if(meshNode.m_indexBit == MESH_NODE::INDEX_32BIT)
+			m_loadStats.bufferBytes += static_cast<uint64_t>(meshNode.indexCount) * sizeof(uint32_t);
+	}
+}
+
 //
-HRESULT CFBXRenderDX11::CreateNodes(ID3D11Device*	pd3dDevice, ID3D11DeviceContext*	pd3dContext, const bool isOptimize)
+HRESULT CFBXRenderDX11::CreateNodesFromCache(ID3D11Device*	pd3dDevice, const CFBXMeshCache& cache)
+{
+	if(!pd3dDevice)
+		return E_FAIL;
+
+	HRESULT hr = S_OK;
+
+	const uint32_t nodeCount = cache.GetNodeCount();
+	if(nodeCount==0)
+		return E_FAIL;
+
+	m_meshNodeArray.resize(nodeCount);
+
+	for(uint32_t i=0;i<nodeCount;i++)
+	{
+		MESH_NODE& meshNode = m_meshNodeArray[i];
+		const FBX_MESH_CACHE_NODE& cacheNode = cache.GetNode(i);
+
+		// _ECfbNX̓}bvy[W璼ڃobt@, I炷Ɏ.
+		// Ƀ}bv̂̓obt@1
+		meshNode.vertexCount = cacheNode.vertexCount;
+		if(meshNode.vertexCount > 0)
+		{
+			CMappedView view;
+			hr = cache.MapVertices(cacheNode, &view);
+			if(FAILED(hr))
+				return hr;
+
+			hr = UploadVertices(pd3dDevice, meshNode, view.GetData(), meshNode.vertexCount);
+			if(FAILED(hr))
+				return hr;
+
+			// ʎqς݂Ȃ̂ŕp̒萔߂
+			meshNode.dequant = VERTEX_DEQUANT_DATA();
+			meshNode.dequant.positionScale = DirectX::XMFLOAT4(cacheNode.positionScale[0], cacheNode.positionScale[1], cacheNode.positionScale[2], 0.0f);
+			meshNode.dequant.positionOffset = DirectX::XMFLOAT4(cacheNode.positionOffset[0], cacheNode.positionOffset[1], cacheNode.positionOffset[2], 0.0f);
+			hr = CreateDequantBuffer(pd3dDevice, meshNode);
+			if(FAILED(hr))
+				return hr;
+		}
+
+		// CfbNX̕͏oɌ߂̂̂܂܎g
+		meshNode.indexCount = cacheNode.indexCount;
+		meshNode.m_indexBit = MESH_NODE::INDEX_NOINDEX;
+		if(meshNode.indexCount > 0)
+		{
+			meshNode.m_indexBit = cacheNode.indexStride==sizeof(uint16_t) ? MESH_NODE::INDEX_16BIT : MESH_NODE::INDEX_32BIT;
+
+			CMappedView view;
+			hr = cache.MapIndices(cacheNode, &view);
+			if(FAILED(hr))
+				return hr;
+
+			hr = UploadIndices(pd3dDevice, meshNode, view.GetData(), cacheNode.indexStride, meshNode.indexCount);
+			if(FAILED(hr))
+				return hr;
+		}
+
+		memcpy( meshNode.mat4x4, cacheNode.mat4x4, sizeof(float)*16 );
+		meshNode.bounds = cacheNode.bounds;
+		meshNode.parentId = cacheNode.parentId;
+
+		// }eAƃTuZbg
+		meshNode.materialArray.resize(cacheNode.materialCount);
+		for(uint32_t m=0;m<cacheNode.materialCount;m++)
+		{
+			FBX_MATERIAL_NODE fbxMaterial;
+			cache.GetMaterial(cacheNode, m, &fbxMaterial);
+			hr = MaterialConstruction(pd3dDevice, fbxMaterial, meshNode.materialArray[m]);
+			if(FAILED(hr))
+				return hr;
+		}
+
+		meshNode.subsetArray.resize(cacheNode.subsetCount);
+		for(uint32_t s=0;s<cacheNode.subsetCount;s++)
+		{
+			const FBX_MESH_CACHE_SUBSET& subset = cache.GetSubset(cacheNode, s);
+			meshNode.subsetArray[s].startIndex = subset.startIndex;
+			meshNode.subsetArray[s].indexCount = subset.indexCount;
+			meshNode.subsetArray[s].materialId = subset.materialId;
+		}
+	}
+
+	if(m_packedUpload)
+		hr = FlushPackedUpload(pd3dDevice);
+
+	if(SUCCEEDED(hr))
+		AssignSortIds();
+
+	return hr;
+}
+
+// m[h̃obt@ƃ}eAɃ\[gL[p̔ԍU.
+// |C^ԍɂ, obt@ƓAhXɍꂽʂ̃obt@Âԍpł܂
+void CFBXRenderDX11::AssignSortIds()
+{
+	const uint32_t packedId = m_packedUpload ? NewSortId() : 0;
+
+	for(size_t i=0;i<m_meshNodeArray.size();i++)
+	{
+		MESH_NODE& meshNode = m_meshNodeArray[i];
+		meshNode.geometryId = meshNode.m_pVB ? (m_packedUpload ? packedId : NewSortId()) : 0;
+
+		for(size_t m=0;m<meshNode.materialArray.size();m++)
+			meshNode.materialArray[m].sortId = NewSortId();
+	}
+}
+
+static uint32_t GetMaxIndex(const uint32_t* pIndices, const size_t indexCount)
+{
+	uint32_t maxIndex = 0;
+	for(size_t i=0;i<indexCount;i++)
+		maxIndex = std::max(maxIndex, pIndices[i]);
+	return maxIndex;
+}
+
+// Ăяoōől16bitɎ܂邱ƂmFĂ
+static void NarrowIndices(const uint32_t* pIndices, const size_t indexCount, uint16_t* pIndices16)
+{
+	for(size_t i=0;i<indexCount;i++)
+		pIndices16[i] = static_cast<uint16_t>(pIndices[i]);
+}
+
+// ʖ̃}eAԍ. }eA͈̔͊O0Ԃɂ܂Ƃ߂
+static void GetFaceAttributes(const FBX_MESH_NODE& fbxNode, const size_t nFaces, uint32_t* pAttributes)
+{
+	memset(pAttributes, 0, sizeof(uint32_t) * nFaces);
+
+	const size_t materialCount = fbxNode.m_materialArray.size();
+	const size_t count = std::min(nFaces, fbxNode.materialIndexArray.size());
+	for(size_t i=0;i<count;i++)
+	{
+		const uint32_t materialId = fbxNode.materialIndexArray[i];
+		pAttributes[i] = materialId < materialCount ? materialId : 0;
+	}
+}
+
+// }eAɕבւς݂̖ʂTuZbg
+static void BuildSubsets(const uint32_t* pAttributes, const size_t nFaces, MESH_NODE& meshNode, FBX_MESH_CACHE_SOURCE_NODE* pCacheNode)
+{
+	meshNode.subsetArray.clear();
+	if(nFaces==0)
+		return ;
+
+	const std::vector<std::pair<size_t,size_t>> subsets = DirectX::ComputeSubsets(pAttributes, nFaces);
+	meshNode.subsetArray.reserve(subsets.size());
+	for(size_t i=0;i<subsets.size();i++)
+	{
+		MESH_SUBSET subset;
+		subset.startIndex = static_cast<uint32_t>(subsets[i].first * 3);
+		subset.indexCount = static_cast<uint32_t>(subsets[i].second * 3);
+		subset.materialId = pAttributes[subsets[i].first];
+		meshNode.subsetArray.push_back(subset);
+
+		if(pCacheNode)
+			pCacheNode->AddSubset(subset.startIndex, subset.indexCount, subset.materialId);
+	}
+}
+
+//
+HRESULT CFBXRenderDX11::CreateNodes(ID3D11Device*	pd3dDevice, ID3D11DeviceContext*	pd3dContext, const bool isOptimize, CFBXMeshCacheWriter* pCacheWriter)
 {
 	if(!pd3dDevice)
 		return E_FAIL;
@@ -73,160 +408,217 @@ HRESULT CFBXRenderDX11::CreateNodes(ID3D11Device*	pd3dDevice, ID3D11DeviceContex
 	if(nodeCoount==0)
 		return E_FAIL;
 
+	// MESH_NODE͔zŒڍ\z. FBX_MESH_NODE͎QƂ邾ŃRs[Ȃ
+	m_meshNodeArray.resize(nodeCoount);
+
+	// Ɨ͈̈ԑ傫m[hɍ킹čŏ1񂾂mۂ, m[hɎg
+	const uint32_t scratchAllocCount = m_scratch.GetHeapAllocCount();
+	size_t scratchSize = 0;
+	for(size_t i=0;i<nodeCoount;i++)
+		scratchSize = std::max(scratchSize, GetScratchSize(m_pFBX->GetNode(static_cast<unsigned int>(i))));
+	if(!m_scratch.Reserve(scratchSize))
+		return E_OUTOFMEMORY;
+
 	for(size_t i=0;i<nodeCoount;i++)
 	{
-		MESH_NODE meshNode;
-		FBX_MESH_NODE fbxNode = m_pFBX->GetNode(static_cast<unsigned int>(i));
+		MESH_NODE& meshNode = m_meshNodeArray[i];
+		const FBX_MESH_NODE& fbxNode = m_pFBX->GetNode(static_cast<unsigned int>(i));
+
+		m_scratch.Reset();
 
+		FBX_MESH_CACHE_SOURCE_NODE* pCacheNode = nullptr;
+		if(pCacheWriter)
+		{
+			pCacheNode = pCacheWriter->AddNode();
+			pCacheNode->SetNode(fbxNode);
+		}
+
+		// _}eAm[h(k)͍s񂾂
 		if (isOptimize)
 		{
 			// œK
-			VertexConstructionWithOptimize(pd3dDevice, pd3dContext, fbxNode, meshNode);
+			hr = VertexConstructionWithOptimize(pd3dDevice, pd3dContext, fbxNode, meshNode, pCacheNode);
 		}
-		else
+		else if (fbxNode.m_positionArray.size() > 0)
 		{
 			// œKȂ
-			VertexConstruction(pd3dDevice, fbxNode, meshNode);
-
-			// index buffer
-			meshNode.indexCount = static_cast<DWORD>(fbxNode.indexArray.size());
-			meshNode.SetIndexBit(meshNode.indexCount);
-			if (fbxNode.indexArray.size() > 0)
-				hr = CreateIndexBuffer(pd3dDevice, &meshNode.m_pIB, &fbxNode.indexArray[0], static_cast<uint32_t>(fbxNode.indexArray.size()));
+			hr = VertexConstruction(pd3dDevice, fbxNode, meshNode, pCacheNode);
+			if (SUCCEEDED(hr))
+				hr = IndexConstruction(pd3dDevice, fbxNode, meshNode, pCacheNode);
 		}
+		if (FAILED(hr))
+			return hr;
 
 		memcpy( meshNode.mat4x4, fbxNode.mat4x4,sizeof(float)*16 );
+		meshNode.bounds = fbxNode.bounds;
+		meshNode.parentId = fbxNode.parentId;
 
 		// }eA
-		MaterialConstruction(pd3dDevice, fbxNode, meshNode);
-
-		m_meshNodeArray.push_back(meshNode);
+		if (fbxNode.m_materialArray.size() > 0)
+		{
+			hr = MaterialConstruction(pd3dDevice, fbxNode, meshNode);
+			if (FAILED(hr))
+				return hr;
+		}
 	}
-	
+
+	if(m_packedUpload)
+		hr = FlushPackedUpload(pd3dDevice);
+
+	if(SUCCEEDED(hr))
+		AssignSortIds();
+
+	m_loadStats.scratchBytes = m_scratch.GetCapacity();
+	m_loadStats.scratchPeakBytes = m_scratch.GetPeak();
+	m_loadStats.scratchHeapAllocCount = m_scratch.GetHeapAllocCount() - scratchAllocCount;
 	
 	return hr;
 }
 
-HRESULT CFBXRenderDX11::VertexConstructionWithOptimize(ID3D11Device*	pd3dDevice, ID3D11DeviceContext* pContext, FBX_MESH_NODE &fbxNode, MESH_NODE& meshNode)
+// m[h1̍\zɗvƗ̈̏. OptimizeMesh/IndexConstruction/UploadVertexData̐؂oS
+size_t CFBXRenderDX11::GetScratchSize(const FBX_MESH_NODE& fbxNode) const
+{
+	const size_t nVerts = fbxNode.m_positionArray.size();
+	const size_t nIndices = (fbxNode.indexArray.size() / 3) * 3;
+	const size_t nFaces = nIndices / 3;
+
+	size_t size = 0;
+	size += sizeof(VERTEX_DATA) * nVerts * 3;					// œKO̒_, 덷p̕
+	size += static_cast<size_t>(m_vertexLayout.GetStride()) * nVerts;	// ʎq_
+	size += sizeof(uint32_t) * nVerts;							// vertRemap
+	size += sizeof(uint32_t) * nIndices * 3;					// CfbNX2g, אڏ
+	size += sizeof(uint16_t) * nIndices;						// 16bitɋl߂CfbNX
+	size += sizeof(uint32_t) * nFaces * 2;						// }eAԍ, faceRemap
+	size += CFBXScratchArena::GetAllocationOverhead() * 12;
+
+	return size;
+}
+
+template<typename index_t>
+HRESULT CFBXRenderDX11::OptimizeMesh(ID3D11Device*	pd3dDevice, const FBX_MESH_NODE &fbxNode, MESH_NODE& meshNode, FBX_MESH_CACHE_SOURCE_NODE* pCacheNode)
 {
 	HRESULT hr = S_OK;
-	size_t nFaces = fbxNode.indexArray.size() / 3;
-	size_t nVerts = fbxNode.m_positionArray.size();
+	const size_t nFaces = fbxNode.indexArray.size() / 3;
+	const size_t nVerts = fbxNode.m_positionArray.size();
 
 	if (nFaces == 0 || nVerts==0)
 		return S_OK;
 
-	VERTEX_DATA*	pIn = new VERTEX_DATA[nVerts];
+	// Ɨp̔z͑Sm_scratch؂o. Ăяom[hReset̂Ōʂ͖̉
+	VERTEX_DATA*	pIn = m_scratch.Allocate<VERTEX_DATA>(nVerts);
+	VERTEX_DATA*	pOut = m_scratch.Allocate<VERTEX_DATA>(nVerts);
+	index_t*		indices = m_scratch.Allocate<index_t>(nFaces * 3);
+	index_t*		newIndices = m_scratch.Allocate<index_t>(nFaces * 3);
+	uint32_t*		adj = m_scratch.Allocate<uint32_t>(nFaces * 3);
+	uint32_t*		attributes = m_scratch.Allocate<uint32_t>(nFaces);
+	uint32_t*		faceRemap = m_scratch.Allocate<uint32_t>(nFaces);
+	uint32_t*		vertRemap = m_scratch.Allocate<uint32_t>(nVerts);
+	if (!pIn || !pOut || !indices || !newIndices || !adj || !attributes || !faceRemap || !vertRemap)
+		return E_OUTOFMEMORY;
 
 	meshNode.vertexCount = static_cast<DWORD>(nVerts);
-	for (size_t i = 0; i<meshNode.vertexCount; i++)
-	{
-		FbxVector4 v = fbxNode.m_positionArray[i];
-		pIn[i].vPos = DirectX::XMFLOAT3((float) v.mData[0],
-			(float) v.mData[1],
-			(float) v.mData[2]);
-
-		v = fbxNode.m_normalArray[i];
-
-		pIn[i].vNor = DirectX::XMFLOAT3((float) v.mData[0],
-			(float) v.mData[1],
-			(float) v.mData[2]);
-
-		if ((float) fbxNode.m_texcoordArray.size() > 0)
-		{
-			// UV1Ȃ
-			// UVVl]
-			pIn[i].vTexcoord = DirectX::XMFLOAT2((float) abs(1.0f - fbxNode.m_texcoordArray[i].mData[0]),
-				(float) abs(1.0f - fbxNode.m_texcoordArray[i].mData[1]));
-		}
-		else
-			pIn[i].vTexcoord = DirectX::XMFLOAT2(0, 0);
-	}
+	BuildVertexData(fbxNode, pIn);
 
 	// œK
-	uint32_t* indecies = new uint32_t[fbxNode.indexArray.size()];
-	if (fbxNode.indexArray.size() > 0)
-	{
-		memcpy(indecies, &fbxNode.indexArray.front(), sizeof(uint32_t)*fbxNode.indexArray.size());
-	}
-	DirectX::XMFLOAT3* pos = new DirectX::XMFLOAT3[nVerts];
-	for (size_t j = 0; j < nVerts; ++j)
-		pos[j] = DirectX::XMFLOAT3(static_cast<float>(fbxNode.m_positionArray[j].mData[0]), static_cast<float>(fbxNode.m_positionArray[j].mData[1]), static_cast<float>(fbxNode.m_positionArray[j].mData[2]));
+	for (size_t i = 0; i < nFaces * 3; i++)
+		indices[i] = static_cast<index_t>(fbxNode.indexArray[i]);
+	// |WVzfloat3ŋl߂Ă̂ł̂܂ܓn
+	const DirectX::XMFLOAT3* pos = reinterpret_cast<const DirectX::XMFLOAT3*>(&fbxNode.m_positionArray.front());
 
-	uint32_t* adj = new uint32_t[fbxNode.indexArray.size()];
-
-	hr = DirectX::GenerateAdjacencyAndPointReps(indecies, nFaces, pos, nVerts, 0.f, nullptr, adj);
+	hr = DirectX::GenerateAdjacencyAndPointReps(indices, nFaces, pos, nVerts, 0.f, nullptr, adj);
 	if (FAILED(hr))
-	{
-		delete indecies;
-
-		delete adj;
 		return hr;
-	}
 
-	uint32_t* faceRemap = new uint32_t[nFaces];
-	hr = DirectX::OptimizeFaces(indecies, nFaces, adj, faceRemap);
+	// }eAɖʂ܂Ƃ߂Ă, ܂Ƃ܂̒ŕבւ
+	GetFaceAttributes(fbxNode, nFaces, attributes);
+
+	hr = DirectX::AttributeSort(nFaces, attributes, faceRemap);
+	if (SUCCEEDED(hr))
+		hr = DirectX::ReorderIBAndAdjacency(indices, nFaces, adj, faceRemap);
+	if (SUCCEEDED(hr))
+		hr = DirectX::OptimizeFacesEx(indices, nFaces, adj, attributes, faceRemap);
+	if (SUCCEEDED(hr))
+		hr = DirectX::ReorderIB(indices, nFaces, faceRemap, newIndices);
+	if (SUCCEEDED(hr))
+		hr = DirectX::OptimizeVertices(newIndices, nFaces, nVerts, vertRemap);
+	if (SUCCEEDED(hr))
+		hr = DirectX::FinalizeIB(newIndices, nFaces, vertRemap, nVerts);
+	if (SUCCEEDED(hr))
+		hr = DirectX::FinalizeVB(pIn, sizeof(VERTEX_DATA), nVerts, nullptr, 0, vertRemap, pOut);
 	if (FAILED(hr))
-	{
-		delete indecies;
-
-		delete adj;
-		delete faceRemap;
 		return hr;
-	}
 
-	uint32_t* newIndices = new uint32_t[nFaces*3];
-	hr = DirectX::ReorderIB(indecies, nFaces, faceRemap, newIndices);
+	hr = UploadVertexData(pd3dDevice, meshNode, pOut, meshNode.vertexCount, pCacheNode);
 	if (FAILED(hr))
-	{
-		delete indecies;
-
-		delete adj;
-		delete faceRemap;
-		delete newIndices;
 		return hr;
-	}
-
-	uint32_t* vertRemap = new uint32_t[nVerts];
-	hr = DirectX::OptimizeVertices(newIndices, nFaces, nVerts, vertRemap);
-	if (FAILED(hr))
-	{
-		delete indecies;
 
-		delete adj;
-		delete faceRemap;
-		delete newIndices;
-		delete vertRemap;
-		return hr;
-	}
-	
-	hr = DirectX::FinalizeIB(newIndices, nFaces, vertRemap, nVerts);
+	// index buffer
+	meshNode.indexCount = static_cast<DWORD>(nFaces * 3);
+	meshNode.m_indexBit = sizeof(index_t)==sizeof(uint16_t) ? MESH_NODE::INDEX_16BIT : MESH_NODE::INDEX_32BIT;
+	hr = UploadIndices(pd3dDevice, meshNode, newIndices, sizeof(index_t), meshNode.indexCount);
 	if (FAILED(hr))
 		return hr;
 
-	VERTEX_DATA*	pOut = new VERTEX_DATA[nVerts];
+	BuildSubsets(attributes, nFaces, meshNode, pCacheNode);
 
-	hr = DirectX::FinalizeVB(pIn, sizeof(VERTEX_DATA), nVerts, nullptr, 0, vertRemap, pOut);
+	if(pCacheNode)
+		pCacheNode->SetIndices(newIndices, sizeof(index_t), meshNode.indexCount);
 
-	CreateVertexBuffer(pd3dDevice, &meshNode.m_pVB, pOut, sizeof(VERTEX_DATA), meshNode.vertexCount);
+	return hr;
+}
 
-	// index buffer
-	meshNode.indexCount = static_cast<DWORD>(nFaces * 3);
-	meshNode.SetIndexBit(meshNode.indexCount);
-	if (fbxNode.indexArray.size() > 0)
-		hr = CreateIndexBuffer(pd3dDevice, &meshNode.m_pIB, newIndices, static_cast<uint32_t>( nFaces * 3));
+HRESULT CFBXRenderDX11::VertexConstructionWithOptimize(ID3D11Device*	pd3dDevice, ID3D11DeviceContext* pContext, const FBX_MESH_NODE &fbxNode, MESH_NODE& meshNode, FBX_MESH_CACHE_SOURCE_NODE* pCacheNode)
+{
+	// œK̃CfbNX͒_Ȃ̂, _16bitɎ܂邩fł
+	if (fbxNode.m_positionArray.size() < 0xffff)
+		return OptimizeMesh<uint16_t>(pd3dDevice, fbxNode, meshNode, pCacheNode);
 
-	delete indecies;
+	return OptimizeMesh<uint32_t>(pd3dDevice, fbxNode, meshNode, pCacheNode);
+}
 
-	delete adj;
-	delete faceRemap;
-	delete newIndices;
-	delete vertRemap;
-	return hr;
+// [_[float3/float2Xg[VERTEX_DATAɋlߒ
+void CFBXRenderDX11::BuildVertexData(const FBX_MESH_NODE& fbxNode, VERTEX_DATA* pV)
+{
+	static_assert(sizeof(FBX_FLOAT3) == sizeof(DirectX::XMFLOAT3), "FBX_FLOAT3 must match XMFLOAT3");
+	static_assert(sizeof(FBX_FLOAT2) == sizeof(DirectX::XMFLOAT2), "FBX_FLOAT2 must match XMFLOAT2");
+
+	const size_t vertexCount = fbxNode.m_positionArray.size();
+	if(vertexCount==0 || !pV)
+		return ;
+
+	const FBX_FLOAT3* pPos = &fbxNode.m_positionArray.front();
+	const FBX_FLOAT3* pNor = &fbxNode.m_normalArray.front();
+	// UV1Ȃ(UVSetɒ_ł̂Ő擪1ڂUVSet)
+	const FBX_FLOAT2* pUV = fbxNode.m_texcoordArray.size()>0 ? &fbxNode.m_texcoordArray.front() : nullptr;
+	const FBX_SKIN_WEIGHT* pSkin = fbxNode.m_skinArray.size()==vertexCount ? &fbxNode.m_skinArray.front() : nullptr;
+
+	for(size_t i=0;i<vertexCount;i++)
+	{
+		memcpy(&pV[i].vPos, &pPos[i], sizeof(DirectX::XMFLOAT3));
+		memcpy(&pV[i].vNor, &pNor[i], sizeof(DirectX::XMFLOAT3));
+
+		if(pUV)
+		{
+			// UVVl]
+			pV[i].vTexcoord = DirectX::XMFLOAT2(fabsf(1.0f - pUV[i].x), fabsf(1.0f - pUV[i].y));
+		}
+		else
+			pV[i].vTexcoord = DirectX::XMFLOAT2(0,0);
 
+		if(pSkin)
+		{
+			memcpy(pV[i].boneIndex, pSkin[i].index, sizeof(pV[i].boneIndex));
+			memcpy(pV[i].boneWeight, pSkin[i].weight, sizeof(pV[i].boneWeight));
+		}
+		else
+		{
+			memset(pV[i].boneIndex, 0, sizeof(pV[i].boneIndex));
+			memset(pV[i].boneWeight, 0, sizeof(pV[i].boneWeight));
+		}
+	}
 }
 
-HRESULT CFBXRenderDX11::CreateVertexBuffer(  ID3D11Device*	pd3dDevice, ID3D11Buffer** pBuffer, void* pVertices, uint32_t stride, uint32_t vertexCount )
+HRESULT CFBXRenderDX11::CreateVertexBuffer(  ID3D11Device*	pd3dDevice, ID3D11Buffer** pBuffer, const void* pVertices, uint32_t stride, uint32_t vertexCount )
 {
 	if(!pd3dDevice || stride==0 || vertexCount==0)
 		return E_FAIL;
@@ -235,7 +627,7 @@ HRESULT CFBXRenderDX11::CreateVertexBuffer(  ID3D11Device*	pd3dDevice, ID3D11Buf
 
 	D3D11_BUFFER_DESC bd;
     ZeroMemory( &bd, sizeof(bd) );
-    bd.Usage = D3D11_USAGE_DEFAULT;
+    bd.Usage = D3D11_USAGE_IMMUTABLE;
     bd.ByteWidth = stride * vertexCount;
     bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
     bd.CPUAccessFlags = 0;
@@ -248,23 +640,25 @@ HRESULT CFBXRenderDX11::CreateVertexBuffer(  ID3D11Device*	pd3dDevice, ID3D11Buf
     if( FAILED( hr ) )
         return hr;
 
+	m_loadStats.bufferCreateCount++;
+
 	return hr;
 }
 
-HRESULT CFBXRenderDX11::CreateIndexBuffer(  ID3D11Device*	pd3dDevice, ID3D11Buffer** pBuffer, void* pIndices , uint32_t indexCount )
+HRESULT CFBXRenderDX11::CreateIndexBuffer(  ID3D11Device*	pd3dDevice, ID3D11Buffer** pBuffer, const void* pIndices , uint32_t indexStride, uint32_t indexCount )
 {
-	if(!pd3dDevice || indexCount==0)
+	if(!pd3dDevice || indexCount==0 || (indexStride!=sizeof(uint16_t) && indexStride!=sizeof(uint32_t)))
 		return E_FAIL;
 
 	HRESULT hr = S_OK;
-	size_t stride = sizeof(unsigned int);
+	size_t stride = indexStride;
 		
 	D3D11_BUFFER_DESC bd;
     ZeroMemory( &bd, sizeof(bd) );
-	bd.Usage = D3D11_USAGE_DYNAMIC;
+	bd.Usage = D3D11_USAGE_IMMUTABLE;
     bd.ByteWidth = static_cast<uint32_t>(stride*indexCount);
     bd.BindFlags = D3D11_BIND_INDEX_BUFFER;
-	bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	bd.CPUAccessFlags = 0;
     D3D11_SUBRESOURCE_DATA InitData;
     ZeroMemory( &InitData, sizeof(InitData) );
  
@@ -274,75 +668,281 @@ HRESULT CFBXRenderDX11::CreateIndexBuffer(  ID3D11Device*	pd3dDevice, ID3D11Buff
     if( FAILED( hr ) )
         return hr;
 
+	m_loadStats.bufferCreateCount++;
+
 	return hr;
 }
 
 
-HRESULT CFBXRenderDX11::VertexConstruction(ID3D11Device*	pd3dDevice, FBX_MESH_NODE &fbxNode, MESH_NODE& meshNode)
+HRESULT CFBXRenderDX11::UploadVertexData(  ID3D11Device*	pd3dDevice, MESH_NODE& meshNode, const VERTEX_DATA* pVertices, uint32_t vertexCount, FBX_MESH_CACHE_SOURCE_NODE* pCacheNode )
 {
-	meshNode.vertexCount = static_cast<DWORD>(fbxNode.m_positionArray.size());
-	if(!pd3dDevice || meshNode.vertexCount==0)
+	if(!pVertices || vertexCount==0)
 		return E_FAIL;
 
-	HRESULT hr = S_OK;
+	m_vertexLayout.ComputeDequant(pVertices, vertexCount, &meshNode.dequant);
 
+	// VERTEX_DATAƃoCgPʂœт̎̂܂܎g.
+	// float32tH[}bgłXL̕VERTEX_DATA̕傫̂ŋlߒ
+	const void* pData = pVertices;
+	if(m_vertexLayout.GetStride() != sizeof(VERTEX_DATA))
+	{
+		BYTE* pEncoded = m_scratch.Allocate<BYTE>(static_cast<size_t>(m_vertexLayout.GetStride()) * vertexCount);
+		if(!pEncoded)
+			return E_OUTOFMEMORY;
 
-	VERTEX_DATA*	pV = new VERTEX_DATA[meshNode.vertexCount];
-	
-//	const size_t numUVSet = fbxNode.m_texcoordArray.size();
-	
-	for(size_t i=0;i<meshNode.vertexCount;i++)
+		m_vertexLayout.Encode(pVertices, vertexCount, meshNode.dequant, pEncoded);
+		pData = pEncoded;
+
+		// float32̂܂܂Ȃ덷͖
+		if(m_vertexLayout.GetFormat().GetCode() != FBX_VERTEX_FORMAT().GetCode())
+		{
+			VERTEX_DATA* pDecoded = m_scratch.Allocate<VERTEX_DATA>(vertexCount);
+			if(!pDecoded)
+				return E_OUTOFMEMORY;
+
+			FBX_VERTEX_ERROR error;
+			m_vertexLayout.MeasureError(pVertices, pEncoded, vertexCount, meshNode.dequant, pDecoded, &error);
+			m_loadStats.vertexPositionError = std::max(m_loadStats.vertexPositionError, error.position);
+			m_loadStats.vertexNormalError = std::max(m_loadStats.vertexNormalError, error.normal);
+			m_loadStats.vertexTexcoordError = std::max(m_loadStats.vertexTexcoordError, error.texcoord);
+		}
+	}
+
+	HRESULT hr = UploadVertices(pd3dDevice, meshNode, pData, vertexCount);
+	if(FAILED(hr))
+		return hr;
+
+	if(pCacheNode)
+	{
+		pCacheNode->SetVertices(pData, m_vertexLayout.GetStride(), vertexCount);
+		const float scale[3] = { meshNode.dequant.positionScale.x, meshNode.dequant.positionScale.y, meshNode.dequant.positionScale.z };
+		const float offset[3] = { meshNode.dequant.positionOffset.x, meshNode.dequant.positionOffset.y, meshNode.dequant.positionOffset.z };
+		pCacheNode->SetPositionDequant(scale, offset);
+	}
+
+	return CreateDequantBuffer(pd3dDevice, meshNode);
+}
+
+// _VF[_ŗʎq_߂߂̒萔. ǂݍ݌͕ςȂ̂, em[hmŋL
+HRESULT CFBXRenderDX11::CreateDequantBuffer( ID3D11Device*	pd3dDevice, MESH_NODE& meshNode )
+{
+	return m_pStateCache->GetDequantBuffer( meshNode.dequant, &meshNode.m_pDequantCb );
+}
+
+HRESULT CFBXRenderDX11::UploadVertices(  ID3D11Device*	pd3dDevice, MESH_NODE& meshNode, const void* pVertices, uint32_t vertexCount )
+{
+	if(!m_packedUpload)
+	{
+		meshNode.vertexStart = 0;
+		return CreateVertexBuffer(pd3dDevice, &meshNode.m_pVB, pVertices, m_vertexLayout.GetStride(), vertexCount);
+	}
+
+	if(!pVertices || vertexCount==0)
+		return E_FAIL;
+
+	const size_t stride = m_vertexLayout.GetStride();
+	const size_t offset = m_packedVertices.size();
+	meshNode.vertexStart = static_cast<DWORD>(offset / stride);
+	m_packedVertices.resize(offset + static_cast<size_t>(vertexCount) * stride);
+	memcpy(&m_packedVertices[offset], pVertices, static_cast<size_t>(vertexCount) * stride);
+
+	return S_OK;
+}
+
+HRESULT CFBXRenderDX11::UploadIndices(  ID3D11Device*	pd3dDevice, MESH_NODE& meshNode, const void* pIndices, uint32_t indexStride, uint32_t indexCount )
+{
+	if(!m_packedUpload)
+	{
+		meshNode.indexStart = 0;
+		return CreateIndexBuffer(pd3dDevice, &meshNode.m_pIB, pIndices, indexStride, indexCount);
+	}
+
+	if(!pIndices || indexCount==0)
+		return E_FAIL;
+
+	// Sm[h̕܂ŕȂ̂, 32bitŗ߂.
+	// CfbNX̓m[h̒_̐擪̔ԍ̂܂(vertexStart͒_obt@̃ItZbgő)
+	meshNode.indexStart = static_cast<DWORD>(m_packedIndices.size());
+	if(indexStride==sizeof(uint16_t))
+	{
+		const uint16_t* p16 = static_cast<const uint16_t*>(pIndices);
+		m_packedIndices.insert(m_packedIndices.end(), p16, p16 + indexCount);
+	}
+	else if(indexStride==sizeof(uint32_t))
 	{
-		FbxVector4 v = fbxNode.m_positionArray[i];
-		pV[i].vPos = DirectX::XMFLOAT3( (float)v.mData[0],
-			(float)v.mData[1], 
-			(float)v.mData[2] );
+		const uint32_t* p32 = static_cast<const uint32_t*>(pIndices);
+		m_packedIndices.insert(m_packedIndices.end(), p32, p32 + indexCount);
+	}
+	else
+		return E_FAIL;
+
+	return S_OK;
+}
+
+// ߂_ECfbNX烂fŜ1obt@, Sm[hŋL
+HRESULT CFBXRenderDX11::FlushPackedUpload( ID3D11Device*	pd3dDevice )
+{
+	HRESULT hr = S_OK;
 
-		v = fbxNode.m_normalArray[i];
+	ID3D11Buffer* pVB = nullptr;
+	ID3D11Buffer* pIB = nullptr;
 
-		pV[i].vNor = DirectX::XMFLOAT3( (float)v.mData[0],
-			(float)v.mData[1], 
-			(float)v.mData[2] );
+	if(m_packedVertices.size() > 0)
+	{
+		hr = CreateVertexBuffer(pd3dDevice, &pVB, &m_packedVertices[0], m_vertexLayout.GetStride(),
+			static_cast<uint32_t>(m_packedVertices.size() / m_vertexLayout.GetStride()));
+	}
+
+	// 1m[hł32bitKvȂobt@Ŝ32bitɂ
+	MESH_NODE::INDEX_BIT indexBit = MESH_NODE::INDEX_16BIT;
+	for(size_t i=0;i<m_meshNodeArray.size();i++)
+	{
+		if(m_meshNodeArray[i].m_indexBit==MESH_NODE::INDEX_32BIT)
+			indexBit = MESH_NODE::INDEX_32BIT;
+	}
 
-		if((float)fbxNode.m_texcoordArray.size() > 0)
+	if(SUCCEEDED(hr) && m_packedIndices.size() > 0)
+	{
+		const uint32_t indexCount = static_cast<uint32_t>(m_packedIndices.size());
+		if(indexBit==MESH_NODE::INDEX_16BIT)
 		{
-			// UV1Ȃ
-			// UVVl]
-			pV[i].vTexcoord = DirectX::XMFLOAT2( (float)abs(1.0f-fbxNode.m_texcoordArray[i].mData[0]),
-				(float)abs(1.0f-fbxNode.m_texcoordArray[i].mData[1]));
+			std::vector<uint16_t> indices16(m_packedIndices.begin(), m_packedIndices.end());
+			hr = CreateIndexBuffer(pd3dDevice, &pIB, &indices16[0], sizeof(uint16_t), indexCount);
 		}
 		else
-			pV[i].vTexcoord = DirectX::XMFLOAT2(0,0);
+			hr = CreateIndexBuffer(pd3dDevice, &pIB, &m_packedIndices[0], sizeof(uint32_t), indexCount);
+	}
+
+	if(SUCCEEDED(hr))
+	{
+		// em[hQƂ̂, MESH_NODE::Release̓m[h̃obt@Ɠ悤ɌĂׂ
+		for(size_t i=0;i<m_meshNodeArray.size();i++)
+		{
+			MESH_NODE& meshNode = m_meshNodeArray[i];
+			if(pVB && meshNode.vertexCount > 0)
+			{
+				meshNode.m_pVB = pVB;
+				pVB->AddRef();
+			}
+			if(pIB && meshNode.indexCount > 0)
+			{
+				meshNode.m_pIB = pIB;
+				meshNode.m_indexBit = indexBit;
+				pIB->AddRef();
+			}
+		}
 	}
 
-	CreateVertexBuffer(pd3dDevice, &meshNode.m_pVB, pV, sizeof(VERTEX_DATA), meshNode.vertexCount);
+	if(pVB)
+		pVB->Release();
+	if(pIB)
+		pIB->Release();
+
+	m_packedVertices.clear();
+	m_packedIndices.clear();
+
+	return hr;
+}
+
+HRESULT CFBXRenderDX11::VertexConstruction(ID3D11Device*	pd3dDevice, const FBX_MESH_NODE &fbxNode, MESH_NODE& meshNode, FBX_MESH_CACHE_SOURCE_NODE* pCacheNode)
+{
+	meshNode.vertexCount = static_cast<DWORD>(fbxNode.m_positionArray.size());
+	if(!pd3dDevice || meshNode.vertexCount==0)
+		return E_FAIL;
+
+	VERTEX_DATA*	pV = m_scratch.Allocate<VERTEX_DATA>(meshNode.vertexCount);
+	if(!pV)
+		return E_OUTOFMEMORY;
+
+	BuildVertexData(fbxNode, pV);
+
+	return UploadVertexData(pd3dDevice, meshNode, pV, meshNode.vertexCount, pCacheNode);
+}
+
+// œKȂindex buffer. ʂ}eAɕבւăTuZbgɂ
+HRESULT CFBXRenderDX11::IndexConstruction(ID3D11Device*	pd3dDevice, const FBX_MESH_NODE &fbxNode, MESH_NODE& meshNode, FBX_MESH_CACHE_SOURCE_NODE* pCacheNode)
+{
+	const size_t nFaces = fbxNode.indexArray.size() / 3;
+	meshNode.indexCount = static_cast<DWORD>(nFaces * 3);
+	meshNode.SetIndexBit(meshNode.indexCount, nFaces > 0 ? GetMaxIndex(&fbxNode.indexArray[0], meshNode.indexCount) : 0);
+	if (nFaces == 0)
+		return S_OK;
+
+	uint32_t* indices = m_scratch.Allocate<uint32_t>(nFaces * 3);
+	uint32_t* attributes = m_scratch.Allocate<uint32_t>(nFaces);
+	uint32_t* faceRemap = m_scratch.Allocate<uint32_t>(nFaces);
+	if (!indices || !attributes || !faceRemap)
+		return E_OUTOFMEMORY;
+
+	memcpy(indices, &fbxNode.indexArray[0], sizeof(uint32_t) * nFaces * 3);
+	GetFaceAttributes(fbxNode, nFaces, attributes);
+
+	HRESULT hr = DirectX::AttributeSort(nFaces, attributes, faceRemap);
+	if (SUCCEEDED(hr))
+		hr = DirectX::ReorderIB(indices, nFaces, faceRemap);
+	if (FAILED(hr))
+		return hr;
+
+	// בւ32bit̂܂܍s, obt@ɓ鎞ɋl߂
+	const void* pIndices = indices;
+	if (meshNode.m_indexBit == MESH_NODE::INDEX_16BIT)
+	{
+		uint16_t* indices16 = m_scratch.Allocate<uint16_t>(nFaces * 3);
+		if (!indices16)
+			return E_OUTOFMEMORY;
+
+		NarrowIndices(indices, nFaces * 3, indices16);
+		pIndices = indices16;
+	}
+
+	hr = UploadIndices(pd3dDevice, meshNode, pIndices, meshNode.GetIndexStride(), meshNode.indexCount);
+	if (FAILED(hr))
+		return hr;
+
+	BuildSubsets(attributes, nFaces, meshNode, pCacheNode);
+	if(pCacheNode)
+		pCacheNode->SetIndices(pIndices, meshNode.GetIndexStride(), meshNode.indexCount);
 
-	if(pV)
-		delete[] pV;
-	
 	return hr;
 }
 
 //
-HRESULT CFBXRenderDX11::MaterialConstruction(ID3D11Device*	pd3dDevice,FBX_MESH_NODE &fbxNode,  MESH_NODE& meshNode)
+HRESULT CFBXRenderDX11::MaterialConstruction(ID3D11Device*	pd3dDevice,const FBX_MESH_NODE &fbxNode,  MESH_NODE& meshNode)
 {
 	if(!pd3dDevice || fbxNode.m_materialArray.size()==0)
 		return E_FAIL;
 
 	HRESULT hr = S_OK;
-	
-	// ͐擪̃}eAg
-	FBX_MATERIAL_NODE fbxMaterial = fbxNode.m_materialArray[0];
-	meshNode.materialData.specularPower = fbxMaterial.shininess;
-	meshNode.materialData.TransparencyFactor = fbxMaterial.TransparencyFactor;
 
-	meshNode.materialData.ambient 
+	// TuZbgmaterialIdƓY킹
+	meshNode.materialArray.resize(fbxNode.m_materialArray.size());
+	for(size_t i=0;i<fbxNode.m_materialArray.size();i++)
+	{
+		HRESULT hrMaterial = MaterialConstruction(pd3dDevice, fbxNode.m_materialArray[i], meshNode.materialArray[i]);
+		if(FAILED(hrMaterial))
+			hr = hrMaterial;
+	}
+
+	return hr;
+}
+
+HRESULT CFBXRenderDX11::MaterialConstruction(ID3D11Device*	pd3dDevice, const FBX_MATERIAL_NODE &fbxMaterial,  MATERIAL_DATA& materialData)
+{
+	if(!pd3dDevice)
+		return E_FAIL;
+
+	HRESULT hr = S_OK;
+
+	materialData.specularPower = fbxMaterial.shininess;
+	materialData.TransparencyFactor = fbxMaterial.TransparencyFactor;
+
+	materialData.ambient 
 		= DirectX::XMFLOAT4(fbxMaterial.ambient.r,fbxMaterial.ambient.g,fbxMaterial.ambient.b,fbxMaterial.ambient.a);
-	meshNode.materialData.diffuse
+	materialData.diffuse
 		= DirectX::XMFLOAT4(fbxMaterial.diffuse.r,fbxMaterial.diffuse.g,fbxMaterial.diffuse.b,fbxMaterial.diffuse.a);
-	meshNode.materialData.specular
+	materialData.specular
 		= DirectX::XMFLOAT4(fbxMaterial.specular.r,fbxMaterial.specular.g,fbxMaterial.specular.b,fbxMaterial.specular.a);
-	meshNode.materialData.emmisive
+	materialData.emmisive
 		= DirectX::XMFLOAT4(fbxMaterial.emmisive.r,fbxMaterial.emmisive.g,fbxMaterial.emmisive.b,fbxMaterial.emmisive.a);
 
 
@@ -352,17 +952,19 @@ HRESULT CFBXRenderDX11::MaterialConstruction(ID3D11Device*	pd3dDevice,FBX_MESH_N
 		TextureSet::const_iterator it = fbxMaterial.diffuse.textureSetArray.begin();
 		if(it->second.size())
 		{
-			std::string path = it->second[0];
-
-			// June 2010̎ύX
-//			hr = D3DX11CreateShaderResourceViewFromFileA( pd3dDevice,path.c_str(), NULL, NULL, &meshNode.materialData.pSRV, NULL );
-
-			// Todo: ߑł悭ȂǎbΉ
-			// FBXSDKƕcharȂ񂾂ǁAłwcharɂȂƂȂ...
-			WCHAR	wstr[512];
-			size_t wLen = 0;
-			mbstowcs_s( &wLen, wstr, path.size()+1, path.c_str(), _TRUNCATE);
-			CreateDDSTextureFromFile( pd3dDevice, wstr, NULL, &meshNode.materialData.pSRV, 0 );	// DXTex
+			const std::string& path = it->second[0];
+
+			// t@C(pXe)͑̃m[hEfƓSRVg.
+			// ȂĂǂݍ݂͑(eNX`Ȃŕ`)
+			if(m_asyncTextureLoad)
+			{
+				if(m_pStateCache->GetTextureCache().GetTextureAsync( path.c_str(), m_sourceDirectory, &materialData.pSRV, &materialData.pendingTexture )==S_FALSE)
+					m_pendingTextureCount++;
+				else
+					materialData.pendingTexture.clear();
+			}
+			else
+				m_pStateCache->GetTextureCache().GetTexture( path.c_str(), m_sourceDirectory, &materialData.pSRV );	// DXTex
 		}
 	}
 
@@ -376,42 +978,115 @@ HRESULT CFBXRenderDX11::MaterialConstruction(ID3D11Device*	pd3dDevice,FBX_MESH_N
 	sampDesc.ComparisonFunc = D3D11_COMPARISON_NEVER;
 	sampDesc.MinLOD = 0;
 	sampDesc.MaxLOD = D3D11_FLOAT32_MAX;
-	hr = pd3dDevice->CreateSamplerState( &sampDesc, &meshNode.materialData.pSampler );
+	hr = m_pStateCache->GetSamplerState( sampDesc, &materialData.pSampler );
 
 	// material Constant Buffer
-	D3D11_BUFFER_DESC bufDesc;
-	ZeroMemory( &bufDesc, sizeof(bufDesc) );
-    bufDesc.ByteWidth = sizeof(MATERIAL_CONSTANT_DATA);
-    bufDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-    bufDesc.CPUAccessFlags = 0;
-
-	hr = pd3dDevice->CreateBuffer( &bufDesc, NULL, &meshNode.materialData.pMaterialCb );
-	
-	meshNode.materialData.materialConstantData.ambient = meshNode.materialData.ambient;
-	meshNode.materialData.materialConstantData.diffuse = meshNode.materialData.ambient;
-	meshNode.materialData.materialConstantData.specular = meshNode.materialData.specular;
-	meshNode.materialData.materialConstantData.emmisive = meshNode.materialData.emmisive;
+	materialData.materialConstantData.ambient = materialData.ambient;
+	materialData.materialConstantData.diffuse = materialData.ambient;
+	materialData.materialConstantData.specular = materialData.specular;
+	materialData.materialConstantData.emmisive = materialData.emmisive;
+
+	// }eA͓ǂݍ݌ɕςȂ̂, 쐬ɒgĕ`掞̍XVȂ.
+	// gȂ瑼̃m[hEfƓobt@g
+	HRESULT hrCb = m_pStateCache->GetMaterialBuffer( materialData.materialConstantData, &materialData.pMaterialCb );
+	if(FAILED(hrCb))
+		hr = hrCb;
 		
 	return hr;
 }
 
+// `撆SRVւ̂, `ƓXbhĂ
+size_t CFBXRenderDX11::UpdateTextures()
+{
+	if(m_pendingTextureCount==0 || !m_pStateCache)
+		return 0;
+
+	CFBXTextureCache& textureCache = m_pStateCache->GetTextureCache();
+
+	size_t pendingCount = 0;
+	for(size_t i=0;i<m_meshNodeArray.size();i++)
+	{
+		MESH_NODE& meshNode = m_meshNodeArray[i];
+		for(size_t m=0;m<meshNode.materialArray.size();m++)
+		{
+			MATERIAL_DATA& material = meshNode.materialArray[m];
+			if(material.pendingTexture.empty())
+				continue;
+
+			ID3D11ShaderResourceView* pSRV = nullptr;
+			if(textureCache.PollTexture(material.pendingTexture, &pSRV)==S_FALSE)
+			{
+				pendingCount++;
+				continue;
+			}
+
+			// ǂݍ߂Ȃ͓ǂݍ݂ƓeNX`Ȃ
+			if(material.pSRV)
+				material.pSRV->Release();
+			material.pSRV = pSRV;
+			material.pendingTexture.clear();
+		}
+	}
+
+	m_pendingTextureCount = pendingCount;
+	return pendingCount;
+}
+
+void CFBXRenderDX11::WaitTextures()
+{
+	if(m_pendingTextureCount==0 || !m_pStateCache)
+		return ;
+
+	m_pStateCache->GetTextureCache().WaitIdle();
+	UpdateTextures();
+}
+
 //
-HRESULT CFBXRenderDX11::CreateInputLayout(ID3D11Device*	pd3dDevice, const void* pShaderBytecodeWithInputSignature, size_t BytecodeLength, D3D11_INPUT_ELEMENT_DESC* pLayout, unsigned int layoutSize)
+HRESULT CFBXRenderDX11::CreateInputLayout(ID3D11Device*	pd3dDevice, const void* pShaderBytecodeWithInputSignature, size_t BytecodeLength, const D3D11_INPUT_ELEMENT_DESC* pLayout, unsigned int layoutSize)
 {
 	// InputeLayout͒_VF[_̃RpCʂKv
 	if(!pd3dDevice || !pShaderBytecodeWithInputSignature || !pLayout)
 		return E_FAIL;
 
-	HRESULT hr = S_OK;
+	HRESULT hr = AcquireStateCache(pd3dDevice);
+	if(FAILED(hr))
+		return hr;
 
 	for (auto meshNode = m_meshNodeArray.begin(); meshNode != m_meshNodeArray.end();++meshNode)
 	{
-		hr = pd3dDevice->CreateInputLayout(pLayout, layoutSize, pShaderBytecodeWithInputSignature, BytecodeLength, &meshNode->m_pInputLayout);
+		if(meshNode->m_pInputLayout)
+		{
+			meshNode->m_pInputLayout->Release();
+			meshNode->m_pInputLayout = nullptr;
+		}
+
+		hr = m_pStateCache->GetInputLayout(pLayout, layoutSize, pShaderBytecodeWithInputSignature, BytecodeLength, &meshNode->m_pInputLayout, &meshNode->layoutId);
+		if(FAILED(hr))
+			break;
 	}
 
 	return hr;
 }
 
+void CFBXRenderDX11::SetMaterial(ID3D11DeviceContext* pImmediateContext, const MESH_NODE& meshNode, const uint32_t materialId)
+{
+	ID3D11ShaderResourceView*	pSRV = nullptr;
+	ID3D11Buffer*				pMaterialCb = nullptr;
+	ID3D11SamplerState*			pSampler = nullptr;
+
+	if(materialId < meshNode.materialArray.size())
+	{
+		const MATERIAL_DATA& material = meshNode.materialArray[materialId];
+		pSRV = material.pSRV;
+		pMaterialCb = material.pMaterialCb;
+		pSampler = material.pSampler;
+	}
+
+	pImmediateContext->PSSetShaderResources( 0, 1, &pSRV );
+	pImmediateContext->PSSetConstantBuffers( 0, 1, &pMaterialCb );
+	pImmediateContext->PSSetSamplers( 0, 1, &pSampler );
+}
+
 HRESULT CFBXRenderDX11::RenderAll( ID3D11DeviceContext* pImmediateContext)
 {
 	size_t nodeCount = m_meshNodeArray.size();
@@ -422,23 +1097,46 @@ HRESULT CFBXRenderDX11::RenderAll( ID3D11DeviceContext* pImmediateContext)
 
 	pImmediateContext->IASetPrimitiveTopology( D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST );
 
+	// ꊇAbv[h͑Sm[hobt@Ȃ̂, obt@̓ItZbg01񂾂ݒ肵
+	// m[ḧʒuDrawIndexedStart/BaseŎw肷. }eAOƓȂݒ肵Ȃ
+	const MESH_NODE*	pBoundNode = nullptr;
+	const MATERIAL_DATA* pBoundMaterial = nullptr;
 	for (auto meshNode = m_meshNodeArray.begin(); meshNode != m_meshNodeArray.end(); ++meshNode)
 	{
-		if (meshNode->vertexCount == 0)
+		if (meshNode->vertexCount == 0 || meshNode->m_indexBit == MESH_NODE::INDEX_NOINDEX)
 			continue;
 
-		UINT stride = sizeof(VERTEX_DATA);
-		UINT offset = 0;
-		pImmediateContext->IASetVertexBuffers(0, 1, &meshNode->m_pVB, &stride, &offset);
+		if (!pBoundNode || pBoundNode->m_pVB != meshNode->m_pVB)
+		{
+			UINT stride = m_vertexLayout.GetStride();
+			UINT offset = 0;
+			pImmediateContext->IASetVertexBuffers(0, 1, &meshNode->m_pVB, &stride, &offset);
+		}
 
-		DXGI_FORMAT indexbit = DXGI_FORMAT_R16_UINT;
-		if (meshNode->m_indexBit == MESH_NODE::INDEX_32BIT)
-			indexbit = DXGI_FORMAT_R32_UINT;
+		if (!pBoundNode || pBoundNode->m_pIB != meshNode->m_pIB || pBoundNode->m_indexBit != meshNode->m_indexBit)
+		{
+			DXGI_FORMAT indexbit = DXGI_FORMAT_R16_UINT;
+			if (meshNode->m_indexBit == MESH_NODE::INDEX_32BIT)
+				indexbit = DXGI_FORMAT_R32_UINT;
+			pImmediateContext->IASetIndexBuffer(meshNode->m_pIB, indexbit, 0);
+		}
 
-		pImmediateContext->IASetInputLayout(meshNode->m_pInputLayout);
-		pImmediateContext->IASetIndexBuffer(meshNode->m_pIB, indexbit, 0);
+		if (!pBoundNode || pBoundNode->m_pInputLayout != meshNode->m_pInputLayout)
+			pImmediateContext->IASetInputLayout(meshNode->m_pInputLayout);
 
-		pImmediateContext->DrawIndexed(meshNode->indexCount, 0, 0);
+		pImmediateContext->VSSetConstantBuffers(1, 1, &meshNode->m_pDequantCb);
+		pBoundNode = &(*meshNode);
+
+		for (auto subset = meshNode->subsetArray.begin(); subset != meshNode->subsetArray.end(); ++subset)
+		{
+			const MATERIAL_DATA* pMaterial = subset->materialId < meshNode->materialArray.size() ? &meshNode->materialArray[subset->materialId] : nullptr;
+			if (!pMaterial || pMaterial != pBoundMaterial)
+			{
+				SetMaterial(pImmediateContext, *meshNode, subset->materialId);
+				pBoundMaterial = pMaterial;
+			}
+			pImmediateContext->DrawIndexed(subset->indexCount, meshNode->indexStart + subset->startIndex, static_cast<INT>(meshNode->vertexStart));
+		}
 	}
 
 	return hr;
@@ -457,9 +1155,10 @@ HRESULT CFBXRenderDX11::RenderNode( ID3D11DeviceContext* pImmediateContext, cons
 	if(node->vertexCount==0)
 		return S_OK;
 
-	UINT stride = sizeof( VERTEX_DATA );
-	UINT offset = 0;
+	UINT stride = m_vertexLayout.GetStride();
+	UINT offset = node->GetVertexOffset(stride);
 	pImmediateContext->IASetVertexBuffers( 0, 1, &node->m_pVB, &stride, &offset );
+	pImmediateContext->VSSetConstantBuffers( 1, 1, &node->m_pDequantCb );
 	pImmediateContext->IASetInputLayout(node->m_pInputLayout);
 	pImmediateContext->IASetPrimitiveTopology( D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST );
 
@@ -470,9 +1169,13 @@ HRESULT CFBXRenderDX11::RenderNode( ID3D11DeviceContext* pImmediateContext, cons
 		if(node->m_indexBit==MESH_NODE::INDEX_32BIT)
 			indexbit = DXGI_FORMAT_R32_UINT;
 		
-		pImmediateContext->IASetIndexBuffer(node->m_pIB,indexbit,0);
+		pImmediateContext->IASetIndexBuffer(node->m_pIB,indexbit,node->GetIndexOffset());
 
-		pImmediateContext->DrawIndexed(node->indexCount, 0, 0);
+		for (auto subset = node->subsetArray.begin(); subset != node->subsetArray.end(); ++subset)
+		{
+			SetMaterial(pImmediateContext, *node, subset->materialId);
+			pImmediateContext->DrawIndexed(subset->indexCount, subset->startIndex, 0);
+		}
 	}
 
 	return hr;
@@ -491,9 +1194,10 @@ HRESULT CFBXRenderDX11::RenderNodeInstancing( ID3D11DeviceContext* pImmediateCon
 	if(node->vertexCount==0)
 		return S_OK;
 
-	UINT stride = sizeof( VERTEX_DATA );
-	UINT offset = 0;
+	UINT stride = m_vertexLayout.GetStride();
+	UINT offset = node->GetVertexOffset(stride);
 	pImmediateContext->IASetVertexBuffers( 0, 1, &node->m_pVB, &stride, &offset );
+	pImmediateContext->VSSetConstantBuffers( 1, 1, &node->m_pDequantCb );
 	pImmediateContext->IASetInputLayout(node->m_pInputLayout);
 	pImmediateContext->IASetPrimitiveTopology( D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST );
 
@@ -504,14 +1208,29 @@ HRESULT CFBXRenderDX11::RenderNodeInstancing( ID3D11DeviceContext* pImmediateCon
 		if(node->m_indexBit==MESH_NODE::INDEX_32BIT)
 			indexbit = DXGI_FORMAT_R32_UINT;
 		
-		pImmediateContext->IASetIndexBuffer(node->m_pIB,indexbit,0);
+		pImmediateContext->IASetIndexBuffer(node->m_pIB,indexbit,node->GetIndexOffset());
 
-		pImmediateContext->DrawIndexedInstanced(node->indexCount, InstanceCount, 0, 0, 0);
+		for (auto subset = node->subsetArray.begin(); subset != node->subsetArray.end(); ++subset)
+		{
+			SetMaterial(pImmediateContext, *node, subset->materialId);
+			pImmediateContext->DrawIndexedInstanced(subset->indexCount, InstanceCount, subset->startIndex, 0, 0);
+		}
 	}
 
 	return hr;
 }
 
+HRESULT CFBXRenderDX11::RenderNodeInstancing( ID3D11DeviceContext* pImmediateContext, const size_t nodeId, const CFBXInstanceBuffer& instances )
+{
+	if(instances.GetVisibleCount()==0)
+		return S_OK;
+
+	ID3D11ShaderResourceView* pSRV = instances.GetSRV();
+	pImmediateContext->VSSetShaderResources( 0, 1, &pSRV );
+
+	return RenderNodeInstancing(pImmediateContext, nodeId, instances.GetVisibleCount());
+}
+
 HRESULT CFBXRenderDX11::RenderNodeInstancingIndirect( ID3D11DeviceContext* pImmediateContext, const size_t nodeId, ID3D11Buffer* pBufferForArgs, const uint32_t AlignedByteOffsetForArgs)
 {
 	size_t nodeCount = m_meshNodeArray.size();
@@ -525,9 +1244,10 @@ HRESULT CFBXRenderDX11::RenderNodeInstancingIndirect( ID3D11DeviceContext* pImme
 	if(node->vertexCount==0)
 		return S_OK;
 
-	UINT stride = sizeof( VERTEX_DATA );
-	UINT offset = 0;
+	UINT stride = m_vertexLayout.GetStride();
+	UINT offset = node->GetVertexOffset(stride);
 	pImmediateContext->IASetVertexBuffers( 0, 1, &node->m_pVB, &stride, &offset );
+	pImmediateContext->VSSetConstantBuffers( 1, 1, &node->m_pDequantCb );
 	pImmediateContext->IASetInputLayout(node->m_pInputLayout);
 	pImmediateContext->IASetPrimitiveTopology( D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST );
 
@@ -538,8 +1258,10 @@ HRESULT CFBXRenderDX11::RenderNodeInstancingIndirect( ID3D11DeviceContext* pImme
 		if(node->m_indexBit==MESH_NODE::INDEX_32BIT)
 			indexbit = DXGI_FORMAT_R32_UINT;
 		
-		pImmediateContext->IASetIndexBuffer(node->m_pIB,indexbit,0);
+		pImmediateContext->IASetIndexBuffer(node->m_pIB,indexbit,node->GetIndexOffset());
 
+		// obt@1񕪂̕`Ȃ̂, 擪TuZbg̃}eAg
+		SetMaterial(pImmediateContext, *node, node->subsetArray.size() ? node->subsetArray[0].materialId : 0);
 		pImmediateContext->DrawIndexedInstancedIndirect(pBufferForArgs, AlignedByteOffsetForArgs);
 	}
 
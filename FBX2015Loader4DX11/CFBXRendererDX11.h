@@ -12,6 +12,13 @@
 #pragma once
 
 #include "CFBXLoader.h"
+#include "CFBXAnimation.h"
+#include "CFBXSkinning.h"
+#include "CFBXMeshCache.h"
+#include "CFBXVertexFormat.h"
+#include "CFBXScratchArena.h"
+#include "CFBXStateCache.h"
+#include "CFBXInstanceBuffer.h"
 
 #include <d3d11.h>
 #include <d3dcompiler.h>
@@ -20,21 +27,6 @@
 namespace FBX_LOADER
 {
 
-struct	VERTEX_DATA
-{
-	DirectX::XMFLOAT3	vPos;
-	DirectX::XMFLOAT3	vNor;
-	DirectX::XMFLOAT2	vTexcoord;
-};
-
-struct MATERIAL_CONSTANT_DATA
-{
-	DirectX::XMFLOAT4	ambient;
-	DirectX::XMFLOAT4	diffuse;
-	DirectX::XMFLOAT4	specular;
-	DirectX::XMFLOAT4	emmisive;
-};
-
 struct MATERIAL_DATA
 {
 	DirectX::XMFLOAT4	ambient;
@@ -47,14 +39,21 @@ struct MATERIAL_DATA
 	MATERIAL_CONSTANT_DATA materialConstantData;
 
 	ID3D11ShaderResourceView*	pSRV;
-	ID3D11SamplerState*         pSampler;
-	ID3D11Buffer*				pMaterialCb;
+	ID3D11SamplerState*         pSampler;		// CFBXStateCacheŋL
+	ID3D11Buffer*				pMaterialCb;	// CFBXStateCacheŋL
+
+	// CFBXRenderQueuẽ\[gL[ɋl߂ԍ. ǂݍ݂̓xɃvZXŐVÛ, }eA̔ԍ͎g񂳂Ȃ
+	uint32_t					sortId;
+
+	// 񓯊œǂݍݒ̃eNX`(CFBXTextureCachẽL[). ̊pSRV͉SRV
+	std::wstring				pendingTexture;
 
 	MATERIAL_DATA()
 	{
 		pSRV = nullptr;
 		pSampler = nullptr;
 		pMaterialCb = nullptr;
+		sortId = 0;
 	}
 	
 	void Release()
@@ -70,6 +69,7 @@ struct MATERIAL_DATA
 			pSRV->Release();
 			pSRV = nullptr;
 		}
+		pendingTexture.clear();
 
 		if(pSampler)
 		{
@@ -79,18 +79,42 @@ struct MATERIAL_DATA
 	}
 };
 
+// }eAɂ܂Ƃ߂ʂ͈̔. m[h̒_ECfbNXobt@L
+struct MESH_SUBSET
+{
+	uint32_t	startIndex;
+	uint32_t	indexCount;
+	uint32_t	materialId;		// MESH_NODE::materialArray̓Y
+};
+
 struct	MESH_NODE
 {
 	ID3D11Buffer*		m_pVB;
 	ID3D11Buffer*		m_pIB;
-	ID3D11InputLayout*	m_pInputLayout;
+	ID3D11InputLayout*	m_pInputLayout;		// CFBXStateCacheŋL. Sm[hw
+	ID3D11Buffer*		m_pDequantCb;		// VERTEX_DEQUANT_DATA. _VF[_b1
+
+	// CFBXRenderQueuẽ\[gL[ɋl߂ԍ(0͖).
+	// layoutIdCFBXStateCache̓̓CAEg̔ԍ, geometryId͓ǂݍ݂̓xɐUԍ(ꊇAbv[hł̓f1)
+	uint32_t	layoutId;
+	uint32_t	geometryId;
+
+	VERTEX_DEQUANT_DATA	dequant;
 	
 	DWORD	vertexCount;
 	DWORD	indexCount;
 
-	MATERIAL_DATA materialData;
+	// ꊇAbv[h̓fŜ1̃obt@L̂, ̒ł̐擪ʒu(vf).
+	// m[h̃obt@ł0
+	DWORD	vertexStart;
+	DWORD	indexStart;
 
+	std::vector<MATERIAL_DATA>	materialArray;
+	std::vector<MESH_SUBSET>	subsetArray;		// }eA. CfbNXobt@͂̏ɕł
+
+	int		parentId;	// em[h̔ԍ(FBX_MESH_NODE::parentId). -1
 	float	mat4x4[16];
+	FBX_BOUNDS	bounds;		// [JW̋E. CFBXRenderQueuẽJOɎg
 
 	// INDEX BUFFERBIT
 	enum INDEX_BIT
@@ -106,20 +130,34 @@ struct	MESH_NODE
 		m_pVB = nullptr;
 		m_pIB = nullptr;
 		m_pInputLayout = nullptr;
+		m_pDequantCb = nullptr;
+		layoutId = 0;
+		geometryId = 0;
 		m_indexBit = INDEX_NOINDEX;
+		parentId = -1;
 		vertexCount = 0;
 		indexCount = 0;
+		vertexStart = 0;
+		indexStart = 0;
 	}
 
 	void Release()
 	{
-		materialData.Release();
+		for(size_t i=0;i<materialArray.size();i++)
+			materialArray[i].Release();
+		materialArray.clear();
+		subsetArray.clear();
 
 		if(m_pInputLayout)
 		{
 			m_pInputLayout->Release();
 			m_pInputLayout = nullptr;
 		}
+		if(m_pDequantCb)
+		{
+			m_pDequantCb->Release();
+			m_pDequantCb = nullptr;
+		}
 		if(m_pIB)
 		{
 			m_pIB->Release();
@@ -132,37 +170,86 @@ struct	MESH_NODE
 		}
 	}
 
-	void SetIndexBit( const size_t indexCount)
+	// CfbNXł͂Ȃ, QƂő̒_ԍŌ߂.
+	// 0xffffDirectXMeshgpɂlȂ̂16bitł͎gȂ
+	void SetIndexBit( const size_t indexCount, const uint32_t maxIndex)
 	{
-#if 0
 		if(indexCount==0)
 			m_indexBit = INDEX_NOINDEX;
-		else if(indexCount < 0xffff)
+		else if(maxIndex < 0xffff)
 			m_indexBit = INDEX_16BIT;
-		else if(indexCount >=  0xffff)
-			m_indexBit = INDEX_32BIT;
-#else
-		// A16bitCfbNXΉ͂܂
-		m_indexBit = INDEX_NOINDEX;
-		if(indexCount!=0)
+		else
 			m_indexBit = INDEX_32BIT;
-#endif
 	};
+
+	uint32_t GetIndexStride() const
+	{
+		return m_indexBit==INDEX_16BIT ? sizeof(uint16_t) : sizeof(uint32_t);
+	}
+
+	// IASetVertexBuffers, IASetIndexBufferɓnoCgItZbg
+	UINT GetVertexOffset(const UINT stride) const { return vertexStart * stride; }
+	UINT GetIndexOffset() const { return indexStart * GetIndexStride(); }
 };
 
 class CFBXRenderDX11
 {
 	CFBXLoader*		m_pFBX;
+	unsigned int	m_loadThreadCount;
+	float			m_animationSampleRate;
+	float			m_animationTolerance;
+	bool			m_useMeshCache;
+	bool			m_packedUpload;
+	bool			m_asyncTextureLoad;
+	size_t			m_pendingTextureCount;	// pendingTexturecĂ}eA̐
+
+	CFBXVertexLayout	m_vertexLayout;
+	CFBXScratchArena	m_scratch;		// CreateNodes̍Ɨ̈. m[hReset
+
+	// foCXœǂݍ񂾃fŜŋL
+	std::shared_ptr<CFBXStateCache>	m_pStateCache;
+	uint32_t						m_stateCacheHitBase;	// ǂݍ݊JnGetHitCount
+	FBX_TEXTURE_CACHE_STATS			m_textureStatsBase;		// ǂݍ݊JñeNX`LbV̓v
+
+	std::string		m_sourceDirectory;		// ǂݍݒFBX̃fBNg. eNX`͂T
+
+	// ꊇAbv[hp. FlushPackedUpload܂őSm[h̒_ECfbNX𗭂߂Ă
+	std::vector<BYTE>		m_packedVertices;
+	std::vector<uint32_t>	m_packedIndices;
+
+	FBX_LOAD_STATS	m_loadStats;
 	
 	std::vector<MESH_NODE>	m_meshNodeArray;
 
-	HRESULT CreateNodes(ID3D11Device*	pd3dDevice, ID3D11DeviceContext*	pd3dContext, const bool isOptimize);
-	HRESULT VertexConstruction(ID3D11Device*	pd3dDevice,FBX_MESH_NODE &fbxNode, MESH_NODE& meshNode);
-	HRESULT VertexConstructionWithOptimize(ID3D11Device*	pd3dDevice, ID3D11DeviceContext* pContext, FBX_MESH_NODE &fbxNode, MESH_NODE& meshNode);
-	HRESULT MaterialConstruction(ID3D11Device*	pd3dDevice,FBX_MESH_NODE &fbxNode,  MESH_NODE& meshNode);
+	HRESULT CreateNodes(ID3D11Device*	pd3dDevice, ID3D11DeviceContext*	pd3dContext, const bool isOptimize, CFBXMeshCacheWriter* pCacheWriter);
+	HRESULT CreateNodesFromCache(ID3D11Device*	pd3dDevice, const CFBXMeshCache& cache);
+	HRESULT VertexConstruction(ID3D11Device*	pd3dDevice, const FBX_MESH_NODE &fbxNode, MESH_NODE& meshNode, FBX_MESH_CACHE_SOURCE_NODE* pCacheNode);
+	HRESULT IndexConstruction(ID3D11Device*	pd3dDevice, const FBX_MESH_NODE &fbxNode, MESH_NODE& meshNode, FBX_MESH_CACHE_SOURCE_NODE* pCacheNode);
+	size_t GetScratchSize(const FBX_MESH_NODE& fbxNode) const;
+	HRESULT VertexConstructionWithOptimize(ID3D11Device*	pd3dDevice, ID3D11DeviceContext* pContext, const FBX_MESH_NODE &fbxNode, MESH_NODE& meshNode, FBX_MESH_CACHE_SOURCE_NODE* pCacheNode);
+	// index_tuint16_tuint32_t. DirectXMesh̓^̃I[o[[hōœK
+	template<typename index_t>
+	HRESULT OptimizeMesh(ID3D11Device*	pd3dDevice, const FBX_MESH_NODE &fbxNode, MESH_NODE& meshNode, FBX_MESH_CACHE_SOURCE_NODE* pCacheNode);
+	HRESULT MaterialConstruction(ID3D11Device*	pd3dDevice, const FBX_MESH_NODE &fbxNode,  MESH_NODE& meshNode);
+	HRESULT MaterialConstruction(ID3D11Device*	pd3dDevice, const FBX_MATERIAL_NODE &fbxMaterial,  MATERIAL_DATA& materialData);
+	void SetMaterial(ID3D11DeviceContext* pImmediateContext, const MESH_NODE& meshNode, const uint32_t materialId);
+	void BuildVertexData(const FBX_MESH_NODE& fbxNode, VERTEX_DATA* pV);
+	void CountBufferStats();
+	void AssignSortIds();
+	HRESULT AcquireStateCache(ID3D11Device* pd3dDevice);
+
+	HRESULT CreateVertexBuffer( ID3D11Device*	pd3dDevice, ID3D11Buffer** pBuffer, const void* pVertices, uint32_t stride, uint32_t vertexCount );
+	// pIndicesindexStride(24)oCgł
+	HRESULT CreateIndexBuffer( ID3D11Device*	pd3dDevice, ID3D11Buffer** pBuffer, const void* pIndices, uint32_t indexStride, uint32_t indexCount );
+
+	// VERTEX_DATAm_vertexLayouť`ɕϊăAbv[h, p̒萔obt@
+	HRESULT UploadVertexData( ID3D11Device*	pd3dDevice, MESH_NODE& meshNode, const VERTEX_DATA* pVertices, uint32_t vertexCount, FBX_MESH_CACHE_SOURCE_NODE* pCacheNode );
+	HRESULT CreateDequantBuffer( ID3D11Device*	pd3dDevice, MESH_NODE& meshNode );
 
-	HRESULT CreateVertexBuffer( ID3D11Device*	pd3dDevice, ID3D11Buffer** pBuffer, void* pVertices, uint32_t stride, uint32_t vertexCount );
-	HRESULT CreateIndexBuffer( ID3D11Device*	pd3dDevice, ID3D11Buffer** pBuffer, void* pIndices, uint32_t indexCount );
+	// m_packedUploadȂm[h̒_ECfbNX𗭂߂邾, obt@FlushPackedUploadł܂Ƃ߂č
+	HRESULT UploadVertices( ID3D11Device*	pd3dDevice, MESH_NODE& meshNode, const void* pVertices, uint32_t vertexCount );
+	HRESULT UploadIndices( ID3D11Device*	pd3dDevice, MESH_NODE& meshNode, const void* pIndices, uint32_t indexStride, uint32_t indexCount );
+	HRESULT FlushPackedUpload( ID3D11Device*	pd3dDevice );
 
 public:
 	CFBXRenderDX11();
@@ -171,18 +258,60 @@ public:
 	void Release();
 
 	HRESULT LoadFBX(const char* filename, ID3D11Device*	pd3dDevice, ID3D11DeviceContext*	pd3dContext, const bool isOptimize = true);
-	HRESULT CreateInputLayout(ID3D11Device*	pd3dDevice, const void* pShaderBytecodeWithInputSignature, size_t BytecodeLength, D3D11_INPUT_ELEMENT_DESC* pLayout, unsigned int layoutSize);
+	// LoadFBX(SetMeshCacheEnableL)o.meshcache𒼐ړǂݍ. FBX SDKFBXgȂ
+	HRESULT LoadBakedMesh(const char* filename, ID3D11Device*	pd3dDevice);
+	void SetLoadThreadCount(const unsigned int threadCount){ m_loadThreadCount = threadCount; }	// CFBXLoader::SetThreadCountQ
+	void SetAnimationSampleRate(const float sampleRate){ m_animationSampleRate = sampleRate; }	// CFBXLoader::SetAnimationSampleRateQ
+	void SetAnimationCompression(const float tolerance){ m_animationTolerance = tolerance; }	// CFBXLoader::SetAnimationCompressionQ
+	// LoadFBXŏĂ񂾃Aj[V. m[h̕тGetNodeƓ. LoadBakedMesh(LbV̓ǂݍ)łnullptr
+	const CFBXAnimation* GetAnimation() const { return m_pFBX ? m_pFBX->GetAnimation() : nullptr; }
+	// [_[̃m[h(XLEFCg{[Ȃ, CFBXSkinningɓn). LoadBakedMeshłnullptr
+	const FBX_MESH_NODE* GetSourceNode(const size_t id) const { return (m_pFBX && id < m_pFBX->GetNodesCount()) ? &m_pFBX->GetNode(static_cast<unsigned int>(id)) : nullptr; }
+	// LɂFBXׂ̗ɍœKς݃bṼLbVo, 񂩂FBX SDKʂɓǂݍ.
+	// Aj[VXL̂V[GetAnimation, GetSourceNodê߂ɃLbVgȂ
+	void SetMeshCacheEnable(const bool enable){ m_useMeshCache = enable; }
+	// Lɂƃf̑Sm[h1̒_obt@1̃CfbNXobt@ɋl߂č(CreateBuffer 2)
+	void SetPackedUpload(const bool enable){ m_packedUpload = enable; }
+	// LɂƃeNX`͉SRVœǂݍ݂I, t@C̓ǂݍ݂ƍ쐬̓[J[Xbhōs.
+	// `XbhUpdateTexturesĂœւ
+	void SetAsyncTextureLoad(const bool enable){ m_asyncTextureLoad = enable; }
+	// LɂƃbV\z̍Ɣz1q[vmۂ(Ɨ̈g񂳂ȂꍇƂ̔rp. CFBXScratchArena::SetHeapMode)
+	void SetScratchHeapMode(const bool enable){ m_scratch.SetHeapMode(enable); }
+	// ǂݍ݂̏IeNX`SRVƓւ, ܂ǂݍݒ̐Ԃ. t[Ăł悢
+	size_t UpdateTextures();
+	// foCXŗ܂ĂeNX`̓ǂݍ݂S҂Ăւ
+	void WaitTextures();
+	// _obt@̌`. LoadFBX/LoadBakedMesh̑Oɐݒ肷.
+	// ̓CAEgGetVertexLayout().GetInputElementDesc()ō
+	void SetVertexFormat(const FBX_VERTEX_FORMAT& format){ m_vertexLayout.Compile(format); }
+	const CFBXVertexLayout& GetVertexLayout() const { return m_vertexLayout; }
+	// OLoadFBX/LoadBakedMesh̒iKƂ̎ԂƃJE^. ToJSON/WriteJSONŃpCvCɓn
+	const FBX_LOAD_STATS& GetLoadStats() const { return m_loadStats; }
+	// ̓CAEgCFBXStateCachê, vfEVF[_ȂSm[h, Sf1ɂȂ
+	HRESULT CreateInputLayout(ID3D11Device*	pd3dDevice, const void* pShaderBytecodeWithInputSignature, size_t BytecodeLength, const D3D11_INPUT_ELEMENT_DESC* pLayout, unsigned int layoutSize);
+	const CFBXStateCache* GetStateCache() const { return m_pStateCache.get(); }
 
+	// TuZbgɃ}eA(SRV, 萔obt@, Tv[)sNZVF[_̃Xbg0,
+	// _̕p萔(VERTEX_DEQUANT_DATA)𒸓_VF[_b1ɐݒ肵ĕ`悷.
+	// ̃fEm[h܂Ƃ߂ĕ`CFBXRenderQueueg
 	HRESULT RenderAll( ID3D11DeviceContext* pImmediateContext);
 	HRESULT RenderNode( ID3D11DeviceContext* pImmediateContext, const size_t nodeId );
 	HRESULT RenderNodeInstancing( ID3D11DeviceContext* pImmediateContext, const size_t nodeId, const uint32_t InstanceCount );
+	// instancesSRV𒸓_VF[_t0ɐݒ肵, JOʂCX^X`悷(Updateς݂ł邱)
+	HRESULT RenderNodeInstancing( ID3D11DeviceContext* pImmediateContext, const size_t nodeId, const CFBXInstanceBuffer& instances );
 	HRESULT RenderNodeInstancingIndirect( ID3D11DeviceContext* pImmediateContext, const size_t nodeId, ID3D11Buffer* pBufferForArgs,  const uint32_t AlignedByteOffsetForArgs );
 
-	size_t GetNodeCount(){ return m_meshNodeArray.size(); }
+	size_t GetNodeCount() const { return m_meshNodeArray.size(); }
 
-	MESH_NODE& GetNode( const int id ){ return m_meshNodeArray[id]; };
-	void	GetNodeMatrix( const int id, float* mat4x4 ){ memcpy(mat4x4, m_meshNodeArray[id].mat4x4, sizeof(float)*16); };
-	MATERIAL_DATA& GetNodeMaterial( const size_t id ){ return m_meshNodeArray[id].materialData; };
+	const MESH_NODE& GetNode( const int id ) const { return m_meshNodeArray[id]; };
+	void	GetNodeMatrix( const int id, float* mat4x4 ) const { memcpy(mat4x4, m_meshNodeArray[id].mat4x4, sizeof(float)*16); };
+	int		GetNodeParent( const size_t id ) const { return m_meshNodeArray[id].parentId; };
+	const FBX_BOUNDS& GetNodeBounds( const size_t id ) const { return m_meshNodeArray[id].bounds; };
+	const VERTEX_DEQUANT_DATA& GetNodeDequant( const size_t id ) const { return m_meshNodeArray[id].dequant; };
+	size_t	GetNodeMaterialCount( const size_t id ) const { return m_meshNodeArray[id].materialArray.size(); };
+	const MATERIAL_DATA& GetNodeMaterial( const size_t id, const size_t materialId ) const { return m_meshNodeArray[id].materialArray[materialId]; };
+	size_t	GetNodeSubsetCount( const size_t id ) const { return m_meshNodeArray[id].subsetArray.size(); };
+	const MESH_SUBSET& GetNodeSubset( const size_t id, const size_t subsetId ) const { return m_meshNodeArray[id].subsetArray[subsetId]; };
 };
 
 }	// namespace FBX_LOADER
\ No newline at end of file
@@ -0,0 +1,112 @@
+// *********************************************************************************************************************
+///
+/// @file 		CFBXScratchArena.cpp
+/// @brief		bV\z̈ꎞ̈(m[hResetĎg)
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#include "CFBXScratchArena.h"
+
+#include <malloc.h>
+
+namespace FBX_LOADER
+{
+
+CFBXScratchArena::CFBXScratchArena()
+{
+	m_pBuffer = nullptr;
+	m_capacity = 0;
+	m_used = 0;
+	m_peak = 0;
+	m_heapAllocCount = 0;
+	m_isHeapMode = false;
+}
+
+CFBXScratchArena::~CFBXScratchArena()
+{
+	Release();
+}
+
+void CFBXScratchArena::Release()
+{
+	Reset();
+
+	if(m_pBuffer)
+	{
+		_aligned_free(m_pBuffer);
+		m_pBuffer = nullptr;
+	}
+	m_capacity = 0;
+	m_used = 0;
+	m_peak = 0;
+}
+
+void CFBXScratchArena::SetHeapMode(const bool isHeapMode)
+{
+	Reset();
+	m_isHeapMode = isHeapMode;
+	if(m_isHeapMode)
+		m_heapBlockArray.reserve(16);	// 1m[hŐ؂o葽߂. Ǘp̔z̊mۂ͐ɓꂽȂ
+}
+
+void CFBXScratchArena::Reset()
+{
+	for(size_t i=0;i<m_heapBlockArray.size();i++)
+		_aligned_free(m_heapBlockArray[i]);
+	m_heapBlockArray.clear();
+
+	m_used = 0;
+}
+
+bool CFBXScratchArena::Reserve(const size_t capacity)
+{
+	Reset();
+	if(m_isHeapMode || capacity <= m_capacity)
+		return true;
+
+	Release();
+
+	m_pBuffer = static_cast<uint8_t*>(_aligned_malloc(capacity, 16));
+	if(!m_pBuffer)
+		return false;
+
+	m_capacity = capacity;
+	m_heapAllocCount++;
+	return true;
+}
+
+void* CFBXScratchArena::Allocate(const size_t size, const size_t alignment)
+{
+	if(m_isHeapMode)
+	{
+		void* pBlock = _aligned_malloc(size > 0 ? size : 1, alignment);
+		if(!pBlock)
+			return nullptr;
+
+		m_heapBlockArray.push_back(pBlock);
+		m_heapAllocCount++;
+		m_used += size;
+		if(m_used > m_peak)
+			m_peak = m_used;
+		return pBlock;
+	}
+
+	if(!m_pBuffer)
+		return nullptr;
+
+	const size_t mask = alignment - 1;
+	const size_t begin = (m_used + mask) & ~mask;
+	if(begin > m_capacity || size > m_capacity - begin)
+		return nullptr;
+
+	m_used = begin + size;
+	if(m_used > m_peak)
+		m_peak = m_used;
+
+	return m_pBuffer + begin;
+}
+
+}	// namespace FBX_LOADER
@@ -0,0 +1,69 @@
+// *********************************************************************************************************************
+///
+/// @file 		CFBXScratchArena.h
+/// @brief		bV\z̈ꎞ̈(m[hResetĎg)
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+namespace FBX_LOADER
+{
+
+// 擪l߂Đ؂ö̗. ʂ͖̉, ResetőS܂Ƃ߂Ė߂.
+// 1f̍őTCYŏReserveĂ, ȍ~̃m[hł̓q[vgȂ.
+// XbhԂŋLȂ(ǂݍ݃Xbh1)
+class CFBXScratchArena
+{
+	uint8_t*	m_pBuffer;
+	size_t		m_capacity;
+	size_t		m_used;
+	size_t		m_peak;				// Reserve܂ł̍őgp
+	uint32_t	m_heapAllocCount;	// obt@mۂ
+	bool		m_isHeapMode;
+	std::vector<void*>	m_heapBlockArray;	// q[v[hŐ؂ö. Resetŉ
+
+	CFBXScratchArena(const CFBXScratchArena&);
+	CFBXScratchArena& operator=(const CFBXScratchArena&);
+
+public:
+	CFBXScratchArena();
+	~CFBXScratchArena();
+
+	void Release();
+
+	// Allocate̓xɃq[vʁXɊmۂ(Reservë͎gȂ).
+	// ƔzʂnewĂꍇƂ̊mۉ񐔂̔r, y[Wq[vł͂ݏo邽
+	void SetHeapMode(const bool isHeapMode);
+	bool IsHeapMode() const { return m_isHeapMode; }
+
+	// capacityɑȂΊmۂ. ؂oς݂̗͖̈ɂȂ̂ResetɌĂ
+	bool Reserve(const size_t capacity);
+	void Reset();
+
+	// eʂȂnullptr(ȂmۂƂ͂Ȃ)
+	void* Allocate(const size_t size, const size_t alignment = 16);
+
+	template<typename T>
+	T* Allocate(const size_t count)
+	{
+		return static_cast<T*>(Allocate(sizeof(T) * count));
+	}
+
+	size_t		GetCapacity() const { return m_capacity; }
+	size_t		GetUsed() const { return m_used; }
+	size_t		GetPeak() const { return m_peak; }
+	uint32_t	GetHeapAllocCount() const { return m_heapAllocCount; }
+
+	// Allocate 1񂠂̍ő̋lߕ(ςɑ)
+	static size_t GetAllocationOverhead(const size_t alignment = 16) { return alignment - 1; }
+};
+
+}	// namespace FBX_LOADER
@@ -0,0 +1,127 @@
+// *********************************************************************************************************************
+///
+/// @file 		CFBXSkinning.cpp
+/// @brief		XLbṼ{[spbǧvZCPUXLjO
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#include "CFBXSkinning.h"
+
+namespace FBX_LOADER
+{
+
+// oCh|[YłinverseBind * boneGlobal * meshGlobal^-1PʍsɂȂ
+void CFBXSkinning::UpdatePalette(const FBX_MESH_NODE& meshNode, const DirectX::XMFLOAT4X4& meshMatrix, const DirectX::XMFLOAT4X4* pNodeMatrices)
+{
+	using namespace DirectX;
+
+	const size_t boneCount = meshNode.m_boneArray.size();
+	m_paletteArray.resize(boneCount);
+	if(boneCount==0 || !pNodeMatrices)
+		return ;
+
+	XMVECTOR determinant;
+	const XMMATRIX meshInverse = XMMatrixInverse(&determinant, XMLoadFloat4x4(&meshMatrix));
+
+	for(size_t i=0;i<boneCount;i++)
+	{
+		const FBX_SKIN_BONE& bone = meshNode.m_boneArray[i];
+
+		// {[̃m[hΓȂ
+		if(bone.nodeId < 0)
+		{
+			m_paletteArray[i] = XMMatrixIdentity();
+			continue;
+		}
+
+		const XMMATRIX inverseBind = XMLoadFloat4x4(reinterpret_cast<const XMFLOAT4X4*>(bone.inverseBind));
+		const XMMATRIX boneGlobal = XMLoadFloat4x4(&pNodeMatrices[bone.nodeId]);
+		m_paletteArray[i] = XMMatrixMultiply(XMMatrixMultiply(inverseBind, boneGlobal), meshInverse);
+	}
+}
+
+void CFBXSkinning::Skin(const FBX_MESH_NODE& meshNode)
+{
+	const size_t vertexCount = meshNode.m_positionArray.size();
+	m_positionArray.resize(vertexCount);
+	m_normalArray.resize(meshNode.m_normalArray.size()==vertexCount ? vertexCount : 0);
+	if(vertexCount==0)
+		return ;
+
+	// XL(܂̓pbg)Ȃ猳̂܂
+	if(meshNode.m_skinArray.size()!=vertexCount || m_paletteArray.empty())
+	{
+		m_positionArray = meshNode.m_positionArray;
+		if(!m_normalArray.empty())
+			m_normalArray = meshNode.m_normalArray;
+		return ;
+	}
+
+	const bool hasNormal = !m_normalArray.empty();
+	SkinVertices(&meshNode.m_positionArray[0], hasNormal ? &meshNode.m_normalArray[0] : nullptr, &meshNode.m_skinArray[0],
+		vertexCount, &m_paletteArray[0], &m_positionArray[0], hasNormal ? &m_normalArray[0] : nullptr);
+}
+
+// EFCg͑傫ɕł̂, 0o炻őł؂.
+// s̍s4{XMVECTORɎ, ʒuxyz1, @xyz0ƂĊ|
+void CFBXSkinning::SkinVertices(const FBX_FLOAT3* pPositions, const FBX_FLOAT3* pNormals, const FBX_SKIN_WEIGHT* pSkins,
+	const size_t vertexCount, const DirectX::XMMATRIX* pPalette, FBX_FLOAT3* pOutPositions, FBX_FLOAT3* pOutNormals)
+{
+	using namespace DirectX;
+
+	static_assert(sizeof(FBX_FLOAT3) == sizeof(XMFLOAT3), "FBX_FLOAT3 must match XMFLOAT3");
+
+	const float weightScale = 1.0f / 255.0f;
+	const bool hasNormal = pNormals && pOutNormals;
+
+	for(size_t v=0;v<vertexCount;v++)
+	{
+		const FBX_SKIN_WEIGHT& skin = pSkins[v];
+		const XMVECTOR position = XMLoadFloat3(reinterpret_cast<const XMFLOAT3*>(&pPositions[v]));
+
+		// ǂ̃{[ɂȂ_͂̂܂
+		if(skin.weight[0]==0)
+		{
+			pOutPositions[v] = pPositions[v];
+			if(hasNormal)
+				pOutNormals[v] = pNormals[v];
+			continue;
+		}
+
+		const XMMATRIX& m0 = pPalette[skin.index[0]];
+		XMVECTOR weight = XMVectorReplicate(static_cast<float>(skin.weight[0]) * weightScale);
+		XMVECTOR r0 = XMVectorMultiply(m0.r[0], weight);
+		XMVECTOR r1 = XMVectorMultiply(m0.r[1], weight);
+		XMVECTOR r2 = XMVectorMultiply(m0.r[2], weight);
+		XMVECTOR r3 = XMVectorMultiply(m0.r[3], weight);
+
+		for(unsigned int i=1;i<FBX_SKIN_INFLUENCE_MAX && skin.weight[i]!=0;i++)
+		{
+			const XMMATRIX& m = pPalette[skin.index[i]];
+			weight = XMVectorReplicate(static_cast<float>(skin.weight[i]) * weightScale);
+			r0 = XMVectorMultiplyAdd(m.r[0], weight, r0);
+			r1 = XMVectorMultiplyAdd(m.r[1], weight, r1);
+			r2 = XMVectorMultiplyAdd(m.r[2], weight, r2);
+			r3 = XMVectorMultiplyAdd(m.r[3], weight, r3);
+		}
+
+		XMVECTOR result = XMVectorMultiplyAdd(XMVectorSplatZ(position), r2, r3);
+		result = XMVectorMultiplyAdd(XMVectorSplatY(position), r1, result);
+		result = XMVectorMultiplyAdd(XMVectorSplatX(position), r0, result);
+		XMStoreFloat3(reinterpret_cast<XMFLOAT3*>(&pOutPositions[v]), result);
+
+		if(hasNormal)
+		{
+			const XMVECTOR normal = XMLoadFloat3(reinterpret_cast<const XMFLOAT3*>(&pNormals[v]));
+			XMVECTOR n = XMVectorMultiply(XMVectorSplatZ(normal), r2);
+			n = XMVectorMultiplyAdd(XMVectorSplatY(normal), r1, n);
+			n = XMVectorMultiplyAdd(XMVectorSplatX(normal), r0, n);
+			XMStoreFloat3(reinterpret_cast<XMFLOAT3*>(&pOutNormals[v]), XMVector3Normalize(n));
+		}
+	}
+}
+
+}	// namespace FBX_LOADER
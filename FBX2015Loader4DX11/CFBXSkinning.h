@@ -0,0 +1,51 @@
+// *********************************************************************************************************************
+///
+/// @file 		CFBXSkinning.h
+/// @brief		XLbṼ{[spbǧvZCPUXLjO
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#pragma once
+
+#include <vector>
+
+#include <DirectXMath.h>
+
+#include "CFBXLoader.h"
+
+namespace FBX_LOADER
+{
+
+typedef std::vector<DirectX::XMMATRIX, ALIGNED_ALLOCATOR<DirectX::XMMATRIX>>	FBX_MATRIX_STREAM;
+
+// {[śubV̍W  {[  ̃|[Ył̃bV̍WvȂ̂, XLjO_ɂ
+// `掞ɂ͂̂܂܃bṼm[hs(CFBXRenderQueuẽm[hs)|΂悢.
+// GPUōsꍇpbgBLENDINDICES/BLENDWEIGHT(FBX_SKIN_UINT8_UNORM8)Ƒgݍ킹Ďg
+class CFBXSkinning
+{
+	FBX_MATRIX_STREAM	m_paletteArray;
+	FBX_FLOAT3_STREAM	m_positionArray;
+	FBX_FLOAT3_STREAM	m_normalArray;
+
+public:
+	// pNodeMatrices͑Sm[h̃O[os(CFBXAnimation::SamplěʂȂ, GetNodeƓ).
+	// meshMatrix̓bṼm[h̓̃O[os
+	void UpdatePalette(const FBX_MESH_NODE& meshNode, const DirectX::XMFLOAT4X4& meshMatrix, const DirectX::XMFLOAT4X4* pNodeMatrices);
+
+	// OUpdatePaletteőS_ό`, GetPositions/GetNormalsɒu
+	void Skin(const FBX_MESH_NODE& meshNode);
+
+	// _ɃEFCgōsĂʒuƖ@ό`. ͈͂𕪂ΕXbhŌĂׂ.
+	// pNormals/pOutNormalsnullptrł悢
+	static void SkinVertices(const FBX_FLOAT3* pPositions, const FBX_FLOAT3* pNormals, const FBX_SKIN_WEIGHT* pSkins,
+		const size_t vertexCount, const DirectX::XMMATRIX* pPalette, FBX_FLOAT3* pOutPositions, FBX_FLOAT3* pOutNormals);
+
+	const FBX_MATRIX_STREAM& GetPalette() const { return m_paletteArray; }
+	const FBX_FLOAT3_STREAM& GetPositions() const { return m_positionArray; }
+	const FBX_FLOAT3_STREAM& GetNormals() const { return m_normalArray; }
+};
+
+}	// namespace FBX_LOADER
@@ -0,0 +1,272 @@
+// *********************************************************************************************************************
+///
+/// @file 		CFBXStateCache.cpp
+/// @brief		foCXɋL̓CAEg, Tv[, }eAE_̒萔obt@̃LbV
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#include "CFBXStateCache.h"
+
+#include <map>
+#include <string.h>
+
+namespace FBX_LOADER
+{
+
+static const uint64_t FNV_OFFSET_BASIS_64 = 14695981039346656037ULL;
+static const uint64_t FNV_PRIME_64 = 1099511628211ULL;
+
+static uint64_t HashBytes(const void* pData, const size_t size)
+{
+	const uint8_t* p = static_cast<const uint8_t*>(pData);
+	uint64_t hash = FNV_OFFSET_BASIS_64;
+	for(size_t i=0;i<size;i++)
+	{
+		hash ^= p[i];
+		hash *= FNV_PRIME_64;
+	}
+	return hash;
+}
+
+// aSemanticName͎g킸semanticNameƔׂ
+static bool IsSameElement(const D3D11_INPUT_ELEMENT_DESC& a, const std::string& semanticName, const D3D11_INPUT_ELEMENT_DESC& b)
+{
+	return semanticName == b.SemanticName
+		&& a.SemanticIndex == b.SemanticIndex
+		&& a.Format == b.Format
+		&& a.InputSlot == b.InputSlot
+		&& a.AlignedByteOffset == b.AlignedByteOffset
+		&& a.InputSlotClass == b.InputSlotClass
+		&& a.InstanceDataStepRate == b.InstanceDataStepRate;
+}
+
+// foCX  LbV. p҂ȂȂLbV͎GetŎ菜
+static std::mutex g_cacheMapMutex;
+static std::map<ID3D11Device*, std::weak_ptr<CFBXStateCache>> g_cacheMap;
+
+std::shared_ptr<CFBXStateCache> CFBXStateCache::Get(ID3D11Device* pd3dDevice)
+{
+	if(!pd3dDevice)
+		return std::shared_ptr<CFBXStateCache>();
+
+	std::lock_guard<std::mutex> lock(g_cacheMapMutex);
+
+	for(auto it = g_cacheMap.begin(); it != g_cacheMap.end();)
+	{
+		if(it->second.expired())
+			it = g_cacheMap.erase(it);
+		else
+			++it;
+	}
+
+	auto it = g_cacheMap.find(pd3dDevice);
+	if(it != g_cacheMap.end())
+		return it->second.lock();
+
+	std::shared_ptr<CFBXStateCache> cache = std::make_shared<CFBXStateCache>(pd3dDevice);
+	g_cacheMap[pd3dDevice] = cache;
+	return cache;
+}
+
+CFBXStateCache::CFBXStateCache(ID3D11Device* pd3dDevice)
+	: m_textureCache(pd3dDevice)
+{
+	// LbVĂԂ͓AhXɕʂ̃foCXȂ悤ɎQƂ
+	m_pDevice = pd3dDevice;
+	m_pDevice->AddRef();
+	m_hitCount = 0;
+}
+
+CFBXStateCache::~CFBXStateCache()
+{
+	for(size_t i=0;i<m_inputLayoutArray.size();i++)
+		m_inputLayoutArray[i].pInputLayout->Release();
+	for(size_t i=0;i<m_samplerArray.size();i++)
+		m_samplerArray[i].pSampler->Release();
+	for(size_t i=0;i<m_materialBufferArray.size();i++)
+		m_materialBufferArray[i].pBuffer->Release();
+	for(size_t i=0;i<m_dequantBufferArray.size();i++)
+		m_dequantBufferArray[i].pBuffer->Release();
+	m_textureCache.Release();
+
+	m_pDevice->Release();
+}
+
+HRESULT CFBXStateCache::GetInputLayout(const D3D11_INPUT_ELEMENT_DESC* pLayout, const UINT layoutSize,
+	const void* pShaderBytecodeWithInputSignature, const size_t bytecodeLength, ID3D11InputLayout** ppInputLayout,
+	uint32_t* pLayoutId)
+{
+	if(!pLayout || !pShaderBytecodeWithInputSignature || !ppInputLayout)
+		return E_FAIL;
+
+	const uint64_t signatureHash = HashBytes(pShaderBytecodeWithInputSignature, bytecodeLength);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	for(size_t i=0;i<m_inputLayoutArray.size();i++)
+	{
+		const INPUT_LAYOUT_ENTRY& entry = m_inputLayoutArray[i];
+		if(entry.signatureHash != signatureHash || entry.signatureLength != bytecodeLength || entry.elementArray.size() != layoutSize)
+			continue;
+
+		UINT e = 0;
+		while(e < layoutSize && IsSameElement(entry.elementArray[e], entry.semanticArray[e], pLayout[e]))
+			e++;
+		if(e != layoutSize)
+			continue;
+
+		*ppInputLayout = entry.pInputLayout;
+		entry.pInputLayout->AddRef();
+		if(pLayoutId)
+			*pLayoutId = static_cast<uint32_t>(i) + 1;
+		m_hitCount++;
+		return S_OK;
+	}
+
+	ID3D11InputLayout* pInputLayout = nullptr;
+	HRESULT hr = m_pDevice->CreateInputLayout(pLayout, layoutSize, pShaderBytecodeWithInputSignature, bytecodeLength, &pInputLayout);
+	if(FAILED(hr))
+		return hr;
+
+	m_inputLayoutArray.push_back(INPUT_LAYOUT_ENTRY());
+	INPUT_LAYOUT_ENTRY& entry = m_inputLayoutArray.back();
+	entry.elementArray.assign(pLayout, pLayout + layoutSize);
+	entry.semanticArray.resize(layoutSize);
+	for(UINT e=0;e<layoutSize;e++)
+	{
+		// Ăяo͎̕cȂȂ̂ŖO̓Rs[Ď
+		entry.semanticArray[e] = pLayout[e].SemanticName;
+		entry.elementArray[e].SemanticName = nullptr;
+	}
+	entry.signatureHash = signatureHash;
+	entry.signatureLength = bytecodeLength;
+	entry.pInputLayout = pInputLayout;
+
+	*ppInputLayout = pInputLayout;
+	pInputLayout->AddRef();
+	if(pLayoutId)
+		*pLayoutId = static_cast<uint32_t>(m_inputLayoutArray.size());
+
+	return hr;
+}
+
+HRESULT CFBXStateCache::GetSamplerState(const D3D11_SAMPLER_DESC& desc, ID3D11SamplerState** ppSampler)
+{
+	if(!ppSampler)
+		return E_FAIL;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	for(size_t i=0;i<m_samplerArray.size();i++)
+	{
+		if(memcmp(&m_samplerArray[i].desc, &desc, sizeof(desc))==0)
+		{
+			*ppSampler = m_samplerArray[i].pSampler;
+			(*ppSampler)->AddRef();
+			m_hitCount++;
+			return S_OK;
+		}
+	}
+
+	SAMPLER_ENTRY entry;
+	entry.desc = desc;
+	entry.pSampler = nullptr;
+	HRESULT hr = m_pDevice->CreateSamplerState(&desc, &entry.pSampler);
+	if(FAILED(hr))
+		return hr;
+
+	m_samplerArray.push_back(entry);
+	*ppSampler = entry.pSampler;
+	entry.pSampler->AddRef();
+
+	return hr;
+}
+
+HRESULT CFBXStateCache::GetMaterialBuffer(const MATERIAL_CONSTANT_DATA& data, ID3D11Buffer** ppBuffer)
+{
+	if(!ppBuffer)
+		return E_FAIL;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	for(size_t i=0;i<m_materialBufferArray.size();i++)
+	{
+		if(memcmp(&m_materialBufferArray[i].data, &data, sizeof(data))==0)
+		{
+			*ppBuffer = m_materialBufferArray[i].pBuffer;
+			(*ppBuffer)->AddRef();
+			m_hitCount++;
+			return S_OK;
+		}
+	}
+
+	D3D11_BUFFER_DESC bufDesc;
+	ZeroMemory( &bufDesc, sizeof(bufDesc) );
+	bufDesc.Usage = D3D11_USAGE_IMMUTABLE;
+	bufDesc.ByteWidth = sizeof(MATERIAL_CONSTANT_DATA);
+	bufDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+
+	D3D11_SUBRESOURCE_DATA initData;
+	ZeroMemory( &initData, sizeof(initData) );
+	initData.pSysMem = &data;
+
+	MATERIAL_BUFFER_ENTRY entry;
+	entry.data = data;
+	entry.pBuffer = nullptr;
+	HRESULT hr = m_pDevice->CreateBuffer(&bufDesc, &initData, &entry.pBuffer);
+	if(FAILED(hr))
+		return hr;
+
+	m_materialBufferArray.push_back(entry);
+	*ppBuffer = entry.pBuffer;
+	entry.pBuffer->AddRef();
+
+	return hr;
+}
+
+HRESULT CFBXStateCache::GetDequantBuffer(const VERTEX_DEQUANT_DATA& data, ID3D11Buffer** ppBuffer)
+{
+	if(!ppBuffer)
+		return E_FAIL;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	for(size_t i=0;i<m_dequantBufferArray.size();i++)
+	{
+		if(memcmp(&m_dequantBufferArray[i].data, &data, sizeof(data))==0)
+		{
+			*ppBuffer = m_dequantBufferArray[i].pBuffer;
+			(*ppBuffer)->AddRef();
+			m_hitCount++;
+			return S_OK;
+		}
+	}
+
+	D3D11_BUFFER_DESC bufDesc;
+	ZeroMemory( &bufDesc, sizeof(bufDesc) );
+	bufDesc.Usage = D3D11_USAGE_IMMUTABLE;
+	bufDesc.ByteWidth = sizeof(VERTEX_DEQUANT_DATA);
+	bufDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+
+	D3D11_SUBRESOURCE_DATA initData;
+	ZeroMemory( &initData, sizeof(initData) );
+	initData.pSysMem = &data;
+
+	DEQUANT_BUFFER_ENTRY entry;
+	entry.data = data;
+	entry.pBuffer = nullptr;
+	HRESULT hr = m_pDevice->CreateBuffer(&bufDesc, &initData, &entry.pBuffer);
+	if(FAILED(hr))
+		return hr;
+
+	m_dequantBufferArray.push_back(entry);
+	*ppBuffer = entry.pBuffer;
+	entry.pBuffer->AddRef();
+
+	return hr;
+}
+
+}	// namespace FBX_LOADER
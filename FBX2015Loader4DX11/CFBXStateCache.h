@@ -0,0 +1,112 @@
+// *********************************************************************************************************************
+///
+/// @file 		CFBXStateCache.h
+/// @brief		foCXɋL̓CAEg, Tv[, }eAE_̒萔obt@̃LbV
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+
+#include <d3d11.h>
+#include <DirectXMath.h>
+
+#include "CFBXTextureCache.h"
+#include "CFBXVertexFormat.h"
+
+namespace FBX_LOADER
+{
+
+struct MATERIAL_CONSTANT_DATA
+{
+	DirectX::XMFLOAT4	ambient;
+	DirectX::XMFLOAT4	diffuse;
+	DirectX::XMFLOAT4	specular;
+	DirectX::XMFLOAT4	emmisive;
+};
+
+// gXe[gIuWFNg1ɂ܂Ƃ߂. foCXgCFBXRenderDX11͑SēCX^XL.
+// Get*ŕԂIuWFNgAddRefς݂Ȃ̂, Ăяo͂܂ŒʂRelease.
+// LbVgQƂ̂, Ō̗p҂ȂȂ܂ō蒼Ȃ
+class CFBXStateCache
+{
+	// ̓CAEg͗vf̕тƃVF[_̓̓VOl`(oCgR[h̃nbV)ŋʂ
+	struct INPUT_LAYOUT_ENTRY
+	{
+		std::vector<D3D11_INPUT_ELEMENT_DESC>	elementArray;		// SemanticNamenullptr. OsemanticArrayŔׂ
+		std::vector<std::string>				semanticArray;
+		uint64_t								signatureHash;
+		size_t									signatureLength;
+		ID3D11InputLayout*						pInputLayout;
+	};
+
+	struct SAMPLER_ENTRY
+	{
+		D3D11_SAMPLER_DESC		desc;
+		ID3D11SamplerState*		pSampler;
+	};
+
+	struct MATERIAL_BUFFER_ENTRY
+	{
+		MATERIAL_CONSTANT_DATA	data;
+		ID3D11Buffer*			pBuffer;
+	};
+
+	struct DEQUANT_BUFFER_ENTRY
+	{
+		VERTEX_DEQUANT_DATA		data;
+		ID3D11Buffer*			pBuffer;
+	};
+
+	ID3D11Device*						m_pDevice;
+	std::mutex							m_mutex;		// ʃXbhœǂݍCFBXRenderDX11Ă΂
+
+	std::vector<INPUT_LAYOUT_ENTRY>		m_inputLayoutArray;
+	std::vector<SAMPLER_ENTRY>			m_samplerArray;
+	std::vector<MATERIAL_BUFFER_ENTRY>	m_materialBufferArray;
+	std::vector<DEQUANT_BUFFER_ENTRY>	m_dequantBufferArray;
+
+	CFBXTextureCache					m_textureCache;
+
+	uint32_t							m_hitCount;
+
+	CFBXStateCache(const CFBXStateCache&);
+	CFBXStateCache& operator=(const CFBXStateCache&);
+
+public:
+	explicit CFBXStateCache(ID3D11Device* pd3dDevice);
+	~CFBXStateCache();
+
+	// pd3dDevicẽLbV. ΍(DirectXTKSharedResourcePoolƓ, p҂ȂȂΏ)
+	static std::shared_ptr<CFBXStateCache> Get(ID3D11Device* pd3dDevice);
+
+	ID3D11Device* GetDevice() const { return m_pDevice; }
+
+	// pLayoutIdɂ͂̃LbV̒ł̔ԍ(1)Ԃ. LbV܂œ̓CAEgɂ͓ԍ
+	HRESULT GetInputLayout(const D3D11_INPUT_ELEMENT_DESC* pLayout, const UINT layoutSize,
+		const void* pShaderBytecodeWithInputSignature, const size_t bytecodeLength, ID3D11InputLayout** ppInputLayout,
+		uint32_t* pLayoutId = nullptr);
+	HRESULT GetSamplerState(const D3D11_SAMPLER_DESC& desc, ID3D11SamplerState** ppSampler);
+	// ύXȂ(IMMUTABLE)萔obt@Ȃ̂, e}eAŋLł
+	HRESULT GetMaterialBuffer(const MATERIAL_CONSTANT_DATA& data, ID3D11Buffer** ppBuffer);
+	// IMMUTABLE. float32̈ʒũm[h͑SčPϊȂ̂1L
+	HRESULT GetDequantBuffer(const VERTEX_DEQUANT_DATA& data, ID3D11Buffer** ppBuffer);
+
+	CFBXTextureCache& GetTextureCache() { return m_textureCache; }
+
+	size_t GetInputLayoutCount() const { return m_inputLayoutArray.size(); }
+	size_t GetSamplerCount() const { return m_samplerArray.size(); }
+	size_t GetMaterialBufferCount() const { return m_materialBufferArray.size(); }
+	size_t GetDequantBufferCount() const { return m_dequantBufferArray.size(); }
+	uint32_t GetHitCount() const { return m_hitCount; }
+};
+
+}	// namespace FBX_LOADER
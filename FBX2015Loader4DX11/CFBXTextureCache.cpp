@@ -0,0 +1,521 @@
+// *********************************************************************************************************************
+///
+/// @file 		CFBXTextureCache.cpp
+/// @brief		eNX`̃LbV. pXƓeœeNX`1SRVɂ܂Ƃ߂
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#include "CFBXTextureCache.h"
+#include "DDSTextureLoader.h"
+
+#include <Windows.h>
+#include <wctype.h>
+
+namespace FBX_LOADER
+{
+
+static const uint64_t FNV_OFFSET_BASIS_64 = 14695981039346656037ULL;
+static const uint64_t FNV_PRIME_64 = 1099511628211ULL;
+
+static uint64_t HashBytes(const void* pData, const size_t size)
+{
+	const uint8_t* p = static_cast<const uint8_t*>(pData);
+	uint64_t hash = FNV_OFFSET_BASIS_64;
+	for(size_t i=0;i<size;i++)
+	{
+		hash ^= p[i];
+		hash *= FNV_PRIME_64;
+	}
+	return hash;
+}
+
+// FBX SDK̕UTF-8. Ât@CUTF-8Ƃēǂ߂ȂANSIƂ݂Ȃ
+static std::wstring ToWide(const std::string& str)
+{
+	if(str.empty())
+		return std::wstring();
+
+	UINT codePage = CP_UTF8;
+	int length = MultiByteToWideChar(codePage, MB_ERR_INVALID_CHARS, str.c_str(), static_cast<int>(str.size()), nullptr, 0);
+	if(length <= 0)
+	{
+		codePage = CP_ACP;
+		length = MultiByteToWideChar(codePage, 0, str.c_str(), static_cast<int>(str.size()), nullptr, 0);
+		if(length <= 0)
+			return std::wstring();
+	}
+
+	std::wstring wstr(length, L'\0');
+	MultiByteToWideChar(codePage, 0, str.c_str(), static_cast<int>(str.size()), &wstr[0], length);
+	return wstr;
+}
+
+static bool IsAbsolutePath(const std::wstring& path)
+{
+	return (path.size() >= 2 && path[1]==L':') || (path.size() >= 1 && (path[0]==L'\\' || path[0]==L'/'));
+}
+
+static bool FileExists(const std::wstring& path)
+{
+	const DWORD attribute = GetFileAttributesW(path.c_str());
+	return attribute != INVALID_FILE_ATTRIBUTES && !(attribute & FILE_ATTRIBUTE_DIRECTORY);
+}
+
+// ΃pXɂ'..', ؂'\', 啶ɑ(Windows̃pX͑啶ʂȂ)
+static std::wstring NormalizePath(const std::wstring& path)
+{
+	std::wstring fullPath = path;
+	const DWORD length = GetFullPathNameW(path.c_str(), 0, nullptr, nullptr);
+	if(length > 0)
+	{
+		fullPath.resize(length);
+		const DWORD written = GetFullPathNameW(path.c_str(), length, &fullPath[0], nullptr);
+		fullPath.resize(written < length ? written : 0);
+		if(fullPath.empty())
+			fullPath = path;
+	}
+
+	for(size_t i=0;i<fullPath.size();i++)
+	{
+		if(fullPath[i]==L'/')
+			fullPath[i] = L'\\';
+		else
+			fullPath[i] = towlower(fullPath[i]);
+	}
+	return fullPath;
+}
+
+static HRESULT ReadFileData(const std::wstring& path, std::vector<uint8_t>* pData)
+{
+	HANDLE hFile = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if(hFile == INVALID_HANDLE_VALUE)
+		return HRESULT_FROM_WIN32(GetLastError());
+
+	LARGE_INTEGER size;
+	if(!GetFileSizeEx(hFile, &size) || size.HighPart > 0)
+	{
+		CloseHandle(hFile);
+		return E_FAIL;
+	}
+
+	pData->resize(size.LowPart);
+	DWORD readSize = 0;
+	const BOOL result = size.LowPart==0 || ReadFile(hFile, &(*pData)[0], size.LowPart, &readSize, nullptr);
+	CloseHandle(hFile);
+
+	if(!result || readSize != size.LowPart)
+		return E_FAIL;
+
+	return S_OK;
+}
+
+CFBXTextureCache::CFBXTextureCache(ID3D11Device* pd3dDevice)
+{
+	m_pDevice = pd3dDevice;
+	m_stopWorkers = false;
+	m_pPlaceholderSRV = nullptr;
+}
+
+CFBXTextureCache::~CFBXTextureCache()
+{
+	Release();
+}
+
+void CFBXTextureCache::Release()
+{
+	// 쐬̃eNX`̂, Ƀ[J[~߂
+	StopWorkers();
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	for(size_t i=0;i<m_entryArray.size();i++)
+		m_entryArray[i].pSRV->Release();
+	m_entryArray.clear();
+	m_pathMap.clear();
+
+	if(m_pPlaceholderSRV)
+	{
+		m_pPlaceholderSRV->Release();
+		m_pPlaceholderSRV = nullptr;
+	}
+}
+
+std::string CFBXTextureCache::GetDirectory(const char* filename)
+{
+	if(!filename)
+		return std::string();
+
+	const std::string path = filename;
+	const size_t pos = path.find_last_of("\\/");
+	if(pos == std::string::npos)
+		return std::string();
+	return path.substr(0, pos + 1);
+}
+
+std::wstring CFBXTextureCache::ResolvePath(const char* texturePath, const std::string& baseDirectory)
+{
+	const std::wstring path = ToWide(texturePath ? texturePath : "");
+	const std::wstring directory = ToWide(baseDirectory);
+
+	std::wstring candidates[3];
+	size_t candidateCount = 0;
+
+	// 1. ΃pX(쐬̃pX̂Ƃ)Ȃ炻̂܂, ΃pXȂFBX̑
+	candidates[candidateCount++] = IsAbsolutePath(path) || directory.empty() ? path : directory + path;
+	// 2. ΃pXJgfBNg(ȑO̓)
+	if(!IsAbsolutePath(path) && !directory.empty())
+		candidates[candidateCount++] = path;
+	// 3. FBXƓfBNg̓t@C
+	const size_t pos = path.find_last_of(L"\\/");
+	if(pos != std::wstring::npos)
+		candidates[candidateCount++] = directory + path.substr(pos + 1);
+
+	for(size_t i=0;i<candidateCount;i++)
+	{
+		if(FileExists(candidates[i]))
+			return NormalizePath(candidates[i]);
+	}
+
+	return NormalizePath(candidates[0]);
+}
+
+// ǂݍݍς(s܂)Ȃtrue
+bool CFBXTextureCache::LookupPath(const std::wstring& path, ID3D11ShaderResourceView** ppSRV, HRESULT* pResult)
+{
+	std::unordered_map<std::wstring, ID3D11ShaderResourceView*>::const_iterator it = m_pathMap.find(path);
+	if(it == m_pathMap.end())
+		return false;
+
+	m_stats.pathHitCount++;
+	if(!it->second)
+	{
+		*pResult = HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+		return true;
+	}
+
+	*ppSRV = it->second;
+	(*ppSRV)->AddRef();
+	*pResult = S_OK;
+	return true;
+}
+
+// ʂ̃pXɂ铯ẽt@C(Rs[ꂽAgXȂ)
+ID3D11ShaderResourceView* CFBXTextureCache::FindContent(const uint64_t contentHash, const uint64_t contentSize) const
+{
+	for(size_t i=0;i<m_entryArray.size();i++)
+	{
+		const TEXTURE_ENTRY& entry = m_entryArray[i];
+		if(entry.contentHash==contentHash && entry.contentSize==contentSize)
+			return entry.pSRV;
+	}
+	return nullptr;
+}
+
+HRESULT CFBXTextureCache::CreatePlaceholder()
+{
+	if(m_pPlaceholderSRV)
+		return S_OK;
+
+	const uint32_t white = 0xffffffff;
+
+	D3D11_TEXTURE2D_DESC desc;
+	ZeroMemory( &desc, sizeof(desc) );
+	desc.Width = 1;
+	desc.Height = 1;
+	desc.MipLevels = 1;
+	desc.ArraySize = 1;
+	desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	desc.SampleDesc.Count = 1;
+	desc.Usage = D3D11_USAGE_IMMUTABLE;
+	desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+	D3D11_SUBRESOURCE_DATA initData;
+	ZeroMemory( &initData, sizeof(initData) );
+	initData.pSysMem = &white;
+	initData.SysMemPitch = sizeof(white);
+
+	ID3D11Texture2D* pTexture = nullptr;
+	HRESULT hr = m_pDevice->CreateTexture2D(&desc, &initData, &pTexture);
+	if(FAILED(hr))
+		return hr;
+
+	hr = m_pDevice->CreateShaderResourceView(pTexture, nullptr, &m_pPlaceholderSRV);
+	pTexture->Release();
+
+	return hr;
+}
+
+HRESULT CFBXTextureCache::LoadPendingTexture(const std::wstring& path, ID3D11ShaderResourceView** ppSRV)
+{
+	ID3D11ShaderResourceView* pSRV = nullptr;
+	bool isCreated = false;
+
+	std::vector<uint8_t> data;
+	HRESULT hr = ReadFileData(path, &data);
+	if(SUCCEEDED(hr) && data.empty())
+		hr = E_FAIL;
+
+	uint64_t contentHash = 0;
+	if(SUCCEEDED(hr))
+	{
+		contentHash = HashBytes(&data[0], data.size());
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stats.loadedBytes += data.size();
+		pSRV = FindContent(contentHash, data.size());
+	}
+
+	// DDS̉͂ƍ쐬̓bN̊O. ̃[J[ɍ쐬ł
+	if(SUCCEEDED(hr) && !pSRV)
+	{
+		hr = CreateDDSTextureFromMemory(m_pDevice, &data[0], data.size(), nullptr, &pSRV);
+		isCreated = SUCCEEDED(hr);
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if(isCreated)
+	{
+		// ĂԂɕʂ̃[J[eĂ, g
+		ID3D11ShaderResourceView* pExisting = FindContent(contentHash, data.size());
+		if(pExisting)
+		{
+			pSRV->Release();
+			pSRV = pExisting;
+			isCreated = false;
+		}
+		else
+		{
+			TEXTURE_ENTRY entry;
+			entry.contentHash = contentHash;
+			entry.contentSize = data.size();
+			entry.pSRV = pSRV;
+			m_entryArray.push_back(entry);
+		}
+	}
+	else if(SUCCEEDED(hr))
+	{
+		// bN𗣂ĂԂTrimĂ邩Ȃ̂ŒT
+		pSRV = FindContent(contentHash, data.size());
+		if(!pSRV)
+			hr = E_FAIL;
+	}
+
+	if(FAILED(hr))
+		m_stats.failCount++;
+	else if(isCreated)
+		m_stats.loadCount++;
+	else
+		m_stats.contentHitCount++;
+
+	m_pathMap[path] = SUCCEEDED(hr) ? pSRV : nullptr;
+	m_pendingSet.erase(path);
+	m_doneCondition.notify_all();
+
+	if(ppSRV && SUCCEEDED(hr))
+	{
+		*ppSRV = pSRV;
+		pSRV->AddRef();
+	}
+
+	return hr;
+}
+
+HRESULT CFBXTextureCache::GetTexture(const char* texturePath, const std::string& baseDirectory, ID3D11ShaderResourceView** ppSRV)
+{
+	if(!texturePath || !ppSRV)
+		return E_FAIL;
+
+	*ppSRV = nullptr;
+	const std::wstring path = ResolvePath(texturePath, baseDirectory);
+
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		// [J[ǂݍݒȂÎ҂
+		m_doneCondition.wait(lock, [&]{ return m_pendingSet.find(path) == m_pendingSet.end(); });
+
+		HRESULT hr = S_OK;
+		if(LookupPath(path, ppSRV, &hr))
+			return hr;
+
+		m_pendingSet.insert(path);
+	}
+
+	return LoadPendingTexture(path, ppSRV);
+}
+
+HRESULT CFBXTextureCache::GetTextureAsync(const char* texturePath, const std::string& baseDirectory, ID3D11ShaderResourceView** ppSRV, std::wstring* pKey)
+{
+	if(!texturePath || !ppSRV || !pKey)
+		return E_FAIL;
+
+	*ppSRV = nullptr;
+	*pKey = ResolvePath(texturePath, baseDirectory);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	HRESULT hr = S_OK;
+	if(LookupPath(*pKey, ppSRV, &hr))
+		return hr;
+
+	hr = CreatePlaceholder();
+	if(FAILED(hr))
+		return hr;
+
+	// pXʂ̃}eAł, ̓ǂݍ݂҂
+	if(m_pendingSet.insert(*pKey).second)
+	{
+		m_jobQueue.push_back(*pKey);
+		m_stats.asyncCount++;
+		StartWorkers();
+		m_jobCondition.notify_one();
+	}
+	else
+		m_stats.pathHitCount++;
+
+	*ppSRV = m_pPlaceholderSRV;
+	(*ppSRV)->AddRef();
+
+	return S_FALSE;
+}
+
+HRESULT CFBXTextureCache::PollTexture(const std::wstring& key, ID3D11ShaderResourceView** ppSRV)
+{
+	if(!ppSRV)
+		return E_FAIL;
+
+	*ppSRV = nullptr;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if(m_pendingSet.find(key) != m_pendingSet.end())
+		return S_FALSE;
+
+	std::unordered_map<std::wstring, ID3D11ShaderResourceView*>::const_iterator it = m_pathMap.find(key);
+	if(it == m_pathMap.end())
+		return E_FAIL;		// IOReleaseꂽ
+	if(!it->second)
+		return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+
+	*ppSRV = it->second;
+	(*ppSRV)->AddRef();
+	return S_OK;
+}
+
+void CFBXTextureCache::WaitIdle()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_doneCondition.wait(lock, [this]{ return m_pendingSet.empty(); });
+}
+
+size_t CFBXTextureCache::GetPendingCount()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_pendingSet.size();
+}
+
+void CFBXTextureCache::StartWorkers()
+{
+	if(!m_workerArray.empty())
+		return ;
+
+	unsigned int workerCount = std::thread::hardware_concurrency();
+	if(workerCount==0)
+		workerCount = 1;
+	if(workerCount > ASYNC_WORKER_MAX)
+		workerCount = ASYNC_WORKER_MAX;
+
+	for(unsigned int i=0;i<workerCount;i++)
+		m_workerArray.push_back(std::thread(&CFBXTextureCache::WorkerThread, this));
+}
+
+void CFBXTextureCache::StopWorkers()
+{
+	std::vector<std::thread> workerArray;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopWorkers = true;
+		workerArray.swap(m_workerArray);
+	}
+	m_jobCondition.notify_all();
+
+	for(size_t i=0;i<workerArray.size();i++)
+		workerArray[i].join();
+
+	// Ȃǂݍ݂͎̂Ă. PollTexture͎sԂ
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_stopWorkers = false;
+	for(size_t i=0;i<m_jobQueue.size();i++)
+		m_pendingSet.erase(m_jobQueue[i]);
+	m_jobQueue.clear();
+	m_doneCondition.notify_all();
+}
+
+void CFBXTextureCache::WorkerThread()
+{
+	for(;;)
+	{
+		std::wstring path;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_jobCondition.wait(lock, [this]{ return m_stopWorkers || !m_jobQueue.empty(); });
+			if(m_stopWorkers)
+				return ;
+
+			path = m_jobQueue.front();
+			m_jobQueue.pop_front();
+		}
+
+		LoadPendingTexture(path, nullptr);
+	}
+}
+
+void CFBXTextureCache::Trim()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	// ȂpXY, ͒T
+	for(auto it = m_pathMap.begin(); it != m_pathMap.end();)
+	{
+		if(!it->second)
+			it = m_pathMap.erase(it);
+		else
+			++it;
+	}
+
+	for(size_t i=0;i<m_entryArray.size();)
+	{
+		ID3D11ShaderResourceView* pSRV = m_entryArray[i].pSRV;
+
+		// QƐ𒼐ڂ͎Ȃ̂, AddRef/Release̖߂lŌ
+		pSRV->AddRef();
+		if(pSRV->Release() > 1)
+		{
+			i++;
+			continue;
+		}
+
+		for(auto it = m_pathMap.begin(); it != m_pathMap.end();)
+		{
+			if(it->second==pSRV)
+				it = m_pathMap.erase(it);
+			else
+				++it;
+		}
+
+		pSRV->Release();
+		m_entryArray.erase(m_entryArray.begin() + i);
+	}
+}
+
+FBX_TEXTURE_CACHE_STATS CFBXTextureCache::GetStats()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_stats;
+}
+
+}	// namespace FBX_LOADER
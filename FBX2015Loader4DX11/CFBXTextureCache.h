@@ -0,0 +1,125 @@
+// *********************************************************************************************************************
+///
+/// @file 		CFBXTextureCache.h
+/// @brief		eNX`̃LbV. pXƓeœeNX`1SRVɂ܂Ƃ߂
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+#include <d3d11.h>
+
+namespace FBX_LOADER
+{
+
+struct FBX_TEXTURE_CACHE_STATS
+{
+	uint32_t	pathHitCount;		// pXǂݍݍς
+	uint32_t	contentHitCount;	// pX͈Ⴄẽt@Cǂݍݍς(t@C͓ǂނ쐬͂Ȃ)
+	uint32_t	loadCount;			// V쐬
+	uint32_t	failCount;			// Ȃ, ܂͍쐬łȂ(2ڈȍ~pathHitCount)
+	uint32_t	asyncCount;			// GetTextureAsyncœǂݍ݂ʃXbhɉ񂵂
+	uint64_t	loadedBytes;		// ǂݍ񂾃t@C̍v
+
+	FBX_TEXTURE_CACHE_STATS()
+	{
+		pathHitCount = 0;
+		contentHitCount = 0;
+		loadCount = 0;
+		failCount = 0;
+		asyncCount = 0;
+		loadedBytes = 0;
+	}
+};
+
+// CFBXStateCache, foCXCFBXRenderDX11ŋL.
+// GetTextureAddRefς݂SRVԂ. LbVQƂ1̂, gȂȂeNX`Trimŉ(CFBXRenderDX11::ReleaseĂ).
+// GetTextureAsync̓t@C̓ǂݍ݂DDS̉, 쐬[J[Xbhōs, ܂ł͉SRV(1x1̔)Ԃ.
+// eNX`̍쐬̓t[XbhID3D11Deviceōŝ, ReLXgɂ͐GȂ
+class CFBXTextureCache
+{
+	static const unsigned int ASYNC_WORKER_MAX = 4;	// قƂǃt@C҂Ȃ̂, RA菭ȂĂ悢
+
+	struct TEXTURE_ENTRY
+	{
+		uint64_t					contentHash;
+		uint64_t					contentSize;
+		ID3D11ShaderResourceView*	pSRV;
+	};
+
+	ID3D11Device*				m_pDevice;		// QƂCFBXStateCache
+	std::mutex					m_mutex;
+
+	std::vector<TEXTURE_ENTRY>	m_entryArray;	// eႤeNX`1
+	// KpX  SRV(m_entryArraŷǂꂩ). ȂpXnullptr
+	std::unordered_map<std::wstring, ID3D11ShaderResourceView*>	m_pathMap;
+
+	// ǂݍݒ̃pX. Im_pathMapɈڂ
+	std::unordered_set<std::wstring>	m_pendingSet;
+	std::deque<std::wstring>			m_jobQueue;		// ܂[J[ĂȂpX
+	std::vector<std::thread>			m_workerArray;	// ŏGetTextureAsyncō
+	std::condition_variable				m_jobCondition;
+	std::condition_variable				m_doneCondition;	// m_pendingSet菜
+	bool								m_stopWorkers;
+
+	ID3D11ShaderResourceView*	m_pPlaceholderSRV;
+
+	FBX_TEXTURE_CACHE_STATS		m_stats;
+
+	// m_mutexČĂ
+	bool LookupPath(const std::wstring& path, ID3D11ShaderResourceView** ppSRV, HRESULT* pResult);
+	ID3D11ShaderResourceView* FindContent(const uint64_t contentHash, const uint64_t contentSize) const;
+	HRESULT CreatePlaceholder();
+	void StartWorkers();
+	void StopWorkers();
+
+	// m_mutexɌĂ. pathm_pendingSetɓĂ, Im_pathMapɈڂ
+	HRESULT LoadPendingTexture(const std::wstring& path, ID3D11ShaderResourceView** ppSRV);
+	void WorkerThread();
+
+	CFBXTextureCache(const CFBXTextureCache&);
+	CFBXTextureCache& operator=(const CFBXTextureCache&);
+
+public:
+	explicit CFBXTextureCache(ID3D11Device* pd3dDevice);
+	~CFBXTextureCache();
+
+	void Release();
+
+	// texturePathFBXɏꂽpX(UTF-8). ΃pXȂ炻̂܂, ΃pXȂbaseDirectory(FBX̂fBNg),
+	// ɃJgfBNgT, baseDirectory̓t@Cg
+	HRESULT GetTexture(const char* texturePath, const std::string& baseDirectory, ID3D11ShaderResourceView** ppSRV);
+	// ǂݍݍς݂ȂGetTextureƓ. ܂Ȃ烏[J[ɓǂݍ݂𗊂, SRVԂS_FALSE.
+	// pKeyɓpXPollTextureĂŖ{Ɠւ
+	HRESULT GetTextureAsync(const char* texturePath, const std::string& baseDirectory, ID3D11ShaderResourceView** ppSRV, std::wstring* pKey);
+	// S_FALSEȂ܂ǂݍݒ(ppSRVnullptr). IĂGetTextureƓʂԂ
+	HRESULT PollTexture(const std::wstring& key, ID3D11ShaderResourceView** ppSRV);
+	// ܂ꂽǂݍ݂SI܂ő҂
+	void WaitIdle();
+	size_t GetPendingCount();
+
+	// LbVȊOQƂĂȂeNX`, ȂpX̋L^̂Ă
+	void Trim();
+
+	size_t GetTextureCount() const { return m_entryArray.size(); }
+	FBX_TEXTURE_CACHE_STATS GetStats();
+
+	// ݂t@CTĐK(΃pX, , '\'؂)pXԂ. Ȃ΍ŏ̌
+	static std::wstring ResolvePath(const char* texturePath, const std::string& baseDirectory);
+	static std::string GetDirectory(const char* filename);
+};
+
+}	// namespace FBX_LOADER
@@ -0,0 +1,347 @@
+// *********************************************************************************************************************
+///
+/// @file 		CFBXVertexFormat.cpp
+/// @brief		_tH[}bg̗ʎq(x, SNORM16, octahedral@)Ɠ̓CAEg̐
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#include "CFBXVertexFormat.h"
+
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+
+#include <DirectXPackedVector.h>
+
+namespace FBX_LOADER
+{
+
+using DirectX::PackedVector::HALF;
+using DirectX::PackedVector::XMConvertFloatToHalf;
+using DirectX::PackedVector::XMConvertHalfToFloat;
+
+static int16_t EncodeSNorm16(const float value)
+{
+	const float v = std::max(-1.0f, std::min(1.0f, value));
+	return static_cast<int16_t>(v * 32767.0f + (v >= 0.0f ? 0.5f : -0.5f));
+}
+
+static float DecodeSNorm16(const int16_t value)
+{
+	// -32768-1ƂĈ(D3D11SNORMƓ)
+	return std::max(static_cast<float>(value) / 32767.0f, -1.0f);
+}
+
+static float SignNotZero(const float v)
+{
+	return v >= 0.0f ? 1.0f : -1.0f;
+}
+
+// PʃxNg𔪖ʑ̂ɓe2ɂ
+static void EncodeOctahedral(const DirectX::XMFLOAT3& n, float* pX, float* pY)
+{
+	const float sum = fabsf(n.x) + fabsf(n.y) + fabsf(n.z);
+	if(sum <= 0.0f)
+	{
+		*pX = 0.0f;
+		*pY = 0.0f;
+		return ;
+	}
+
+	float x = n.x / sum;
+	float y = n.y / sum;
+	if(n.z < 0.0f)
+	{
+		const float ox = x;
+		x = (1.0f - fabsf(y)) * SignNotZero(ox);
+		y = (1.0f - fabsf(ox)) * SignNotZero(y);
+	}
+
+	*pX = x;
+	*pY = y;
+}
+
+static DirectX::XMFLOAT3 DecodeOctahedral(const float x, const float y)
+{
+	DirectX::XMFLOAT3 n(x, y, 1.0f - fabsf(x) - fabsf(y));
+	const float t = std::max(-n.z, 0.0f);
+	n.x += n.x >= 0.0f ? -t : t;
+	n.y += n.y >= 0.0f ? -t : t;
+
+	const float length = sqrtf(n.x*n.x + n.y*n.y + n.z*n.z);
+	if(length > 0.0f)
+	{
+		n.x /= length;
+		n.y /= length;
+		n.z /= length;
+	}
+	return n;
+}
+
+static void SetElement(D3D11_INPUT_ELEMENT_DESC* pDesc, const char* semantic, const DXGI_FORMAT format, const uint32_t offset)
+{
+	pDesc->SemanticName = semantic;
+	pDesc->SemanticIndex = 0;
+	pDesc->Format = format;
+	pDesc->InputSlot = 0;
+	pDesc->AlignedByteOffset = offset;
+	pDesc->InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+	pDesc->InstanceDataStepRate = 0;
+}
+
+//
+CFBXVertexLayout::CFBXVertexLayout()
+{
+	Compile(FBX_VERTEX_FORMAT());
+}
+
+void CFBXVertexLayout::Compile(const FBX_VERTEX_FORMAT& format)
+{
+	m_format = format;
+
+	uint32_t offset = 0;
+
+	m_positionOffset = offset;
+	switch(format.position)
+	{
+	case FBX_POSITION_HALF4:
+		SetElement(&m_elementDesc[0], "POSITION", DXGI_FORMAT_R16G16B16A16_FLOAT, offset);
+		offset += sizeof(HALF) * 4;
+		break;
+	case FBX_POSITION_SNORM16:
+		SetElement(&m_elementDesc[0], "POSITION", DXGI_FORMAT_R16G16B16A16_SNORM, offset);
+		offset += sizeof(int16_t) * 4;
+		break;
+	default:
+		SetElement(&m_elementDesc[0], "POSITION", DXGI_FORMAT_R32G32B32_FLOAT, offset);
+		offset += sizeof(float) * 3;
+		break;
+	}
+
+	m_normalOffset = offset;
+	switch(format.normal)
+	{
+	case FBX_NORMAL_OCT_SNORM16:
+		SetElement(&m_elementDesc[1], "NORMAL", DXGI_FORMAT_R16G16_SNORM, offset);
+		offset += sizeof(int16_t) * 2;
+		break;
+	default:
+		SetElement(&m_elementDesc[1], "NORMAL", DXGI_FORMAT_R32G32B32_FLOAT, offset);
+		offset += sizeof(float) * 3;
+		break;
+	}
+
+	m_texcoordOffset = offset;
+	switch(format.texcoord)
+	{
+	case FBX_TEXCOORD_HALF2:
+		SetElement(&m_elementDesc[2], "TEXCOORD", DXGI_FORMAT_R16G16_FLOAT, offset);
+		offset += sizeof(HALF) * 2;
+		break;
+	default:
+		SetElement(&m_elementDesc[2], "TEXCOORD", DXGI_FORMAT_R32G32_FLOAT, offset);
+		offset += sizeof(float) * 2;
+		break;
+	}
+
+	m_elementCount = 3;
+	m_skinOffset = offset;
+	if(format.skin==FBX_SKIN_UINT8_UNORM8)
+	{
+		SetElement(&m_elementDesc[3], "BLENDINDICES", DXGI_FORMAT_R8G8B8A8_UINT, offset);
+		SetElement(&m_elementDesc[4], "BLENDWEIGHT", DXGI_FORMAT_R8G8B8A8_UNORM, offset + sizeof(uint8_t) * 4);
+		offset += sizeof(uint8_t) * 8;
+		m_elementCount = 5;
+	}
+
+	m_stride = offset;
+}
+
+void CFBXVertexLayout::ComputeDequant(const VERTEX_DATA* pVertices, const size_t vertexCount, VERTEX_DEQUANT_DATA* pDequant) const
+{
+	*pDequant = VERTEX_DEQUANT_DATA();
+
+	if(m_format.position==FBX_POSITION_FLOAT3 || vertexCount==0)
+		return ;
+
+	DirectX::XMFLOAT3 minPos = pVertices[0].vPos;
+	DirectX::XMFLOAT3 maxPos = pVertices[0].vPos;
+	for(size_t i=1;i<vertexCount;i++)
+	{
+		const DirectX::XMFLOAT3& p = pVertices[i].vPos;
+		minPos.x = std::min(minPos.x, p.x);
+		minPos.y = std::min(minPos.y, p.y);
+		minPos.z = std::min(minPos.z, p.z);
+		maxPos.x = std::max(maxPos.x, p.x);
+		maxPos.y = std::max(maxPos.y, p.y);
+		maxPos.z = std::max(maxPos.z, p.z);
+	}
+
+	// ݂̖0ZɂȂȂ悤1̂܂܂ɂ
+	const float extent[3] = { (maxPos.x - minPos.x) * 0.5f, (maxPos.y - minPos.y) * 0.5f, (maxPos.z - minPos.z) * 0.5f };
+	pDequant->positionScale = DirectX::XMFLOAT4(extent[0] > 0.0f ? extent[0] : 1.0f,
+		extent[1] > 0.0f ? extent[1] : 1.0f, extent[2] > 0.0f ? extent[2] : 1.0f, 0.0f);
+	pDequant->positionOffset = DirectX::XMFLOAT4((maxPos.x + minPos.x) * 0.5f,
+		(maxPos.y + minPos.y) * 0.5f, (maxPos.z + minPos.z) * 0.5f, 0.0f);
+}
+
+void CFBXVertexLayout::Encode(const VERTEX_DATA* pVertices, const size_t vertexCount, const VERTEX_DEQUANT_DATA& dequant, void* pDest) const
+{
+	BYTE* pDst = static_cast<BYTE*>(pDest);
+
+	for(size_t i=0;i<vertexCount;i++, pDst += m_stride)
+	{
+		const VERTEX_DATA& v = pVertices[i];
+
+		if(m_format.position==FBX_POSITION_FLOAT3)
+			memcpy(pDst + m_positionOffset, &v.vPos, sizeof(float) * 3);
+		else
+		{
+			const float p[3] =
+			{
+				(v.vPos.x - dequant.positionOffset.x) / dequant.positionScale.x,
+				(v.vPos.y - dequant.positionOffset.y) / dequant.positionScale.y,
+				(v.vPos.z - dequant.positionOffset.z) / dequant.positionScale.z,
+			};
+
+			if(m_format.position==FBX_POSITION_HALF4)
+			{
+				const HALF h[4] = { XMConvertFloatToHalf(p[0]), XMConvertFloatToHalf(p[1]), XMConvertFloatToHalf(p[2]), XMConvertFloatToHalf(1.0f) };
+				memcpy(pDst + m_positionOffset, h, sizeof(h));
+			}
+			else
+			{
+				const int16_t s[4] = { EncodeSNorm16(p[0]), EncodeSNorm16(p[1]), EncodeSNorm16(p[2]), 32767 };
+				memcpy(pDst + m_positionOffset, s, sizeof(s));
+			}
+		}
+
+		if(m_format.normal==FBX_NORMAL_OCT_SNORM16)
+		{
+			float x, y;
+			EncodeOctahedral(v.vNor, &x, &y);
+			const int16_t s[2] = { EncodeSNorm16(x), EncodeSNorm16(y) };
+			memcpy(pDst + m_normalOffset, s, sizeof(s));
+		}
+		else
+			memcpy(pDst + m_normalOffset, &v.vNor, sizeof(float) * 3);
+
+		if(m_format.texcoord==FBX_TEXCOORD_HALF2)
+		{
+			const HALF h[2] = { XMConvertFloatToHalf(v.vTexcoord.x), XMConvertFloatToHalf(v.vTexcoord.y) };
+			memcpy(pDst + m_texcoordOffset, h, sizeof(h));
+		}
+		else
+			memcpy(pDst + m_texcoordOffset, &v.vTexcoord, sizeof(float) * 2);
+
+		if(m_format.skin==FBX_SKIN_UINT8_UNORM8)
+		{
+			memcpy(pDst + m_skinOffset, v.boneIndex, sizeof(v.boneIndex));
+			memcpy(pDst + m_skinOffset + sizeof(v.boneIndex), v.boneWeight, sizeof(v.boneWeight));
+		}
+	}
+}
+
+void CFBXVertexLayout::Decode(const void* pSrc, const size_t vertexCount, const VERTEX_DEQUANT_DATA& dequant, VERTEX_DATA* pVertices) const
+{
+	const BYTE* pData = static_cast<const BYTE*>(pSrc);
+
+	for(size_t i=0;i<vertexCount;i++, pData += m_stride)
+	{
+		VERTEX_DATA& v = pVertices[i];
+
+		if(m_format.position==FBX_POSITION_FLOAT3)
+			memcpy(&v.vPos, pData + m_positionOffset, sizeof(float) * 3);
+		else
+		{
+			float p[3];
+			if(m_format.position==FBX_POSITION_HALF4)
+			{
+				HALF h[4];
+				memcpy(h, pData + m_positionOffset, sizeof(h));
+				for(int j=0;j<3;j++)
+					p[j] = XMConvertHalfToFloat(h[j]);
+			}
+			else
+			{
+				int16_t s[4];
+				memcpy(s, pData + m_positionOffset, sizeof(s));
+				for(int j=0;j<3;j++)
+					p[j] = DecodeSNorm16(s[j]);
+			}
+
+			v.vPos.x = p[0] * dequant.positionScale.x + dequant.positionOffset.x;
+			v.vPos.y = p[1] * dequant.positionScale.y + dequant.positionOffset.y;
+			v.vPos.z = p[2] * dequant.positionScale.z + dequant.positionOffset.z;
+		}
+
+		if(m_format.normal==FBX_NORMAL_OCT_SNORM16)
+		{
+			int16_t s[2];
+			memcpy(s, pData + m_normalOffset, sizeof(s));
+			v.vNor = DecodeOctahedral(DecodeSNorm16(s[0]), DecodeSNorm16(s[1]));
+		}
+		else
+			memcpy(&v.vNor, pData + m_normalOffset, sizeof(float) * 3);
+
+		if(m_format.texcoord==FBX_TEXCOORD_HALF2)
+		{
+			HALF h[2];
+			memcpy(h, pData + m_texcoordOffset, sizeof(h));
+			v.vTexcoord = DirectX::XMFLOAT2(XMConvertHalfToFloat(h[0]), XMConvertHalfToFloat(h[1]));
+		}
+		else
+			memcpy(&v.vTexcoord, pData + m_texcoordOffset, sizeof(float) * 2);
+
+		if(m_format.skin==FBX_SKIN_UINT8_UNORM8)
+		{
+			memcpy(v.boneIndex, pData + m_skinOffset, sizeof(v.boneIndex));
+			memcpy(v.boneWeight, pData + m_skinOffset + sizeof(v.boneIndex), sizeof(v.boneWeight));
+		}
+		else
+		{
+			memset(v.boneIndex, 0, sizeof(v.boneIndex));
+			memset(v.boneWeight, 0, sizeof(v.boneWeight));
+		}
+	}
+}
+
+void CFBXVertexLayout::MeasureError(const VERTEX_DATA* pVertices, const void* pEncoded, const size_t vertexCount, const VERTEX_DEQUANT_DATA& dequant,
+	VERTEX_DATA* pDecoded, FBX_VERTEX_ERROR* pError) const
+{
+	if(vertexCount==0 || !pError)
+		return ;
+
+	Decode(pEncoded, vertexCount, dequant, pDecoded);
+
+	const float radianToDegree = 180.0f / 3.14159265f;
+
+	for(size_t i=0;i<vertexCount;i++)
+	{
+		const VERTEX_DATA& a = pVertices[i];
+		const VERTEX_DATA& b = pDecoded[i];
+
+		const float dx = a.vPos.x - b.vPos.x;
+		const float dy = a.vPos.y - b.vPos.y;
+		const float dz = a.vPos.z - b.vPos.z;
+		pError->position = std::max(pError->position, sqrtf(dx*dx + dy*dy + dz*dz));
+
+		// 0̖@ׂ͔Ȃ
+		const float lengthA = sqrtf(a.vNor.x*a.vNor.x + a.vNor.y*a.vNor.y + a.vNor.z*a.vNor.z);
+		const float lengthB = sqrtf(b.vNor.x*b.vNor.x + b.vNor.y*b.vNor.y + b.vNor.z*b.vNor.z);
+		if(lengthA > 0.0f && lengthB > 0.0f)
+		{
+			float cosine = (a.vNor.x*b.vNor.x + a.vNor.y*b.vNor.y + a.vNor.z*b.vNor.z) / (lengthA * lengthB);
+			cosine = std::max(-1.0f, std::min(1.0f, cosine));
+			pError->normal = std::max(pError->normal, acosf(cosine) * radianToDegree);
+		}
+
+		pError->texcoord = std::max(pError->texcoord, fabsf(a.vTexcoord.x - b.vTexcoord.x));
+		pError->texcoord = std::max(pError->texcoord, fabsf(a.vTexcoord.y - b.vTexcoord.y));
+	}
+}
+
+}	// namespace FBX_LOADER
@@ -0,0 +1,162 @@
+// *********************************************************************************************************************
+///
+/// @file 		CFBXVertexFormat.h
+/// @brief		_tH[}bg̗ʎq(x, SNORM16, octahedral@)Ɠ̓CAEg̐
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#pragma once
+
+#include <stdint.h>
+
+#include <d3d11.h>
+#include <DirectXMath.h>
+
+namespace FBX_LOADER
+{
+
+// œK܂ł̍Ɨp̒_(float32). ʎq_Ƃ̌덷ɑ
+struct	VERTEX_DATA
+{
+	DirectX::XMFLOAT3	vPos;
+	DirectX::XMFLOAT3	vNor;
+	DirectX::XMFLOAT2	vTexcoord;
+	uint8_t				boneIndex[4];	// FBX_SKIN_WEIGHTƓ. XLΑS0
+	uint8_t				boneWeight[4];
+};
+
+enum FBX_POSITION_FORMAT
+{
+	FBX_POSITION_FLOAT3 = 0,		// R32G32B32_FLOAT			12byte
+	FBX_POSITION_HALF4,				// R16G16B16A16_FLOAT		8byte. m[hAABB
+	FBX_POSITION_SNORM16,			// R16G16B16A16_SNORM		8byte. m[hAABB
+};
+
+enum FBX_NORMAL_FORMAT
+{
+	FBX_NORMAL_FLOAT3 = 0,			// R32G32B32_FLOAT			12byte
+	FBX_NORMAL_OCT_SNORM16,			// R16G16_SNORM				4byte. octahedral
+};
+
+enum FBX_TEXCOORD_FORMAT
+{
+	FBX_TEXCOORD_FLOAT2 = 0,		// R32G32_FLOAT				8byte
+	FBX_TEXCOORD_HALF2,				// R16G16_FLOAT				4byte
+};
+
+enum FBX_SKIN_FORMAT
+{
+	FBX_SKIN_NONE = 0,				// XLEFCg𒸓_ɓȂ
+	FBX_SKIN_UINT8_UNORM8,			// BLENDINDICES R8G8B8A8_UINT + BLENDWEIGHT R8G8B8A8_UNORM	8byte
+};
+
+struct FBX_VERTEX_FORMAT
+{
+	FBX_POSITION_FORMAT		position;
+	FBX_NORMAL_FORMAT		normal;
+	FBX_TEXCOORD_FORMAT		texcoord;
+	FBX_SKIN_FORMAT			skin;
+
+	// VERTEX_DATÄʒu, @, UVƓ(XL)
+	FBX_VERTEX_FORMAT()
+	{
+		position = FBX_POSITION_FLOAT3;
+		normal = FBX_NORMAL_FLOAT3;
+		texcoord = FBX_TEXCOORD_FLOAT2;
+		skin = FBX_SKIN_NONE;
+	}
+
+	FBX_VERTEX_FORMAT(const FBX_POSITION_FORMAT pos, const FBX_NORMAL_FORMAT nor, const FBX_TEXCOORD_FORMAT uv, const FBX_SKIN_FORMAT sk = FBX_SKIN_NONE)
+	{
+		position = pos;
+		normal = nor;
+		texcoord = uv;
+		skin = sk;
+	}
+
+	// bVLbV̏ƍp
+	uint32_t GetCode() const
+	{
+		return static_cast<uint32_t>(position) | (static_cast<uint32_t>(normal) << 8) | (static_cast<uint32_t>(texcoord) << 16)
+			| (static_cast<uint32_t>(skin) << 24);
+	}
+};
+
+// _VF[_ŕ邽߂̒萔(m[h).
+//   position = input.xyz * positionScale.xyz + positionOffset.xyz
+// @͍̃VF[_gȂ̂Œ萔Ȃ(octahedral̕CFBXVertexLayout::Decode)
+struct VERTEX_DEQUANT_DATA
+{
+	DirectX::XMFLOAT4	positionScale;
+	DirectX::XMFLOAT4	positionOffset;
+
+	VERTEX_DEQUANT_DATA()
+	{
+		positionScale = DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 0.0f);
+		positionOffset = DirectX::XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f);
+	}
+};
+
+// float32̒_ɑ΂ő덷
+struct FBX_VERTEX_ERROR
+{
+	float	position;		// (f̒P)
+	float	normal;			// px(x)
+	float	texcoord;
+
+	FBX_VERTEX_ERROR()
+	{
+		position = 0.0f;
+		normal = 0.0f;
+		texcoord = 0.0f;
+	}
+};
+
+// FBX_VERTEX_FORMAT璸_̕тƓ̓CAEg, VERTEX_DATAƂ̕ϊs
+class CFBXVertexLayout
+{
+public:
+	enum
+	{
+		ELEMENT_COUNT_MAX = 5,
+	};
+
+private:
+	FBX_VERTEX_FORMAT			m_format;
+	uint32_t					m_stride;
+	uint32_t					m_positionOffset;
+	uint32_t					m_normalOffset;
+	uint32_t					m_texcoordOffset;
+	uint32_t					m_skinOffset;
+	uint32_t					m_elementCount;
+	D3D11_INPUT_ELEMENT_DESC	m_elementDesc[ELEMENT_COUNT_MAX];
+
+public:
+	CFBXVertexLayout();
+
+	void Compile(const FBX_VERTEX_FORMAT& format);
+
+	const FBX_VERTEX_FORMAT& GetFormat() const { return m_format; }
+	uint32_t GetStride() const { return m_stride; }
+
+	// CreateInputLayoutɂ̂܂ܓn. Z}eBNXPOSITION, NORMAL, TEXCOORD(XLȂBLENDINDICES, BLENDWEIGHT)
+	const D3D11_INPUT_ELEMENT_DESC* GetInputElementDesc() const { return m_elementDesc; }
+	UINT GetInputElementCount() const { return m_elementCount; }
+
+	// ʒu̗ʎq̓m[hAABB[-1,1]ɍ킹
+	void ComputeDequant(const VERTEX_DATA* pVertices, const size_t vertexCount, VERTEX_DEQUANT_DATA* pDequant) const;
+
+	// pDestɂGetStride() * vertexCountoCgKv
+	void Encode(const VERTEX_DATA* pVertices, const size_t vertexCount, const VERTEX_DEQUANT_DATA& dequant, void* pDest) const;
+	void Decode(const void* pSrc, const size_t vertexCount, const VERTEX_DEQUANT_DATA& dequant, VERTEX_DATA* pVertices) const;
+
+	// Encodeς݂pEncodedpDecoded(vertexCount̍Ɨ̈)DecodeČ̒_Ɣ,
+	// pError̊előlōXV
+	void MeasureError(const VERTEX_DATA* pVertices, const void* pEncoded, const size_t vertexCount, const VERTEX_DEQUANT_DATA& dequant,
+		VERTEX_DATA* pDecoded, FBX_VERTEX_ERROR* pError) const;
+};
+
+}	// namespace FBX_LOADER
@@ -19,6 +19,7 @@
 #include <SpriteFont.h>
 
 #include "CFBXRendererDX11.h"
+#include "CFBXRenderQueue.h"
 
 using namespace DirectX;
 
@@ -61,8 +62,7 @@ const DWORD	NUMBER_OF_MODELS = 3;
 HRESULT InitApp();
 void CleanupApp();
 void UpdateApp();
-HRESULT SetupTransformSRV();
-void	SetMatrix();
+HRESULT SetupInstances();
 FBX_LOADER::CFBXRenderDX11*	g_pFbxDX11[NUMBER_OF_MODELS];
 char g_files[NUMBER_OF_MODELS][256] =
 {
@@ -71,29 +71,22 @@ char g_files[NUMBER_OF_MODELS][256] =
 	"Assets\\model3.fbx",
 };
 
-struct CBFBXMATRIX
-{
-	XMMATRIX mWorld;
-	XMMATRIX mView;
-	XMMATRIX mProj;
-	XMMATRIX mWVP;
-};
+// Sf̃m[h܂Ƃ߂ă\[gĕ`悷. m[h̍s(cbGlobal)L[
+FBX_LOADER::CFBXRenderQueue		g_renderQueue;
+
+// Ă񂾃Aj[V𖈃t[ɓWJ(f, m[h)
+std::vector<XMFLOAT4X4>			g_nodeMatrices[NUMBER_OF_MODELS];
 ID3D11BlendState*				g_pBlendState = nullptr;
 ID3D11RasterizerState*			g_pRS = nullptr;
-ID3D11Buffer*					g_pcBuffer = nullptr;
 ID3D11VertexShader*                 g_pvsFBX = nullptr;
 ID3D11PixelShader*                  g_ppsFBX = nullptr;
 
 // Instancing
 bool	g_bInstancing = false;
-struct SRVPerInstanceData
-{
-	XMMATRIX mWorld;
-};
-const uint32_t g_InstanceMAX = 32;
+const uint32_t g_InstanceCount = 32;
 ID3D11VertexShader*             g_pvsFBXInstancing = nullptr;
-ID3D11Buffer*					g_pTransformStructuredBuffer = nullptr;
-ID3D11ShaderResourceView*		g_pTransformSRV = nullptr;
+// CX^X̍s. ς𑗂̂, zuςȂΖt[̃Abv[h͖
+FBX_LOADER::CFBXInstanceBuffer	g_instanceBuffer;
 
 DirectX::SpriteBatch*		g_pSpriteBatch = nullptr;
 DirectX::SpriteFont*		g_pFont = nullptr;
@@ -338,7 +331,7 @@ HRESULT InitDevice()
 	hr = InitApp();
 	if (FAILED(hr))
 		return hr;
-	hr = SetupTransformSRV();
+	hr = SetupInstances();
 	if (FAILED(hr))
 		return hr;
 
@@ -356,7 +349,15 @@ HRESULT InitApp()
 	for (DWORD i = 0; i<NUMBER_OF_MODELS; i++)
 	{
 		g_pFbxDX11[i] = new FBX_LOADER::CFBXRenderDX11;
+		g_pFbxDX11[i]->SetMeshCacheEnable(true);
+		// ʒuSNORM16, @octahedral, UVx16byte_
+		g_pFbxDX11[i]->SetVertexFormat(FBX_LOADER::FBX_VERTEX_FORMAT(FBX_LOADER::FBX_POSITION_SNORM16, FBX_LOADER::FBX_NORMAL_OCT_SNORM16, FBX_LOADER::FBX_TEXCOORD_HALF2));
+		// eNX`͓ǂݍ݂҂ɔŕ\, Renderœւ
+		g_pFbxDX11[i]->SetAsyncTextureLoad(true);
 		hr = g_pFbxDX11[i]->LoadFBX(g_files[i], g_pd3dDevice, g_pImmediateContext);
+
+		// ǂݍݎԂ̓
+		OutputDebugStringA(g_pFbxDX11[i]->GetLoadStats().ToJSON().c_str());
 	}
 	if (FAILED(hr))
 	{
@@ -402,19 +403,13 @@ HRESULT InitApp()
 	}
 
 
-	// Define the input layout
-	D3D11_INPUT_ELEMENT_DESC layout [] =
-	{
-		{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-		{ "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-		{ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-	};
-	UINT numElements = ARRAYSIZE(layout);
-
 	// Todo: InputLayout̍쐬ɂ͒_VF[_KvȂ̂łȃ^C~OCreatêȂƂ
+	// ̓CAEgSetVertexFormatŌ߂`ɍ킹
 	for (DWORD i = 0; i<NUMBER_OF_MODELS; i++)
 	{
-		hr = g_pFbxDX11[i]->CreateInputLayout(g_pd3dDevice, pVSBlob->GetBufferPointer(), pVSBlob->GetBufferSize(), layout, numElements);
+		const FBX_LOADER::CFBXVertexLayout& vertexLayout = g_pFbxDX11[i]->GetVertexLayout();
+		hr = g_pFbxDX11[i]->CreateInputLayout(g_pd3dDevice, pVSBlob->GetBufferPointer(), pVSBlob->GetBufferSize(),
+			vertexLayout.GetInputElementDesc(), vertexLayout.GetInputElementCount());
 	}
 	pVSBlob->Release();
 	if (FAILED(hr))
@@ -436,14 +431,8 @@ HRESULT InitApp()
 	if (FAILED(hr))
 		return hr;
 
-	// Create Constant Buffer
-	D3D11_BUFFER_DESC bd;
-	ZeroMemory(&bd, sizeof(bd));
-	bd.Usage = D3D11_USAGE_DYNAMIC;
-	bd.ByteWidth = sizeof(CBFBXMATRIX);
-	bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-	bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-	hr = g_pd3dDevice->CreateBuffer(&bd, NULL, &g_pcBuffer);
+	// Create Render Queue(cbGlobal̒萔obt@ō)
+	hr = g_renderQueue.Initialize(g_pd3dDevice);
 	if (FAILED(hr))
 		return hr;
 
@@ -482,38 +471,22 @@ HRESULT InitApp()
 }
 
 //
-HRESULT SetupTransformSRV()
+HRESULT SetupInstances()
 {
-	HRESULT hr = S_OK;
-
-	const uint32_t count = g_InstanceMAX;
-	const uint32_t stride = static_cast<uint32_t>(sizeof(SRVPerInstanceData));
-
-	// Create StructuredBuffer
-	D3D11_BUFFER_DESC bd;
-	ZeroMemory(&bd, sizeof(bd));
-	bd.Usage = D3D11_USAGE_DYNAMIC;
-	bd.ByteWidth = stride * count;
-	bd.BindFlags = D3D11_BIND_SHADER_RESOURCE;
-	bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-	bd.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
-	bd.StructureByteStride = stride;
-	hr = g_pd3dDevice->CreateBuffer(&bd, NULL, &g_pTransformStructuredBuffer);
+	HRESULT hr = g_instanceBuffer.Initialize(g_pd3dDevice, g_InstanceCount);
 	if (FAILED(hr))
 		return hr;
 
-	// Create ShaderResourceView
-	D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc;
-	ZeroMemory(&srvDesc, sizeof(D3D11_SHADER_RESOURCE_VIEW_DESC));
-	srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFEREX;   // gꂽobt@[ł邱Ƃw肷
-	srvDesc.BufferEx.FirstElement = 0;
-	srvDesc.Format = DXGI_FORMAT_UNKNOWN;
-	srvDesc.BufferEx.NumElements = count;                  // \[X̗vf̐
+	const float offset = -(g_InstanceCount*60.0f / 2.0f);
+	for (uint32_t i = 0; i<g_InstanceCount; i++)
+	{
+		XMFLOAT4X4 mat;
+		XMStoreFloat4x4(&mat, XMMatrixTranslation(0, 0, i*60.0f + offset));
+		g_instanceBuffer.AddInstance(mat);
+	}
 
-	// \obt@[ƂɃVF[_[\[Xr[쐬
-	hr = g_pd3dDevice->CreateShaderResourceView(g_pTransformStructuredBuffer, &srvDesc, &g_pTransformSRV);
-	if (FAILED(hr))
-		return hr;
+	// f܂傫̋, ʊÕCX^X𑗂OɗƂ
+	g_instanceBuffer.SetLocalBounds(XMFLOAT3(0.0f, 100.0f, 0.0f), 200.0f);
 
 	return hr;
 }
@@ -538,16 +511,7 @@ void CleanupApp()
 		g_pFont = nullptr;
 	}
 
-	if (g_pTransformSRV)
-	{
-		g_pTransformSRV->Release();
-		g_pTransformSRV = nullptr;
-	}
-	if (g_pTransformStructuredBuffer)
-	{
-		g_pTransformStructuredBuffer->Release();
-		g_pTransformStructuredBuffer = nullptr;
-	}
+	g_instanceBuffer.Release();
 
 	if (g_pBlendState)
 	{
@@ -587,11 +551,7 @@ void CleanupApp()
 		g_ppsFBX->Release();
 		g_ppsFBX = nullptr;
 	}
-	if (g_pcBuffer)
-	{
-		g_pcBuffer->Release();
-		g_pcBuffer = nullptr;
-	}
+	g_renderQueue.Release();
 }
 
 
@@ -644,28 +604,6 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
 	return 0;
 }
 
-//
-void SetMatrix()
-{
-	HRESULT hr = S_OK;
-	const uint32_t count = g_InstanceMAX;
-	const float offset = -(g_InstanceMAX*60.0f / 2.0f);
-	XMMATRIX mat;
-
-	D3D11_MAPPED_SUBRESOURCE MappedResource;
-	hr = g_pImmediateContext->Map(g_pTransformStructuredBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &MappedResource);
-
-	SRVPerInstanceData*	pSrvInstanceData = (SRVPerInstanceData*) MappedResource.pData;
-
-	for (uint32_t i = 0; i<count; i++)
-	{
-		mat = XMMatrixTranslation(0, 0, i*60.0f + offset);
-		pSrvInstanceData[i].mWorld = (mat);
-	}
-
-	g_pImmediateContext->Unmap(g_pTransformStructuredBuffer, 0);
-}
-
 //--------------------------------------------------------------------------------------
 // Render a frame
 //--------------------------------------------------------------------------------------
@@ -723,66 +661,51 @@ void Render()
 	g_pImmediateContext->OMSetDepthStencilState(g_pDepthStencilState, 0);
 	
 	g_pUserAnotation->BeginEvent(L"ModelDraw");
-	
-	// fԂɕ`
-	for (DWORD i = 0; i<NUMBER_OF_MODELS; i++)
-	{
-		// FBX Modelnode擾
-		size_t nodeCount = g_pFbxDX11[i]->GetNodeCount();
-
-		WCHAR wstr[256];
-		swprintf_s(wstr, L"Model0%d", i);
-		g_pUserAnotation->BeginEvent(wstr);
-
-		ID3D11VertexShader* pVS = g_bInstancing ? g_pvsFBXInstancing : g_pvsFBX;
-		g_pImmediateContext->VSSetShader(pVS, NULL, 0);
-		g_pImmediateContext->VSSetConstantBuffers(0, 1, &g_pcBuffer);
-		g_pImmediateContext->PSSetShader(g_ppsFBX, NULL, 0);
-
-		// Sm[h`
-		for (int j = 0; j<nodeCount; j++)
-		{
-
-			XMMATRIX mLocal;
-			g_pFbxDX11[i]->GetNodeMatrix(j, &mLocal.r[0].m128_f32[0]);	// nodeMatrix
 
-			D3D11_MAPPED_SUBRESOURCE MappedResource;
-			g_pImmediateContext->Map(g_pcBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &MappedResource);
+	// Sf̑Sm[hL[ɐς, Xe[gɕבւĕ`悷
+	XMFLOAT4X4 world, view, projection;
+	XMStoreFloat4x4(&world, g_World);
+	XMStoreFloat4x4(&view, g_View);
+	XMStoreFloat4x4(&projection, g_Projection);
 
-			CBFBXMATRIX*	cbFBX = (CBFBXMATRIX*) MappedResource.pData;
-
-			// n
-			cbFBX->mWorld = (g_World);
-			cbFBX->mView = (g_View);
-			cbFBX->mProj = (g_Projection);
-
-			cbFBX->mWVP = XMMatrixTranspose(mLocal*g_World*g_View*g_Projection);
-
-			g_pImmediateContext->Unmap(g_pcBuffer, 0);
-
-			SetMatrix();
-
-			FBX_LOADER::MATERIAL_DATA material = g_pFbxDX11[i]->GetNodeMaterial(j);
-
-			if (material.pMaterialCb)
-				g_pImmediateContext->UpdateSubresource(material.pMaterialCb, 0, NULL, &material.materialConstantData, 0, 0);
-
-			g_pImmediateContext->VSSetShaderResources(0, 1, &g_pTransformSRV);
-			g_pImmediateContext->PSSetShaderResources(0, 1, &material.pSRV);
-			g_pImmediateContext->PSSetConstantBuffers(0, 1, &material.pMaterialCb);
-			g_pImmediateContext->PSSetSamplers(0, 1, &material.pSampler);
+	// ǂݍ݂̏IeNX`𔽉f
+	for (DWORD i = 0; i<NUMBER_OF_MODELS; i++)
+		g_pFbxDX11[i]->UpdateTextures();
 
-			if (g_bInstancing)
-				g_pFbxDX11[i]->RenderNodeInstancing(g_pImmediateContext, j, g_InstanceMAX);
-			else
-				g_pFbxDX11[i]->RenderNode(g_pImmediateContext, j);
+	// CX^Xl߂ĕ`悷
+	uint32_t instanceCount = 1;
+	if (g_bInstancing)
+	{
+		g_instanceBuffer.Update(g_pImmediateContext, world, view, projection);
+		instanceCount = g_instanceBuffer.GetVisibleCount();
+	}
 
-			
+	g_renderQueue.Begin(view, projection);
+	for (DWORD i = 0; i<NUMBER_OF_MODELS; i++)
+	{
+		// Aj[V΃m[h̍s̎̂̂ɂ
+		const FBX_LOADER::CFBXAnimation* pAnimation = g_pFbxDX11[i]->GetAnimation();
+		if (pAnimation && pAnimation->IsAnimated() && pAnimation->GetNodeCount() == g_pFbxDX11[i]->GetNodeCount())
+		{
+			g_nodeMatrices[i].resize(pAnimation->GetNodeCount());
+			pAnimation->Sample(t, &g_nodeMatrices[i][0]);
+			g_renderQueue.SubmitAll(*g_pFbxDX11[i], &g_nodeMatrices[i][0], world, 0, instanceCount);
+		}
+		else
+		{
+			g_renderQueue.SubmitAll(*g_pFbxDX11[i], world, 0, instanceCount);
 		}
-
-		g_pUserAnotation->EndEvent();
 	}
 
+	ID3D11VertexShader* pVS = g_bInstancing ? g_pvsFBXInstancing : g_pvsFBX;
+	g_pImmediateContext->VSSetShader(pVS, NULL, 0);
+	ID3D11ShaderResourceView* pInstanceSRV = g_instanceBuffer.GetSRV();
+	g_pImmediateContext->VSSetShaderResources(0, 1, &pInstanceSRV);
+	g_pImmediateContext->PSSetShader(g_ppsFBX, NULL, 0);
+
+	// }eA, _̕p萔L[Őݒ肳
+	g_renderQueue.Flush(g_pImmediateContext);
+
 	g_pUserAnotation->EndEvent();
 
 	g_pUserAnotation->BeginEvent(L"RenderText");
@@ -793,10 +716,20 @@ void Render()
 	g_pFont->DrawString(g_pSpriteBatch, L"FBX Loader : F2 Change Render Mode", XMFLOAT2(0, 0), DirectX::Colors::Yellow, 0, XMFLOAT2(0, 0), 0.5f);
 
 	if (g_bInstancing)
-		swprintf_s(wstr, L"Render Mode: Instancing");
+	{
+		const FBX_LOADER::INSTANCE_BUFFER_STATS& instanceStats = g_instanceBuffer.GetStats();
+		swprintf_s(wstr, L"Render Mode: Instancing  Visible: %u/%u  Upload: %u", instanceStats.visibleCount,
+			instanceStats.instanceCount, instanceStats.uploadCount);
+	}
 	else
 		swprintf_s(wstr, L"Render Mode: Single Draw");
 	g_pFont->DrawString(g_pSpriteBatch, wstr, XMFLOAT2(0, 16), DirectX::Colors::Yellow, 0, XMFLOAT2(0, 0), 0.5f);
+
+	const FBX_LOADER::RENDER_QUEUE_STATS& queueStats = g_renderQueue.GetStats();
+	swprintf_s(wstr, L"Draw: %u  Culled: %u  VB: %u  IB: %u  Material: %u  Map: %u  Skipped: %u", queueStats.drawCount,
+		queueStats.culledNodeCount, queueStats.vertexBufferBindCount, queueStats.indexBufferBindCount,
+		queueStats.materialBindCount, queueStats.mapCount, queueStats.skippedBindCount);
+	g_pFont->DrawString(g_pSpriteBatch, wstr, XMFLOAT2(0, 32), DirectX::Colors::Yellow, 0, XMFLOAT2(0, 0), 0.5f);
 	g_pSpriteBatch->End();
 	
 	g_pUserAnotation->EndEvent();
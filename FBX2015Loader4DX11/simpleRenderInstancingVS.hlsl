@@ -13,6 +13,18 @@ cbuffer cbGlobal : register( b0 )
 	matrix WVP;
 };
 
+// CFBXRenderDX11::SetVertexFormatŗʎq_̕p(VERTEX_DEQUANT_DATA)
+cbuffer cbDequant : register( b1 )
+{
+	float4 positionScale;
+	float4 positionOffset;
+};
+
+float4 DecodePosition(float4 pos)
+{
+	return float4(pos.xyz * positionScale.xyz + positionOffset.xyz, 1.0);
+}
+
 struct VS_INPUT
 {
     float4 Pos : POSITION;
@@ -35,7 +47,7 @@ VS_OUTPUT vs_main(VS_INPUT input, uint instanceID : SV_InstanceID)
 
 	instanceWVP = transpose(instanceWVP);
 
-    output.Pos = mul( input.Pos, instanceWVP );
+    output.Pos = mul( DecodePosition(input.Pos), instanceWVP );
 	output.Tex = input.Tex;
 	return output;
 }
\ No newline at end of file
@@ -6,6 +6,18 @@ cbuffer cbGlobal : register( b0 )
 	matrix WVP;
 };
 
+// CFBXRenderDX11::SetVertexFormatŗʎq_̕p(VERTEX_DEQUANT_DATA)
+cbuffer cbDequant : register( b1 )
+{
+	float4 positionScale;
+	float4 positionOffset;
+};
+
+float4 DecodePosition(float4 pos)
+{
+	return float4(pos.xyz * positionScale.xyz + positionOffset.xyz, 1.0);
+}
+
 struct VS_INPUT
 {
     float4 Pos : POSITION;
@@ -23,7 +35,7 @@ VS_OUTPUT vs_main(VS_INPUT input, uint instanceID : SV_InstanceID)
 {
 	VS_OUTPUT output;
 
-    output.Pos = mul( input.Pos, WVP );
+    output.Pos = mul( DecodePosition(input.Pos), WVP );
 	output.Tex = input.Tex;
 	return output;
 }
\ No newline at end of file
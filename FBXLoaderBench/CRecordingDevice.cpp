@@ -0,0 +1,259 @@
+// *********************************************************************************************************************
+///
+/// @file 		CRecordingDevice.cpp
+/// @brief		ۂ̃foCXEReLXgɓ], Ă΂ꂽAPỈ񐔂ƃobt@̃oCg𐔂郉bp[
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#include "CRecordingDevice.h"
+
+#include <psapi.h>
+
+// p(t@C)}bv̈wĂ邩
+static bool IsMappedMemory(const void* p)
+{
+	if(p == nullptr)
+		return false;
+
+	MEMORY_BASIC_INFORMATION info;
+	if(VirtualQuery(p, &info, sizeof(info)) == 0)
+		return false;
+
+	return info.Type == MEM_MAPPED;
+}
+
+static size_t GetWorkingSet()
+{
+	PROCESS_MEMORY_COUNTERS counters;
+	counters.cb = sizeof(counters);
+	if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return 0;
+
+	return counters.WorkingSetSize;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// CRecordingContext
+// ---------------------------------------------------------------------------------------------------------------------
+
+CRecordingContext::CRecordingContext()
+{
+	m_pDevice = nullptr;
+	m_pContext = nullptr;
+	m_pContext1 = nullptr;
+}
+
+CRecordingContext::~CRecordingContext()
+{
+	Release_();
+}
+
+void CRecordingContext::Initialize(CRecordingDevice* pDevice, ID3D11DeviceContext* pContext)
+{
+	m_pDevice = pDevice;
+	m_pContext = pContext;
+	m_pContext->AddRef();
+
+	// Ă悢(̎ID3D11DeviceContext1ԂȂ)
+	if(FAILED(m_pContext->QueryInterface(__uuidof(ID3D11DeviceContext1), (void**)&m_pContext1)))
+		m_pContext1 = nullptr;
+}
+
+void CRecordingContext::Release_()
+{
+	if(m_pContext1)
+	{
+		m_pContext1->Release();
+		m_pContext1 = nullptr;
+	}
+	if(m_pContext)
+	{
+		m_pContext->Release();
+		m_pContext = nullptr;
+	}
+	m_pDevice = nullptr;
+}
+
+HRESULT CRecordingContext::QueryInterface(REFIID riid, void** ppvObject)
+{
+	if(ppvObject == nullptr)
+		return E_POINTER;
+
+	if(riid == __uuidof(IUnknown) || riid == __uuidof(ID3D11DeviceChild) || riid == __uuidof(ID3D11DeviceContext)
+		|| (riid == __uuidof(ID3D11DeviceContext1) && m_pContext1 != nullptr))
+	{
+		*ppvObject = static_cast<ID3D11DeviceContext1*>(this);
+		AddRef();
+		return S_OK;
+	}
+
+	// ID3D11DeviceContext1, ID3DUserDefinedAnnotationȂǂ͎ۂ̃ReLXg̕Ԃ(Ȃ)
+	return m_pContext->QueryInterface(riid, ppvObject);
+}
+
+ULONG CRecordingContext::AddRef()
+{
+	return m_pDevice->AddRef();
+}
+
+ULONG CRecordingContext::Release()
+{
+	return m_pDevice->Release();
+}
+
+void CRecordingContext::GetDevice(ID3D11Device** ppDevice)
+{
+	m_pDevice->AddRef();
+	*ppDevice = m_pDevice;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// CRecordingDevice
+// ---------------------------------------------------------------------------------------------------------------------
+
+CRecordingDevice::CRecordingDevice(ID3D11Device* pDevice)
+{
+	m_refCount = 1;
+	m_pDevice = pDevice;
+	m_pDevice->AddRef();
+	m_sampleWorkingSet = false;
+
+	ID3D11DeviceContext* pContext = nullptr;
+	m_pDevice->GetImmediateContext(&pContext);
+	m_context.Initialize(this, pContext);
+	pContext->Release();
+}
+
+CRecordingDevice::~CRecordingDevice()
+{
+	m_context.Release_();
+
+	if(m_pDevice)
+	{
+		m_pDevice->Release();
+		m_pDevice = nullptr;
+	}
+}
+
+HRESULT CRecordingDevice::Create(ID3D11Device* pDevice, CRecordingDevice** ppRecordingDevice)
+{
+	if(pDevice == nullptr || ppRecordingDevice == nullptr)
+		return E_INVALIDARG;
+
+	*ppRecordingDevice = new(std::nothrow) CRecordingDevice(pDevice);
+	if(*ppRecordingDevice == nullptr)
+		return E_OUTOFMEMORY;
+
+	return S_OK;
+}
+
+RECORDING_STATS CRecordingDevice::GetStats()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_stats;
+}
+
+void CRecordingDevice::ResetStats()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_stats.Reset();
+}
+
+void CRecordingDevice::SetSampleWorkingSet(const bool enable)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_sampleWorkingSet = enable;
+}
+
+void CRecordingDevice::Record(const RECORD_CALL call)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_stats.callCount[call]++;
+}
+
+void CRecordingDevice::RecordBuffer(const D3D11_BUFFER_DESC* pDesc, const D3D11_SUBRESOURCE_DATA* pInitialData)
+{
+	// VirtualQueryƃ[LOZbg̓bN̊OŎ
+	const bool isMapped = (pInitialData != nullptr) && IsMappedMemory(pInitialData->pSysMem);
+	bool sampleWorkingSet;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		sampleWorkingSet = m_sampleWorkingSet;
+	}
+	const size_t workingSet = sampleWorkingSet ? GetWorkingSet() : 0;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_stats.callCount[RECORD_CREATE_BUFFER]++;
+
+	if(pDesc == nullptr)
+		return;
+
+	const uint64_t bytes = pDesc->ByteWidth;
+	m_stats.bufferBytes += bytes;
+	if(bytes > m_stats.maxBufferBytes)
+		m_stats.maxBufferBytes = bytes;
+
+	if(pDesc->BindFlags & D3D11_BIND_VERTEX_BUFFER)
+	{
+		m_stats.vertexBufferCount++;
+		m_stats.vertexBufferBytes += bytes;
+	}
+	if(pDesc->BindFlags & D3D11_BIND_INDEX_BUFFER)
+	{
+		m_stats.indexBufferCount++;
+		m_stats.indexBufferBytes += bytes;
+	}
+	if(pDesc->BindFlags & D3D11_BIND_CONSTANT_BUFFER)
+		m_stats.constantBufferCount++;
+
+	if(isMapped)
+		m_stats.mappedInitDataCount++;
+
+	if(workingSet > m_stats.peakWorkingSet)
+		m_stats.peakWorkingSet = workingSet;
+}
+
+HRESULT CRecordingDevice::QueryInterface(REFIID riid, void** ppvObject)
+{
+	if(ppvObject == nullptr)
+		return E_POINTER;
+
+	if(riid == __uuidof(IUnknown) || riid == __uuidof(ID3D11Device))
+	{
+		*ppvObject = static_cast<ID3D11Device*>(this);
+		AddRef();
+		return S_OK;
+	}
+
+	// IDXGIDevice, ID3D11Device1Ȃǂ͎ۂ̃foCX̕Ԃ(̌Ăяo͐Ȃ)
+	return m_pDevice->QueryInterface(riid, ppvObject);
+}
+
+ULONG CRecordingDevice::AddRef()
+{
+	return InterlockedIncrement(&m_refCount);
+}
+
+ULONG CRecordingDevice::Release()
+{
+	const ULONG refCount = InterlockedDecrement(&m_refCount);
+	if(refCount == 0)
+		delete this;
+
+	return refCount;
+}
+
+HRESULT CRecordingDevice::CreateBuffer(const D3D11_BUFFER_DESC* pDesc, const D3D11_SUBRESOURCE_DATA* pInitialData, ID3D11Buffer** ppBuffer)
+{
+	RecordBuffer(pDesc, pInitialData);
+	return m_pDevice->CreateBuffer(pDesc, pInitialData, ppBuffer);
+}
+
+void CRecordingDevice::GetImmediateContext(ID3D11DeviceContext** ppImmediateContext)
+{
+	AddRef();
+	*ppImmediateContext = &m_context;
+}
@@ -0,0 +1,336 @@
+// *********************************************************************************************************************
+///
+/// @file 		CRecordingDevice.h
+/// @brief		ۂ̃foCXEReLXgɓ], Ă΂ꂽAPỈ񐔂ƃobt@̃oCg𐔂郉bp[
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#pragma once
+
+#include <stdint.h>
+#include <mutex>
+
+#include <windows.h>
+#include <d3d11.h>
+#include <d3d11_1.h>
+
+// API. ނ̂̂͂܂Ƃ߂
+enum RECORD_CALL
+{
+	// ID3D11Device
+	RECORD_CREATE_BUFFER = 0,
+	RECORD_CREATE_TEXTURE,				// 1D/2D/3D
+	RECORD_CREATE_VIEW,					// SRV/UAV/RTV/DSV
+	RECORD_CREATE_INPUT_LAYOUT,
+	RECORD_CREATE_SAMPLER,
+	RECORD_CREATE_OTHER,				// VF[_, ̃Xe[g, NGȂ
+
+	// ID3D11DeviceContext
+	RECORD_IA_SET_INPUT_LAYOUT,
+	RECORD_IA_SET_VERTEX_BUFFERS,
+	RECORD_IA_SET_INDEX_BUFFER,
+	RECORD_IA_SET_PRIMITIVE_TOPOLOGY,
+	RECORD_VS_SET_CONSTANT_BUFFERS,		// VSSetConstantBuffers1܂
+	RECORD_VS_SET_SHADER_RESOURCES,
+	RECORD_PS_SET_SHADER_RESOURCES,
+	RECORD_PS_SET_SAMPLERS,
+	RECORD_PS_SET_CONSTANT_BUFFERS,		// PSSetConstantBuffers1܂
+	RECORD_SET_SHADER,					// SXe[W
+	RECORD_DRAW,						// Draw*, Dispatch*
+	RECORD_MAP,
+	RECORD_UPDATE_SUBRESOURCE,			// UpdateSubresource, CopyResourceȂ
+	RECORD_CONTEXT_OTHER,				// ȊO̐ݒn(Get*͐Ȃ)
+
+	RECORD_CALL_MAX,
+};
+
+struct RECORDING_STATS
+{
+	uint32_t	callCount[RECORD_CALL_MAX];
+
+	// CreateBufferBindFlagsʂ̉񐔂ByteWidth̍v
+	uint32_t	vertexBufferCount;
+	uint32_t	indexBufferCount;
+	uint32_t	constantBufferCount;
+	uint64_t	vertexBufferBytes;
+	uint64_t	indexBufferBytes;
+	uint64_t	bufferBytes;				// SẴobt@
+	uint64_t	maxBufferBytes;				// ԑ傫obt@
+	uint32_t	mappedInitDataCount;		// f[^(pSysMem)t@C}bv̈𒼐ڎwĂCreateBuffer
+	size_t		peakWorkingSet;				// SetSampleWorkingSetCreateBuffer̒Oő[LOZbg̍ő
+
+	RECORDING_STATS()
+	{
+		Reset();
+	}
+
+	void Reset()
+	{
+		for(int i=0;i<RECORD_CALL_MAX;i++)
+			callCount[i] = 0;
+		vertexBufferCount = 0;
+		indexBufferCount = 0;
+		constantBufferCount = 0;
+		vertexBufferBytes = 0;
+		indexBufferBytes = 0;
+		bufferBytes = 0;
+		maxBufferBytes = 0;
+		mappedInitDataCount = 0;
+		peakWorkingSet = 0;
+	}
+
+	uint32_t GetCount(const RECORD_CALL call) const { return callCount[call]; }
+};
+
+class CRecordingDevice;
+
+// ReLXg̃bp[. QƃJEgCRecordingDeviceƋL(foCX)
+class CRecordingContext : public ID3D11DeviceContext1
+{
+	CRecordingDevice*		m_pDevice;
+	ID3D11DeviceContext*	m_pContext;
+	ID3D11DeviceContext1*	m_pContext1;	// D3D11.1̃^Cnullptr
+	RECORDING_STATS			m_stats;		// ReLXg1̃Xbh炵Ă΂Ȃ
+
+	CRecordingContext(const CRecordingContext&);
+	CRecordingContext& operator=(const CRecordingContext&);
+
+	void Record(const RECORD_CALL call){ m_stats.callCount[call]++; }
+
+public:
+	CRecordingContext();
+	~CRecordingContext();
+
+	void Initialize(CRecordingDevice* pDevice, ID3D11DeviceContext* pContext);
+	void Release_();
+
+	const RECORDING_STATS& GetStats() const { return m_stats; }
+	void ResetStats(){ m_stats.Reset(); }
+
+	// IUnknown
+	virtual HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject);
+	virtual ULONG STDMETHODCALLTYPE AddRef();
+	virtual ULONG STDMETHODCALLTYPE Release();
+
+	// ID3D11DeviceChild
+	virtual void STDMETHODCALLTYPE GetDevice(ID3D11Device** ppDevice);
+	virtual HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID guid, UINT* pDataSize, void* pData){ return m_pContext->GetPrivateData(guid, pDataSize, pData); }
+	virtual HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID guid, UINT DataSize, const void* pData){ return m_pContext->SetPrivateData(guid, DataSize, pData); }
+	virtual HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID guid, const IUnknown* pData){ return m_pContext->SetPrivateDataInterface(guid, pData); }
+
+	// ID3D11DeviceContext
+	virtual void STDMETHODCALLTYPE VSSetConstantBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer* const* ppConstantBuffers){ Record(RECORD_VS_SET_CONSTANT_BUFFERS); m_pContext->VSSetConstantBuffers(StartSlot, NumBuffers, ppConstantBuffers); }
+	virtual void STDMETHODCALLTYPE PSSetShaderResources(UINT StartSlot, UINT NumViews, ID3D11ShaderResourceView* const* ppShaderResourceViews){ Record(RECORD_PS_SET_SHADER_RESOURCES); m_pContext->PSSetShaderResources(StartSlot, NumViews, ppShaderResourceViews); }
+	virtual void STDMETHODCALLTYPE PSSetShader(ID3D11PixelShader* pPixelShader, ID3D11ClassInstance* const* ppClassInstances, UINT NumClassInstances){ Record(RECORD_SET_SHADER); m_pContext->PSSetShader(pPixelShader, ppClassInstances, NumClassInstances); }
+	virtual void STDMETHODCALLTYPE PSSetSamplers(UINT StartSlot, UINT NumSamplers, ID3D11SamplerState* const* ppSamplers){ Record(RECORD_PS_SET_SAMPLERS); m_pContext->PSSetSamplers(StartSlot, NumSamplers, ppSamplers); }
+	virtual void STDMETHODCALLTYPE VSSetShader(ID3D11VertexShader* pVertexShader, ID3D11ClassInstance* const* ppClassInstances, UINT NumClassInstances){ Record(RECORD_SET_SHADER); m_pContext->VSSetShader(pVertexShader, ppClassInstances, NumClassInstances); }
+	virtual void STDMETHODCALLTYPE DrawIndexed(UINT IndexCount, UINT StartIndexLocation, INT BaseVertexLocation){ Record(RECORD_DRAW); m_pContext->DrawIndexed(IndexCount, StartIndexLocation, BaseVertexLocation); }
+	virtual void STDMETHODCALLTYPE Draw(UINT VertexCount, UINT StartVertexLocation){ Record(RECORD_DRAW); m_pContext->Draw(VertexCount, StartVertexLocation); }
+	virtual HRESULT STDMETHODCALLTYPE Map(ID3D11Resource* pResource, UINT Subresource, D3D11_MAP MapType, UINT MapFlags, D3D11_MAPPED_SUBRESOURCE* pMappedResource){ Record(RECORD_MAP); return m_pContext->Map(pResource, Subresource, MapType, MapFlags, pMappedResource); }
+	virtual void STDMETHODCALLTYPE Unmap(ID3D11Resource* pResource, UINT Subresource){ m_pContext->Unmap(pResource, Subresource); }
+	virtual void STDMETHODCALLTYPE PSSetConstantBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer* const* ppConstantBuffers){ Record(RECORD_PS_SET_CONSTANT_BUFFERS); m_pContext->PSSetConstantBuffers(StartSlot, NumBuffers, ppConstantBuffers); }
+	virtual void STDMETHODCALLTYPE IASetInputLayout(ID3D11InputLayout* pInputLayout){ Record(RECORD_IA_SET_INPUT_LAYOUT); m_pContext->IASetInputLayout(pInputLayout); }
+	virtual void STDMETHODCALLTYPE IASetVertexBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer* const* ppVertexBuffers, const UINT* pStrides, const UINT* pOffsets){ Record(RECORD_IA_SET_VERTEX_BUFFERS); m_pContext->IASetVertexBuffers(StartSlot, NumBuffers, ppVertexBuffers, pStrides, pOffsets); }
+	virtual void STDMETHODCALLTYPE IASetIndexBuffer(ID3D11Buffer* pIndexBuffer, DXGI_FORMAT Format, UINT Offset){ Record(RECORD_IA_SET_INDEX_BUFFER); m_pContext->IASetIndexBuffer(pIndexBuffer, Format, Offset); }
+	virtual void STDMETHODCALLTYPE DrawIndexedInstanced(UINT IndexCountPerInstance, UINT InstanceCount, UINT StartIndexLocation, INT BaseVertexLocation, UINT StartInstanceLocation){ Record(RECORD_DRAW); m_pContext->DrawIndexedInstanced(IndexCountPerInstance, InstanceCount, StartIndexLocation, BaseVertexLocation, StartInstanceLocation); }
+	virtual void STDMETHODCALLTYPE DrawInstanced(UINT VertexCountPerInstance, UINT InstanceCount, UINT StartVertexLocation, UINT StartInstanceLocation){ Record(RECORD_DRAW); m_pContext->DrawInstanced(VertexCountPerInstance, InstanceCount, StartVertexLocation, StartInstanceLocation); }
+	virtual void STDMETHODCALLTYPE GSSetConstantBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer* const* ppConstantBuffers){ Record(RECORD_CONTEXT_OTHER); m_pContext->GSSetConstantBuffers(StartSlot, NumBuffers, ppConstantBuffers); }
+	virtual void STDMETHODCALLTYPE GSSetShader(ID3D11GeometryShader* pShader, ID3D11ClassInstance* const* ppClassInstances, UINT NumClassInstances){ Record(RECORD_SET_SHADER); m_pContext->GSSetShader(pShader, ppClassInstances, NumClassInstances); }
+	virtual void STDMETHODCALLTYPE IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY Topology){ Record(RECORD_IA_SET_PRIMITIVE_TOPOLOGY); m_pContext->IASetPrimitiveTopology(Topology); }
+	virtual void STDMETHODCALLTYPE VSSetShaderResources(UINT StartSlot, UINT NumViews, ID3D11ShaderResourceView* const* ppShaderResourceViews){ Record(RECORD_VS_SET_SHADER_RESOURCES); m_pContext->VSSetShaderResources(StartSlot, NumViews, ppShaderResourceViews); }
+	virtual void STDMETHODCALLTYPE VSSetSamplers(UINT StartSlot, UINT NumSamplers, ID3D11SamplerState* const* ppSamplers){ Record(RECORD_CONTEXT_OTHER); m_pContext->VSSetSamplers(StartSlot, NumSamplers, ppSamplers); }
+	virtual void STDMETHODCALLTYPE Begin(ID3D11Asynchronous* pAsync){ Record(RECORD_CONTEXT_OTHER); m_pContext->Begin(pAsync); }
+	virtual void STDMETHODCALLTYPE End(ID3D11Asynchronous* pAsync){ Record(RECORD_CONTEXT_OTHER); m_pContext->End(pAsync); }
+	virtual HRESULT STDMETHODCALLTYPE GetData(ID3D11Asynchronous* pAsync, void* pData, UINT DataSize, UINT GetDataFlags){ return m_pContext->GetData(pAsync, pData, DataSize, GetDataFlags); }
+	virtual void STDMETHODCALLTYPE SetPredication(ID3D11Predicate* pPredicate, BOOL PredicateValue){ Record(RECORD_CONTEXT_OTHER); m_pContext->SetPredication(pPredicate, PredicateValue); }
+	virtual void STDMETHODCALLTYPE GSSetShaderResources(UINT StartSlot, UINT NumViews, ID3D11ShaderResourceView* const* ppShaderResourceViews){ Record(RECORD_CONTEXT_OTHER); m_pContext->GSSetShaderResources(StartSlot, NumViews, ppShaderResourceViews); }
+	virtual void STDMETHODCALLTYPE GSSetSamplers(UINT StartSlot, UINT NumSamplers, ID3D11SamplerState* const* ppSamplers){ Record(RECORD_CONTEXT_OTHER); m_pContext->GSSetSamplers(StartSlot, NumSamplers, ppSamplers); }
+	virtual void STDMETHODCALLTYPE OMSetRenderTargets(UINT NumViews, ID3D11RenderTargetView* const* ppRenderTargetViews, ID3D11DepthStencilView* pDepthStencilView){ Record(RECORD_CONTEXT_OTHER); m_pContext->OMSetRenderTargets(NumViews, ppRenderTargetViews, pDepthStencilView); }
+	virtual void STDMETHODCALLTYPE OMSetRenderTargetsAndUnorderedAccessViews(UINT NumRTVs, ID3D11RenderTargetView* const* ppRenderTargetViews, ID3D11DepthStencilView* pDepthStencilView, UINT UAVStartSlot, UINT NumUAVs, ID3D11UnorderedAccessView* const* ppUnorderedAccessViews, const UINT* pUAVInitialCounts){ Record(RECORD_CONTEXT_OTHER); m_pContext->OMSetRenderTargetsAndUnorderedAccessViews(NumRTVs, ppRenderTargetViews, pDepthStencilView, UAVStartSlot, NumUAVs, ppUnorderedAccessViews, pUAVInitialCounts); }
+	virtual void STDMETHODCALLTYPE OMSetBlendState(ID3D11BlendState* pBlendState, const FLOAT BlendFactor[4], UINT SampleMask){ Record(RECORD_CONTEXT_OTHER); m_pContext->OMSetBlendState(pBlendState, BlendFactor, SampleMask); }
+	virtual void STDMETHODCALLTYPE OMSetDepthStencilState(ID3D11DepthStencilState* pDepthStencilState, UINT StencilRef){ Record(RECORD_CONTEXT_OTHER); m_pContext->OMSetDepthStencilState(pDepthStencilState, StencilRef); }
+	virtual void STDMETHODCALLTYPE SOSetTargets(UINT NumBuffers, ID3D11Buffer* const* ppSOTargets, const UINT* pOffsets){ Record(RECORD_CONTEXT_OTHER); m_pContext->SOSetTargets(NumBuffers, ppSOTargets, pOffsets); }
+	virtual void STDMETHODCALLTYPE DrawAuto(){ Record(RECORD_DRAW); m_pContext->DrawAuto(); }
+	virtual void STDMETHODCALLTYPE DrawIndexedInstancedIndirect(ID3D11Buffer* pBufferForArgs, UINT AlignedByteOffsetForArgs){ Record(RECORD_DRAW); m_pContext->DrawIndexedInstancedIndirect(pBufferForArgs, AlignedByteOffsetForArgs); }
+	virtual void STDMETHODCALLTYPE DrawInstancedIndirect(ID3D11Buffer* pBufferForArgs, UINT AlignedByteOffsetForArgs){ Record(RECORD_DRAW); m_pContext->DrawInstancedIndirect(pBufferForArgs, AlignedByteOffsetForArgs); }
+	virtual void STDMETHODCALLTYPE Dispatch(UINT ThreadGroupCountX, UINT ThreadGroupCountY, UINT ThreadGroupCountZ){ Record(RECORD_DRAW); m_pContext->Dispatch(ThreadGroupCountX, ThreadGroupCountY, ThreadGroupCountZ); }
+	virtual void STDMETHODCALLTYPE DispatchIndirect(ID3D11Buffer* pBufferForArgs, UINT AlignedByteOffsetForArgs){ Record(RECORD_DRAW); m_pContext->DispatchIndirect(pBufferForArgs, AlignedByteOffsetForArgs); }
+	virtual void STDMETHODCALLTYPE RSSetState(ID3D11RasterizerState* pRasterizerState){ Record(RECORD_CONTEXT_OTHER); m_pContext->RSSetState(pRasterizerState); }
+	virtual void STDMETHODCALLTYPE RSSetViewports(UINT NumViewports, const D3D11_VIEWPORT* pViewports){ Record(RECORD_CONTEXT_OTHER); m_pContext->RSSetViewports(NumViewports, pViewports); }
+	virtual void STDMETHODCALLTYPE RSSetScissorRects(UINT NumRects, const D3D11_RECT* pRects){ Record(RECORD_CONTEXT_OTHER); m_pContext->RSSetScissorRects(NumRects, pRects); }
+	virtual void STDMETHODCALLTYPE CopySubresourceRegion(ID3D11Resource* pDstResource, UINT DstSubresource, UINT DstX, UINT DstY, UINT DstZ, ID3D11Resource* pSrcResource, UINT SrcSubresource, const D3D11_BOX* pSrcBox){ Record(RECORD_UPDATE_SUBRESOURCE); m_pContext->CopySubresourceRegion(pDstResource, DstSubresource, DstX, DstY, DstZ, pSrcResource, SrcSubresource, pSrcBox); }
+	virtual void STDMETHODCALLTYPE CopyResource(ID3D11Resource* pDstResource, ID3D11Resource* pSrcResource){ Record(RECORD_UPDATE_SUBRESOURCE); m_pContext->CopyResource(pDstResource, pSrcResource); }
+	virtual void STDMETHODCALLTYPE UpdateSubresource(ID3D11Resource* pDstResource, UINT DstSubresource, const D3D11_BOX* pDstBox, const void* pSrcData, UINT SrcRowPitch, UINT SrcDepthPitch){ Record(RECORD_UPDATE_SUBRESOURCE); m_pContext->UpdateSubresource(pDstResource, DstSubresource, pDstBox, pSrcData, SrcRowPitch, SrcDepthPitch); }
+	virtual void STDMETHODCALLTYPE CopyStructureCount(ID3D11Buffer* pDstBuffer, UINT DstAlignedByteOffset, ID3D11UnorderedAccessView* pSrcView){ Record(RECORD_UPDATE_SUBRESOURCE); m_pContext->CopyStructureCount(pDstBuffer, DstAlignedByteOffset, pSrcView); }
+	virtual void STDMETHODCALLTYPE ClearRenderTargetView(ID3D11RenderTargetView* pRenderTargetView, const FLOAT ColorRGBA[4]){ Record(RECORD_CONTEXT_OTHER); m_pContext->ClearRenderTargetView(pRenderTargetView, ColorRGBA); }
+	virtual void STDMETHODCALLTYPE ClearUnorderedAccessViewUint(ID3D11UnorderedAccessView* pUnorderedAccessView, const UINT Values[4]){ Record(RECORD_CONTEXT_OTHER); m_pContext->ClearUnorderedAccessViewUint(pUnorderedAccessView, Values); }
+	virtual void STDMETHODCALLTYPE ClearUnorderedAccessViewFloat(ID3D11UnorderedAccessView* pUnorderedAccessView, const FLOAT Values[4]){ Record(RECORD_CONTEXT_OTHER); m_pContext->ClearUnorderedAccessViewFloat(pUnorderedAccessView, Values); }
+	virtual void STDMETHODCALLTYPE ClearDepthStencilView(ID3D11DepthStencilView* pDepthStencilView, UINT ClearFlags, FLOAT Depth, UINT8 Stencil){ Record(RECORD_CONTEXT_OTHER); m_pContext->ClearDepthStencilView(pDepthStencilView, ClearFlags, Depth, Stencil); }
+	virtual void STDMETHODCALLTYPE GenerateMips(ID3D11ShaderResourceView* pShaderResourceView){ Record(RECORD_UPDATE_SUBRESOURCE); m_pContext->GenerateMips(pShaderResourceView); }
+	virtual void STDMETHODCALLTYPE SetResourceMinLOD(ID3D11Resource* pResource, FLOAT MinLOD){ Record(RECORD_CONTEXT_OTHER); m_pContext->SetResourceMinLOD(pResource, MinLOD); }
+	virtual FLOAT STDMETHODCALLTYPE GetResourceMinLOD(ID3D11Resource* pResource){ return m_pContext->GetResourceMinLOD(pResource); }
+	virtual void STDMETHODCALLTYPE ResolveSubresource(ID3D11Resource* pDstResource, UINT DstSubresource, ID3D11Resource* pSrcResource, UINT SrcSubresource, DXGI_FORMAT Format){ Record(RECORD_UPDATE_SUBRESOURCE); m_pContext->ResolveSubresource(pDstResource, DstSubresource, pSrcResource, SrcSubresource, Format); }
+	virtual void STDMETHODCALLTYPE ExecuteCommandList(ID3D11CommandList* pCommandList, BOOL RestoreContextState){ Record(RECORD_CONTEXT_OTHER); m_pContext->ExecuteCommandList(pCommandList, RestoreContextState); }
+	virtual void STDMETHODCALLTYPE HSSetShaderResources(UINT StartSlot, UINT NumViews, ID3D11ShaderResourceView* const* ppShaderResourceViews){ Record(RECORD_CONTEXT_OTHER); m_pContext->HSSetShaderResources(StartSlot, NumViews, ppShaderResourceViews); }
+	virtual void STDMETHODCALLTYPE HSSetShader(ID3D11HullShader* pHullShader, ID3D11ClassInstance* const* ppClassInstances, UINT NumClassInstances){ Record(RECORD_SET_SHADER); m_pContext->HSSetShader(pHullShader, ppClassInstances, NumClassInstances); }
+	virtual void STDMETHODCALLTYPE HSSetSamplers(UINT StartSlot, UINT NumSamplers, ID3D11SamplerState* const* ppSamplers){ Record(RECORD_CONTEXT_OTHER); m_pContext->HSSetSamplers(StartSlot, NumSamplers, ppSamplers); }
+	virtual void STDMETHODCALLTYPE HSSetConstantBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer* const* ppConstantBuffers){ Record(RECORD_CONTEXT_OTHER); m_pContext->HSSetConstantBuffers(StartSlot, NumBuffers, ppConstantBuffers); }
+	virtual void STDMETHODCALLTYPE DSSetShaderResources(UINT StartSlot, UINT NumViews, ID3D11ShaderResourceView* const* ppShaderResourceViews){ Record(RECORD_CONTEXT_OTHER); m_pContext->DSSetShaderResources(StartSlot, NumViews, ppShaderResourceViews); }
+	virtual void STDMETHODCALLTYPE DSSetShader(ID3D11DomainShader* pDomainShader, ID3D11ClassInstance* const* ppClassInstances, UINT NumClassInstances){ Record(RECORD_SET_SHADER); m_pContext->DSSetShader(pDomainShader, ppClassInstances, NumClassInstances); }
+	virtual void STDMETHODCALLTYPE DSSetSamplers(UINT StartSlot, UINT NumSamplers, ID3D11SamplerState* const* ppSamplers){ Record(RECORD_CONTEXT_OTHER); m_pContext->DSSetSamplers(StartSlot, NumSamplers, ppSamplers); }
+	virtual void STDMETHODCALLTYPE DSSetConstantBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer* const* ppConstantBuffers){ Record(RECORD_CONTEXT_OTHER); m_pContext->DSSetConstantBuffers(StartSlot, NumBuffers, ppConstantBuffers); }
+	virtual void STDMETHODCALLTYPE CSSetShaderResources(UINT StartSlot, UINT NumViews, ID3D11ShaderResourceView* const* ppShaderResourceViews){ Record(RECORD_CONTEXT_OTHER); m_pContext->CSSetShaderResources(StartSlot, NumViews, ppShaderResourceViews); }
+	virtual void STDMETHODCALLTYPE CSSetUnorderedAccessViews(UINT StartSlot, UINT NumUAVs, ID3D11UnorderedAccessView* const* ppUnorderedAccessViews, const UINT* pUAVInitialCounts){ Record(RECORD_CONTEXT_OTHER); m_pContext->CSSetUnorderedAccessViews(StartSlot, NumUAVs, ppUnorderedAccessViews, pUAVInitialCounts); }
+	virtual void STDMETHODCALLTYPE CSSetShader(ID3D11ComputeShader* pComputeShader, ID3D11ClassInstance* const* ppClassInstances, UINT NumClassInstances){ Record(RECORD_SET_SHADER); m_pContext->CSSetShader(pComputeShader, ppClassInstances, NumClassInstances); }
+	virtual void STDMETHODCALLTYPE CSSetSamplers(UINT StartSlot, UINT NumSamplers, ID3D11SamplerState* const* ppSamplers){ Record(RECORD_CONTEXT_OTHER); m_pContext->CSSetSamplers(StartSlot, NumSamplers, ppSamplers); }
+	virtual void STDMETHODCALLTYPE CSSetConstantBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer* const* ppConstantBuffers){ Record(RECORD_CONTEXT_OTHER); m_pContext->CSSetConstantBuffers(StartSlot, NumBuffers, ppConstantBuffers); }
+	virtual void STDMETHODCALLTYPE VSGetConstantBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer** ppConstantBuffers){ m_pContext->VSGetConstantBuffers(StartSlot, NumBuffers, ppConstantBuffers); }
+	virtual void STDMETHODCALLTYPE PSGetShaderResources(UINT StartSlot, UINT NumViews, ID3D11ShaderResourceView** ppShaderResourceViews){ m_pContext->PSGetShaderResources(StartSlot, NumViews, ppShaderResourceViews); }
+	virtual void STDMETHODCALLTYPE PSGetShader(ID3D11PixelShader** ppPixelShader, ID3D11ClassInstance** ppClassInstances, UINT* pNumClassInstances){ m_pContext->PSGetShader(ppPixelShader, ppClassInstances, pNumClassInstances); }
+	virtual void STDMETHODCALLTYPE PSGetSamplers(UINT StartSlot, UINT NumSamplers, ID3D11SamplerState** ppSamplers){ m_pContext->PSGetSamplers(StartSlot, NumSamplers, ppSamplers); }
+	virtual void STDMETHODCALLTYPE VSGetShader(ID3D11VertexShader** ppVertexShader, ID3D11ClassInstance** ppClassInstances, UINT* pNumClassInstances){ m_pContext->VSGetShader(ppVertexShader, ppClassInstances, pNumClassInstances); }
+	virtual void STDMETHODCALLTYPE PSGetConstantBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer** ppConstantBuffers){ m_pContext->PSGetConstantBuffers(StartSlot, NumBuffers, ppConstantBuffers); }
+	virtual void STDMETHODCALLTYPE IAGetInputLayout(ID3D11InputLayout** ppInputLayout){ m_pContext->IAGetInputLayout(ppInputLayout); }
+	virtual void STDMETHODCALLTYPE IAGetVertexBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer** ppVertexBuffers, UINT* pStrides, UINT* pOffsets){ m_pContext->IAGetVertexBuffers(StartSlot, NumBuffers, ppVertexBuffers, pStrides, pOffsets); }
+	virtual void STDMETHODCALLTYPE IAGetIndexBuffer(ID3D11Buffer** pIndexBuffer, DXGI_FORMAT* Format, UINT* Offset){ m_pContext->IAGetIndexBuffer(pIndexBuffer, Format, Offset); }
+	virtual void STDMETHODCALLTYPE GSGetConstantBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer** ppConstantBuffers){ m_pContext->GSGetConstantBuffers(StartSlot, NumBuffers, ppConstantBuffers); }
+	virtual void STDMETHODCALLTYPE GSGetShader(ID3D11GeometryShader** ppGeometryShader, ID3D11ClassInstance** ppClassInstances, UINT* pNumClassInstances){ m_pContext->GSGetShader(ppGeometryShader, ppClassInstances, pNumClassInstances); }
+	virtual void STDMETHODCALLTYPE IAGetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY* pTopology){ m_pContext->IAGetPrimitiveTopology(pTopology); }
+	virtual void STDMETHODCALLTYPE VSGetShaderResources(UINT StartSlot, UINT NumViews, ID3D11ShaderResourceView** ppShaderResourceViews){ m_pContext->VSGetShaderResources(StartSlot, NumViews, ppShaderResourceViews); }
+	virtual void STDMETHODCALLTYPE VSGetSamplers(UINT StartSlot, UINT NumSamplers, ID3D11SamplerState** ppSamplers){ m_pContext->VSGetSamplers(StartSlot, NumSamplers, ppSamplers); }
+	virtual void STDMETHODCALLTYPE GetPredication(ID3D11Predicate** ppPredicate, BOOL* pPredicateValue){ m_pContext->GetPredication(ppPredicate, pPredicateValue); }
+	virtual void STDMETHODCALLTYPE GSGetShaderResources(UINT StartSlot, UINT NumViews, ID3D11ShaderResourceView** ppShaderResourceViews){ m_pContext->GSGetShaderResources(StartSlot, NumViews, ppShaderResourceViews); }
+	virtual void STDMETHODCALLTYPE GSGetSamplers(UINT StartSlot, UINT NumSamplers, ID3D11SamplerState** ppSamplers){ m_pContext->GSGetSamplers(StartSlot, NumSamplers, ppSamplers); }
+	virtual void STDMETHODCALLTYPE OMGetRenderTargets(UINT NumViews, ID3D11RenderTargetView** ppRenderTargetViews, ID3D11DepthStencilView** ppDepthStencilView){ m_pContext->OMGetRenderTargets(NumViews, ppRenderTargetViews, ppDepthStencilView); }
+	virtual void STDMETHODCALLTYPE OMGetRenderTargetsAndUnorderedAccessViews(UINT NumRTVs, ID3D11RenderTargetView** ppRenderTargetViews, ID3D11DepthStencilView** ppDepthStencilView, UINT UAVStartSlot, UINT NumUAVs, ID3D11UnorderedAccessView** ppUnorderedAccessViews){ m_pContext->OMGetRenderTargetsAndUnorderedAccessViews(NumRTVs, ppRenderTargetViews, ppDepthStencilView, UAVStartSlot, NumUAVs, ppUnorderedAccessViews); }
+	virtual void STDMETHODCALLTYPE OMGetBlendState(ID3D11BlendState** ppBlendState, FLOAT BlendFactor[4], UINT* pSampleMask){ m_pContext->OMGetBlendState(ppBlendState, BlendFactor, pSampleMask); }
+	virtual void STDMETHODCALLTYPE OMGetDepthStencilState(ID3D11DepthStencilState** ppDepthStencilState, UINT* pStencilRef){ m_pContext->OMGetDepthStencilState(ppDepthStencilState, pStencilRef); }
+	virtual void STDMETHODCALLTYPE SOGetTargets(UINT NumBuffers, ID3D11Buffer** ppSOTargets){ m_pContext->SOGetTargets(NumBuffers, ppSOTargets); }
+	virtual void STDMETHODCALLTYPE RSGetState(ID3D11RasterizerState** ppRasterizerState){ m_pContext->RSGetState(ppRasterizerState); }
+	virtual void STDMETHODCALLTYPE RSGetViewports(UINT* pNumViewports, D3D11_VIEWPORT* pViewports){ m_pContext->RSGetViewports(pNumViewports, pViewports); }
+	virtual void STDMETHODCALLTYPE RSGetScissorRects(UINT* pNumRects, D3D11_RECT* pRects){ m_pContext->RSGetScissorRects(pNumRects, pRects); }
+	virtual void STDMETHODCALLTYPE HSGetShaderResources(UINT StartSlot, UINT NumViews, ID3D11ShaderResourceView** ppShaderResourceViews){ m_pContext->HSGetShaderResources(StartSlot, NumViews, ppShaderResourceViews); }
+	virtual void STDMETHODCALLTYPE HSGetShader(ID3D11HullShader** ppHullShader, ID3D11ClassInstance** ppClassInstances, UINT* pNumClassInstances){ m_pContext->HSGetShader(ppHullShader, ppClassInstances, pNumClassInstances); }
+	virtual void STDMETHODCALLTYPE HSGetSamplers(UINT StartSlot, UINT NumSamplers, ID3D11SamplerState** ppSamplers){ m_pContext->HSGetSamplers(StartSlot, NumSamplers, ppSamplers); }
+	virtual void STDMETHODCALLTYPE HSGetConstantBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer** ppConstantBuffers){ m_pContext->HSGetConstantBuffers(StartSlot, NumBuffers, ppConstantBuffers); }
+	virtual void STDMETHODCALLTYPE DSGetShaderResources(UINT StartSlot, UINT NumViews, ID3D11ShaderResourceView** ppShaderResourceViews){ m_pContext->DSGetShaderResources(StartSlot, NumViews, ppShaderResourceViews); }
+	virtual void STDMETHODCALLTYPE DSGetShader(ID3D11DomainShader** ppDomainShader, ID3D11ClassInstance** ppClassInstances, UINT* pNumClassInstances){ m_pContext->DSGetShader(ppDomainShader, ppClassInstances, pNumClassInstances); }
+	virtual void STDMETHODCALLTYPE DSGetSamplers(UINT StartSlot, UINT NumSamplers, ID3D11SamplerState** ppSamplers){ m_pContext->DSGetSamplers(StartSlot, NumSamplers, ppSamplers); }
+	virtual void STDMETHODCALLTYPE DSGetConstantBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer** ppConstantBuffers){ m_pContext->DSGetConstantBuffers(StartSlot, NumBuffers, ppConstantBuffers); }
+	virtual void STDMETHODCALLTYPE CSGetShaderResources(UINT StartSlot, UINT NumViews, ID3D11ShaderResourceView** ppShaderResourceViews){ m_pContext->CSGetShaderResources(StartSlot, NumViews, ppShaderResourceViews); }
+	virtual void STDMETHODCALLTYPE CSGetUnorderedAccessViews(UINT StartSlot, UINT NumUAVs, ID3D11UnorderedAccessView** ppUnorderedAccessViews){ m_pContext->CSGetUnorderedAccessViews(StartSlot, NumUAVs, ppUnorderedAccessViews); }
+	virtual void STDMETHODCALLTYPE CSGetShader(ID3D11ComputeShader** ppComputeShader, ID3D11ClassInstance** ppClassInstances, UINT* pNumClassInstances){ m_pContext->CSGetShader(ppComputeShader, ppClassInstances, pNumClassInstances); }
+	virtual void STDMETHODCALLTYPE CSGetSamplers(UINT StartSlot, UINT NumSamplers, ID3D11SamplerState** ppSamplers){ m_pContext->CSGetSamplers(StartSlot, NumSamplers, ppSamplers); }
+	virtual void STDMETHODCALLTYPE CSGetConstantBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer** ppConstantBuffers){ m_pContext->CSGetConstantBuffers(StartSlot, NumBuffers, ppConstantBuffers); }
+	virtual void STDMETHODCALLTYPE ClearState(){ Record(RECORD_CONTEXT_OTHER); m_pContext->ClearState(); }
+	virtual void STDMETHODCALLTYPE Flush(){ m_pContext->Flush(); }
+	virtual D3D11_DEVICE_CONTEXT_TYPE STDMETHODCALLTYPE GetType(){ return m_pContext->GetType(); }
+	virtual UINT STDMETHODCALLTYPE GetContextFlags(){ return m_pContext->GetContextFlags(); }
+	virtual HRESULT STDMETHODCALLTYPE FinishCommandList(BOOL RestoreDeferredContextState, ID3D11CommandList** ppCommandList){ return m_pContext->FinishCommandList(RestoreDeferredContextState, ppCommandList); }
+
+	// ID3D11DeviceContext1. QueryInterface͎ۂ̃ReLXgΉĂ鎞̃C^[tFCXԂ
+	virtual void STDMETHODCALLTYPE CopySubresourceRegion1(ID3D11Resource* pDstResource, UINT DstSubresource, UINT DstX, UINT DstY, UINT DstZ, ID3D11Resource* pSrcResource, UINT SrcSubresource, const D3D11_BOX* pSrcBox, UINT CopyFlags){ Record(RECORD_UPDATE_SUBRESOURCE); m_pContext1->CopySubresourceRegion1(pDstResource, DstSubresource, DstX, DstY, DstZ, pSrcResource, SrcSubresource, pSrcBox, CopyFlags); }
+	virtual void STDMETHODCALLTYPE UpdateSubresource1(ID3D11Resource* pDstResource, UINT DstSubresource, const D3D11_BOX* pDstBox, const void* pSrcData, UINT SrcRowPitch, UINT SrcDepthPitch, UINT CopyFlags){ Record(RECORD_UPDATE_SUBRESOURCE); m_pContext1->UpdateSubresource1(pDstResource, DstSubresource, pDstBox, pSrcData, SrcRowPitch, SrcDepthPitch, CopyFlags); }
+	virtual void STDMETHODCALLTYPE DiscardResource(ID3D11Resource* pResource){ Record(RECORD_CONTEXT_OTHER); m_pContext1->DiscardResource(pResource); }
+	virtual void STDMETHODCALLTYPE DiscardView(ID3D11View* pResourceView){ Record(RECORD_CONTEXT_OTHER); m_pContext1->DiscardView(pResourceView); }
+	virtual void STDMETHODCALLTYPE VSSetConstantBuffers1(UINT StartSlot, UINT NumBuffers, ID3D11Buffer* const* ppConstantBuffers, const UINT* pFirstConstant, const UINT* pNumConstants){ Record(RECORD_VS_SET_CONSTANT_BUFFERS); m_pContext1->VSSetConstantBuffers1(StartSlot, NumBuffers, ppConstantBuffers, pFirstConstant, pNumConstants); }
+	virtual void STDMETHODCALLTYPE HSSetConstantBuffers1(UINT StartSlot, UINT NumBuffers, ID3D11Buffer* const* ppConstantBuffers, const UINT* pFirstConstant, const UINT* pNumConstants){ Record(RECORD_CONTEXT_OTHER); m_pContext1->HSSetConstantBuffers1(StartSlot, NumBuffers, ppConstantBuffers, pFirstConstant, pNumConstants); }
+	virtual void STDMETHODCALLTYPE DSSetConstantBuffers1(UINT StartSlot, UINT NumBuffers, ID3D11Buffer* const* ppConstantBuffers, const UINT* pFirstConstant, const UINT* pNumConstants){ Record(RECORD_CONTEXT_OTHER); m_pContext1->DSSetConstantBuffers1(StartSlot, NumBuffers, ppConstantBuffers, pFirstConstant, pNumConstants); }
+	virtual void STDMETHODCALLTYPE GSSetConstantBuffers1(UINT StartSlot, UINT NumBuffers, ID3D11Buffer* const* ppConstantBuffers, const UINT* pFirstConstant, const UINT* pNumConstants){ Record(RECORD_CONTEXT_OTHER); m_pContext1->GSSetConstantBuffers1(StartSlot, NumBuffers, ppConstantBuffers, pFirstConstant, pNumConstants); }
+	virtual void STDMETHODCALLTYPE PSSetConstantBuffers1(UINT StartSlot, UINT NumBuffers, ID3D11Buffer* const* ppConstantBuffers, const UINT* pFirstConstant, const UINT* pNumConstants){ Record(RECORD_PS_SET_CONSTANT_BUFFERS); m_pContext1->PSSetConstantBuffers1(StartSlot, NumBuffers, ppConstantBuffers, pFirstConstant, pNumConstants); }
+	virtual void STDMETHODCALLTYPE CSSetConstantBuffers1(UINT StartSlot, UINT NumBuffers, ID3D11Buffer* const* ppConstantBuffers, const UINT* pFirstConstant, const UINT* pNumConstants){ Record(RECORD_CONTEXT_OTHER); m_pContext1->CSSetConstantBuffers1(StartSlot, NumBuffers, ppConstantBuffers, pFirstConstant, pNumConstants); }
+	virtual void STDMETHODCALLTYPE VSGetConstantBuffers1(UINT StartSlot, UINT NumBuffers, ID3D11Buffer** ppConstantBuffers, UINT* pFirstConstant, UINT* pNumConstants){ m_pContext1->VSGetConstantBuffers1(StartSlot, NumBuffers, ppConstantBuffers, pFirstConstant, pNumConstants); }
+	virtual void STDMETHODCALLTYPE HSGetConstantBuffers1(UINT StartSlot, UINT NumBuffers, ID3D11Buffer** ppConstantBuffers, UINT* pFirstConstant, UINT* pNumConstants){ m_pContext1->HSGetConstantBuffers1(StartSlot, NumBuffers, ppConstantBuffers, pFirstConstant, pNumConstants); }
+	virtual void STDMETHODCALLTYPE DSGetConstantBuffers1(UINT StartSlot, UINT NumBuffers, ID3D11Buffer** ppConstantBuffers, UINT* pFirstConstant, UINT* pNumConstants){ m_pContext1->DSGetConstantBuffers1(StartSlot, NumBuffers, ppConstantBuffers, pFirstConstant, pNumConstants); }
+	virtual void STDMETHODCALLTYPE GSGetConstantBuffers1(UINT StartSlot, UINT NumBuffers, ID3D11Buffer** ppConstantBuffers, UINT* pFirstConstant, UINT* pNumConstants){ m_pContext1->GSGetConstantBuffers1(StartSlot, NumBuffers, ppConstantBuffers, pFirstConstant, pNumConstants); }
+	virtual void STDMETHODCALLTYPE PSGetConstantBuffers1(UINT StartSlot, UINT NumBuffers, ID3D11Buffer** ppConstantBuffers, UINT* pFirstConstant, UINT* pNumConstants){ m_pContext1->PSGetConstantBuffers1(StartSlot, NumBuffers, ppConstantBuffers, pFirstConstant, pNumConstants); }
+	virtual void STDMETHODCALLTYPE CSGetConstantBuffers1(UINT StartSlot, UINT NumBuffers, ID3D11Buffer** ppConstantBuffers, UINT* pFirstConstant, UINT* pNumConstants){ m_pContext1->CSGetConstantBuffers1(StartSlot, NumBuffers, ppConstantBuffers, pFirstConstant, pNumConstants); }
+	virtual void STDMETHODCALLTYPE SwapDeviceContextState(ID3DDeviceContextState* pState, ID3DDeviceContextState** ppPreviousState){ Record(RECORD_CONTEXT_OTHER); m_pContext1->SwapDeviceContextState(pState, ppPreviousState); }
+	virtual void STDMETHODCALLTYPE ClearView(ID3D11View* pView, const FLOAT Color[4], const D3D11_RECT* pRect, UINT NumRects){ Record(RECORD_CONTEXT_OTHER); m_pContext1->ClearView(pView, Color, pRect, NumRects); }
+	virtual void STDMETHODCALLTYPE DiscardView1(ID3D11View* pResourceView, const D3D11_RECT* pRects, UINT NumRects){ Record(RECORD_CONTEXT_OTHER); m_pContext1->DiscardView1(pResourceView, pRects, NumRects); }
+};
+
+// ۂ̃foCX(NULL/WARPȂ)̑Oɒubp[. Sē], 쐬n̉񐔂CreateBuffer̃TCY𐔂.
+// 쐬\[X͎ۂ̃foCX̕Ȃ̂, GetDevice͎ۂ̃foCXԂ.
+// eNX`̔񓯊ǂݍ݂ȂǕʃXbhĂ΂̂, v̓~[ebNXŎ
+class CRecordingDevice : public ID3D11Device
+{
+	volatile LONG			m_refCount;
+	ID3D11Device*			m_pDevice;
+	CRecordingContext		m_context;
+
+	std::mutex				m_mutex;
+	RECORDING_STATS			m_stats;
+	bool					m_sampleWorkingSet;
+
+	CRecordingDevice(const CRecordingDevice&);
+	CRecordingDevice& operator=(const CRecordingDevice&);
+
+	explicit CRecordingDevice(ID3D11Device* pDevice);
+	~CRecordingDevice();
+
+	void Record(const RECORD_CALL call);
+	void RecordBuffer(const D3D11_BUFFER_DESC* pDesc, const D3D11_SUBRESOURCE_DATA* pInitialData);
+
+public:
+	// pDeviceƂ̑ReLXg. 񂾕QƂ̂, ĂяopDeviceReleaseĂ悢
+	static HRESULT Create(ID3D11Device* pDevice, CRecordingDevice** ppRecordingDevice);
+
+	// foCX(쐬n)̓v. ReLXgGetRecordingContext()->GetStats()
+	RECORDING_STATS GetStats();
+	void ResetStats();
+	CRecordingContext* GetRecordingContext(){ return &m_context; }
+	// LȊ, CreateBuffer̓xɃvZX̃[LOZbg𑪂peakWorkingSetɎc(x̂ŌvԂ)
+	void SetSampleWorkingSet(const bool enable);
+
+	// IUnknown
+	virtual HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject);
+	virtual ULONG STDMETHODCALLTYPE AddRef();
+	virtual ULONG STDMETHODCALLTYPE Release();
+
+	// ID3D11Device
+	virtual HRESULT STDMETHODCALLTYPE CreateBuffer(const D3D11_BUFFER_DESC* pDesc, const D3D11_SUBRESOURCE_DATA* pInitialData, ID3D11Buffer** ppBuffer);
+	virtual HRESULT STDMETHODCALLTYPE CreateTexture1D(const D3D11_TEXTURE1D_DESC* pDesc, const D3D11_SUBRESOURCE_DATA* pInitialData, ID3D11Texture1D** ppTexture1D){ Record(RECORD_CREATE_TEXTURE); return m_pDevice->CreateTexture1D(pDesc, pInitialData, ppTexture1D); }
+	virtual HRESULT STDMETHODCALLTYPE CreateTexture2D(const D3D11_TEXTURE2D_DESC* pDesc, const D3D11_SUBRESOURCE_DATA* pInitialData, ID3D11Texture2D** ppTexture2D){ Record(RECORD_CREATE_TEXTURE); return m_pDevice->CreateTexture2D(pDesc, pInitialData, ppTexture2D); }
+	virtual HRESULT STDMETHODCALLTYPE CreateTexture3D(const D3D11_TEXTURE3D_DESC* pDesc, const D3D11_SUBRESOURCE_DATA* pInitialData, ID3D11Texture3D** ppTexture3D){ Record(RECORD_CREATE_TEXTURE); return m_pDevice->CreateTexture3D(pDesc, pInitialData, ppTexture3D); }
+	virtual HRESULT STDMETHODCALLTYPE CreateShaderResourceView(ID3D11Resource* pResource, const D3D11_SHADER_RESOURCE_VIEW_DESC* pDesc, ID3D11ShaderResourceView** ppSRView){ Record(RECORD_CREATE_VIEW); return m_pDevice->CreateShaderResourceView(pResource, pDesc, ppSRView); }
+	virtual HRESULT STDMETHODCALLTYPE CreateUnorderedAccessView(ID3D11Resource* pResource, const D3D11_UNORDERED_ACCESS_VIEW_DESC* pDesc, ID3D11UnorderedAccessView** ppUAView){ Record(RECORD_CREATE_VIEW); return m_pDevice->CreateUnorderedAccessView(pResource, pDesc, ppUAView); }
+	virtual HRESULT STDMETHODCALLTYPE CreateRenderTargetView(ID3D11Resource* pResource, const D3D11_RENDER_TARGET_VIEW_DESC* pDesc, ID3D11RenderTargetView** ppRTView){ Record(RECORD_CREATE_VIEW); return m_pDevice->CreateRenderTargetView(pResource, pDesc, ppRTView); }
+	virtual HRESULT STDMETHODCALLTYPE CreateDepthStencilView(ID3D11Resource* pResource, const D3D11_DEPTH_STENCIL_VIEW_DESC* pDesc, ID3D11DepthStencilView** ppDepthStencilView){ Record(RECORD_CREATE_VIEW); return m_pDevice->CreateDepthStencilView(pResource, pDesc, ppDepthStencilView); }
+	virtual HRESULT STDMETHODCALLTYPE CreateInputLayout(const D3D11_INPUT_ELEMENT_DESC* pInputElementDescs, UINT NumElements, const void* pShaderBytecodeWithInputSignature, SIZE_T BytecodeLength, ID3D11InputLayout** ppInputLayout){ Record(RECORD_CREATE_INPUT_LAYOUT); return m_pDevice->CreateInputLayout(pInputElementDescs, NumElements, pShaderBytecodeWithInputSignature, BytecodeLength, ppInputLayout); }
+	virtual HRESULT STDMETHODCALLTYPE CreateVertexShader(const void* pShaderBytecode, SIZE_T BytecodeLength, ID3D11ClassLinkage* pClassLinkage, ID3D11VertexShader** ppVertexShader){ Record(RECORD_CREATE_OTHER); return m_pDevice->CreateVertexShader(pShaderBytecode, BytecodeLength, pClassLinkage, ppVertexShader); }
+	virtual HRESULT STDMETHODCALLTYPE CreateGeometryShader(const void* pShaderBytecode, SIZE_T BytecodeLength, ID3D11ClassLinkage* pClassLinkage, ID3D11GeometryShader** ppGeometryShader){ Record(RECORD_CREATE_OTHER); return m_pDevice->CreateGeometryShader(pShaderBytecode, BytecodeLength, pClassLinkage, ppGeometryShader); }
+	virtual HRESULT STDMETHODCALLTYPE CreateGeometryShaderWithStreamOutput(const void* pShaderBytecode, SIZE_T BytecodeLength, const D3D11_SO_DECLARATION_ENTRY* pSODeclaration, UINT NumEntries, const UINT* pBufferStrides, UINT NumStrides, UINT RasterizedStream, ID3D11ClassLinkage* pClassLinkage, ID3D11GeometryShader** ppGeometryShader){ Record(RECORD_CREATE_OTHER); return m_pDevice->CreateGeometryShaderWithStreamOutput(pShaderBytecode, BytecodeLength, pSODeclaration, NumEntries, pBufferStrides, NumStrides, RasterizedStream, pClassLinkage, ppGeometryShader); }
+	virtual HRESULT STDMETHODCALLTYPE CreatePixelShader(const void* pShaderBytecode, SIZE_T BytecodeLength, ID3D11ClassLinkage* pClassLinkage, ID3D11PixelShader** ppPixelShader){ Record(RECORD_CREATE_OTHER); return m_pDevice->CreatePixelShader(pShaderBytecode, BytecodeLength, pClassLinkage, ppPixelShader); }
+	virtual HRESULT STDMETHODCALLTYPE CreateHullShader(const void* pShaderBytecode, SIZE_T BytecodeLength, ID3D11ClassLinkage* pClassLinkage, ID3D11HullShader** ppHullShader){ Record(RECORD_CREATE_OTHER); return m_pDevice->CreateHullShader(pShaderBytecode, BytecodeLength, pClassLinkage, ppHullShader); }
+	virtual HRESULT STDMETHODCALLTYPE CreateDomainShader(const void* pShaderBytecode, SIZE_T BytecodeLength, ID3D11ClassLinkage* pClassLinkage, ID3D11DomainShader** ppDomainShader){ Record(RECORD_CREATE_OTHER); return m_pDevice->CreateDomainShader(pShaderBytecode, BytecodeLength, pClassLinkage, ppDomainShader); }
+	virtual HRESULT STDMETHODCALLTYPE CreateComputeShader(const void* pShaderBytecode, SIZE_T BytecodeLength, ID3D11ClassLinkage* pClassLinkage, ID3D11ComputeShader** ppComputeShader){ Record(RECORD_CREATE_OTHER); return m_pDevice->CreateComputeShader(pShaderBytecode, BytecodeLength, pClassLinkage, ppComputeShader); }
+	virtual HRESULT STDMETHODCALLTYPE CreateClassLinkage(ID3D11ClassLinkage** ppLinkage){ Record(RECORD_CREATE_OTHER); return m_pDevice->CreateClassLinkage(ppLinkage); }
+	virtual HRESULT STDMETHODCALLTYPE CreateBlendState(const D3D11_BLEND_DESC* pBlendStateDesc, ID3D11BlendState** ppBlendState){ Record(RECORD_CREATE_OTHER); return m_pDevice->CreateBlendState(pBlendStateDesc, ppBlendState); }
+	virtual HRESULT STDMETHODCALLTYPE CreateDepthStencilState(const D3D11_DEPTH_STENCIL_DESC* pDepthStencilDesc, ID3D11DepthStencilState** ppDepthStencilState){ Record(RECORD_CREATE_OTHER); return m_pDevice->CreateDepthStencilState(pDepthStencilDesc, ppDepthStencilState); }
+	virtual HRESULT STDMETHODCALLTYPE CreateRasterizerState(const D3D11_RASTERIZER_DESC* pRasterizerDesc, ID3D11RasterizerState** ppRasterizerState){ Record(RECORD_CREATE_OTHER); return m_pDevice->CreateRasterizerState(pRasterizerDesc, ppRasterizerState); }
+	virtual HRESULT STDMETHODCALLTYPE CreateSamplerState(const D3D11_SAMPLER_DESC* pSamplerDesc, ID3D11SamplerState** ppSamplerState){ Record(RECORD_CREATE_SAMPLER); return m_pDevice->CreateSamplerState(pSamplerDesc, ppSamplerState); }
+	virtual HRESULT STDMETHODCALLTYPE CreateQuery(const D3D11_QUERY_DESC* pQueryDesc, ID3D11Query** ppQuery){ Record(RECORD_CREATE_OTHER); return m_pDevice->CreateQuery(pQueryDesc, ppQuery); }
+	virtual HRESULT STDMETHODCALLTYPE CreatePredicate(const D3D11_QUERY_DESC* pPredicateDesc, ID3D11Predicate** ppPredicate){ Record(RECORD_CREATE_OTHER); return m_pDevice->CreatePredicate(pPredicateDesc, ppPredicate); }
+	virtual HRESULT STDMETHODCALLTYPE CreateCounter(const D3D11_COUNTER_DESC* pCounterDesc, ID3D11Counter** ppCounter){ Record(RECORD_CREATE_OTHER); return m_pDevice->CreateCounter(pCounterDesc, ppCounter); }
+	// xReLXg͕܂Ȃ(̃vWFNgł͎gȂ)
+	virtual HRESULT STDMETHODCALLTYPE CreateDeferredContext(UINT ContextFlags, ID3D11DeviceContext** ppDeferredContext){ Record(RECORD_CREATE_OTHER); return m_pDevice->CreateDeferredContext(ContextFlags, ppDeferredContext); }
+	virtual HRESULT STDMETHODCALLTYPE OpenSharedResource(HANDLE hResource, REFIID ReturnedInterface, void** ppResource){ return m_pDevice->OpenSharedResource(hResource, ReturnedInterface, ppResource); }
+	virtual HRESULT STDMETHODCALLTYPE CheckFormatSupport(DXGI_FORMAT Format, UINT* pFormatSupport){ return m_pDevice->CheckFormatSupport(Format, pFormatSupport); }
+	virtual HRESULT STDMETHODCALLTYPE CheckMultisampleQualityLevels(DXGI_FORMAT Format, UINT SampleCount, UINT* pNumQualityLevels){ return m_pDevice->CheckMultisampleQualityLevels(Format, SampleCount, pNumQualityLevels); }
+	virtual void STDMETHODCALLTYPE CheckCounterInfo(D3D11_COUNTER_INFO* pCounterInfo){ m_pDevice->CheckCounterInfo(pCounterInfo); }
+	virtual HRESULT STDMETHODCALLTYPE CheckCounter(const D3D11_COUNTER_DESC* pDesc, D3D11_COUNTER_TYPE* pType, UINT* pActiveCounters, LPSTR szName, UINT* pNameLength, LPSTR szUnits, UINT* pUnitsLength, LPSTR szDescription, UINT* pDescriptionLength){ return m_pDevice->CheckCounter(pDesc, pType, pActiveCounters, szName, pNameLength, szUnits, pUnitsLength, szDescription, pDescriptionLength); }
+	virtual HRESULT STDMETHODCALLTYPE CheckFeatureSupport(D3D11_FEATURE Feature, void* pFeatureSupportData, UINT FeatureSupportDataSize){ return m_pDevice->CheckFeatureSupport(Feature, pFeatureSupportData, FeatureSupportDataSize); }
+	virtual HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID guid, UINT* pDataSize, void* pData){ return m_pDevice->GetPrivateData(guid, pDataSize, pData); }
+	virtual HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID guid, UINT DataSize, const void* pData){ return m_pDevice->SetPrivateData(guid, DataSize, pData); }
+	virtual HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID guid, const IUnknown* pData){ return m_pDevice->SetPrivateDataInterface(guid, pData); }
+	virtual D3D_FEATURE_LEVEL STDMETHODCALLTYPE GetFeatureLevel(){ return m_pDevice->GetFeatureLevel(); }
+	virtual UINT STDMETHODCALLTYPE GetCreationFlags(){ return m_pDevice->GetCreationFlags(); }
+	virtual HRESULT STDMETHODCALLTYPE GetDeviceRemovedReason(){ return m_pDevice->GetDeviceRemovedReason(); }
+	virtual void STDMETHODCALLTYPE GetImmediateContext(ID3D11DeviceContext** ppImmediateContext);
+	virtual HRESULT STDMETHODCALLTYPE SetExceptionMode(UINT RaiseFlags){ return m_pDevice->SetExceptionMode(RaiseFlags); }
+	virtual UINT STDMETHODCALLTYPE GetExceptionMode(){ return m_pDevice->GetExceptionMode(); }
+};
@@ -0,0 +1,1586 @@
+// *********************************************************************************************************************
+///
+/// @file 		FBXLoaderBench.cpp
+/// @brief		EBhE炸FBX̓ǂݍ݁`œK`obt@쐬܂łvR}hCc[
+///
+/// @author 	Masafumi Takahashi
+/// @date 		2026/10/17
+///
+// *********************************************************************************************************************
+
+#include <windows.h>
+#include <psapi.h>
+#include <d3d11.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <malloc.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <new>
+
+#include "CFBXRendererDX11.h"
+#include "CFBXFrustum.h"
+#include "CFBXHierarchy.h"
+#include "CFBXRenderQueue.h"
+#include "CRecordingDevice.h"
+
+// operator new/delete𐔂(FBX_LOAD_STATS::SetAllocationCounterŒiKƂɕ).
+// FBX SDK̊mۂCFBXScratchArena_aligned_malloc͓Ȃ(҂scratchHeapAllocCountŐ)
+static std::atomic<uint64_t> s_allocCount(0);
+static std::atomic<uint64_t> s_freeCount(0);
+// mے̃oCg(_msize), ResetPeakLiveBytesȍ~̍ő
+static std::atomic<int64_t> s_liveBytes(0);
+static std::atomic<int64_t> s_peakLiveBytes(0);
+
+static uint64_t GetAllocCount()
+{
+	return s_allocCount.load(std::memory_order_relaxed);
+}
+
+// ܂ĂȂmۂ̐
+static int64_t GetLiveAllocCount()
+{
+	return static_cast<int64_t>(s_allocCount.load(std::memory_order_relaxed)) - static_cast<int64_t>(s_freeCount.load(std::memory_order_relaxed));
+}
+
+static int64_t GetLiveBytes()
+{
+	return s_liveBytes.load(std::memory_order_relaxed);
+}
+
+static void ResetPeakLiveBytes()
+{
+	s_peakLiveBytes.store(s_liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+static int64_t GetPeakLiveBytes()
+{
+	return s_peakLiveBytes.load(std::memory_order_relaxed);
+}
+
+static void* CountedAlloc(size_t size)
+{
+	s_allocCount.fetch_add(1, std::memory_order_relaxed);
+	void* p = malloc(size > 0 ? size : 1);
+	if(!p)
+		return nullptr;
+
+	const int64_t bytes = static_cast<int64_t>(_msize(p));
+	const int64_t live = s_liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+	int64_t peak = s_peakLiveBytes.load(std::memory_order_relaxed);
+	while(live > peak && !s_peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+		;
+	return p;
+}
+
+void* operator new(size_t size)
+{
+	void* p = CountedAlloc(size);
+	if(!p)
+		throw std::bad_alloc();
+	return p;
+}
+
+void* operator new(size_t size, const std::nothrow_t&)
+{
+	return CountedAlloc(size);
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& nothrow)
+{
+	return operator new(size, nothrow);
+}
+
+void operator delete(void* p)
+{
+	if(!p)
+		return ;
+	s_freeCount.fetch_add(1, std::memory_order_relaxed);
+	s_liveBytes.fetch_sub(static_cast<int64_t>(_msize(p)), std::memory_order_relaxed);
+	free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&)
+{
+	operator delete(p);
+}
+
+void operator delete[](void* p)
+{
+	operator delete(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&)
+{
+	operator delete(p);
+}
+
+//
+struct BENCH_OPTION
+{
+	std::string		path;				// FBXt@C, ܂FBX̓fBNg
+	unsigned int	repeat;				// 1t@Čv
+	unsigned int	threadCount;		// CFBXLoader::SetThreadCount. 1ȊOȂ1XbhłǂݍŔׂ
+	bool			isOptimize;
+	bool			isPacked;			// CFBXRenderDX11::SetPackedUpload
+	bool			isCompressed;		// ʒuSNORM16, @octahedral, UVx̒_ɂ
+	bool			isAsyncTexture;		// CFBXRenderDX11::SetAsyncTextureLoad. v̓eNX`҂Ɏ~߂
+	bool			isSkinned;			// _BLENDINDICES/BLENDWEIGHT(FBX_SKIN_UINT8_UNORM8)
+	const char*		jsonPath;			// ʂJSONo͐(nullptrȂoȂ)
+
+	BENCH_OPTION()
+	{
+		repeat = 5;
+		threadCount = 1;
+		isOptimize = true;
+		isPacked = false;
+		isCompressed = false;
+		isAsyncTexture = false;
+		isSkinned = false;
+		jsonPath = nullptr;
+	}
+};
+
+// nearest-rank
+static double GetPercentile(const std::vector<double>& timeArray, const double percent)
+{
+	if(timeArray.size()==0)
+		return 0.0;
+
+	std::vector<double> sorted = timeArray;
+	std::sort(sorted.begin(), sorted.end());
+
+	size_t rank = static_cast<size_t>(percent / 100.0 * static_cast<double>(sorted.size()) + 0.999999);
+	if(rank < 1)
+		rank = 1;
+	if(rank > sorted.size())
+		rank = sorted.size();
+	return sorted[rank - 1];
+}
+
+struct BENCH_RESULT
+{
+	std::string						filename;
+	std::vector<double>				timeArray;			// 1񂲂Ƃ̓ǂݍݎ(~b)
+	FBX_LOADER::FBX_LOAD_STATS		stats;				// Ō1̓
+	std::vector<double>				serialTimeArray;	// -t1ȊO̎, r̂1Xbhœǂݍ񂾎
+	FBX_LOADER::FBX_LOAD_STATS		serialStats;
+	uint64_t						triangleCount;
+	size_t							peakWorkingSet;		// ̃t@CI_ł̃vZX̃s[N
+	uint32_t						animationNodeCount;	// Ă񂾃Aj[V̊Kw̃m[h(Ȃ0)
+	uint32_t						animationTrackCount;
+	double							animationNodesPerMs;	// CFBXAnimation::Sample1~bɋ߂m[hs̐(1Xbh)
+	uint64_t						skinVertexCount;		// XLEFCg_(Sm[h)
+	double							skinVerticesPerSecond;	// CFBXSkinning::SkinVertices̑x(1Xbh)
+	FBX_LOADER::FBX_LOAD_STATS		allocStats;				// MeasureAllocations1(Ɨ̈g)
+	FBX_LOADER::FBX_LOAD_STATS		heapModeAllocStats;		// Ɣz1q[vmۂꍇ
+	int64_t							liveAllocCount;			// ǂݍRelease(j)Ɏcmۂ̐
+	int64_t							heapModeLiveAllocCount;
+	int64_t							peakHeapBytes;			// MeasureAllocations̓ǂݍݒɑoperator neẘmۗʂ̍ő
+	int64_t							heapModePeakHeapBytes;
+	uint32_t						allocNodeCount;
+	RECORDING_STATS					recordStats;			// Ō1ŃfoCXۂɎ󂯂Ăяo
+	uint32_t						checkFailCount;			// smF̐(foCX̌ĂяoƂ̓˂킹, bVLbV)
+	FBX_LOADER::RENDER_QUEUE_STATS	queueStats;				// MeasureRenderQueue̍Ō̃t[
+	uint32_t						queueFrameCount;
+	double							coldCacheMs;			// bVLbVēǂݍ񂾎(LbV̏o܂)
+	std::vector<double>				warmCacheTimeArray;		// ēǂݍ񂾎
+	FBX_LOADER::FBX_LOAD_STATS		warmCacheStats;
+	bool							cacheUsable;			// Aj[VXL, LbVǂ߂V[
+	uint32_t						bakedBufferCount;		// LoadBakedMeshō_ECfbNXobt@
+	uint32_t						bakedMappedCount;		// ̂f[^}bvt@C𒼐ڎwĂ
+	uint64_t						bakedMaxBufferBytes;
+	size_t							bakedWorkingSetGrowth;	// LoadBakedMesh̃[LOZbg̑(CreateBuffer̒Oőő)
+	bool							succeeded;
+
+	BENCH_RESULT()
+	{
+		triangleCount = 0;
+		peakWorkingSet = 0;
+		animationNodeCount = 0;
+		animationTrackCount = 0;
+		animationNodesPerMs = 0.0;
+		skinVertexCount = 0;
+		skinVerticesPerSecond = 0.0;
+		liveAllocCount = 0;
+		heapModeLiveAllocCount = 0;
+		peakHeapBytes = 0;
+		heapModePeakHeapBytes = 0;
+		allocNodeCount = 0;
+		checkFailCount = 0;
+		queueFrameCount = 0;
+		coldCacheMs = 0.0;
+		cacheUsable = false;
+		bakedBufferCount = 0;
+		bakedMappedCount = 0;
+		bakedMaxBufferBytes = 0;
+		bakedWorkingSetGrowth = 0;
+		succeeded = false;
+	}
+
+	double GetPercentile(const double percent) const
+	{
+		return ::GetPercentile(timeArray, percent);
+	}
+
+	// l̎Ԃł̎Op`/b
+	double GetTrianglesPerSecond() const
+	{
+		const double median = GetPercentile(50.0);
+		if(median <= 0.0)
+			return 0.0;
+		return static_cast<double>(triangleCount) * 1000.0 / median;
+	}
+};
+
+// JǑv(t@CɈ˂Ȃ)
+struct CULLING_RESULT
+{
+	uint32_t	objectCount;
+	uint32_t	visibleCount;
+	double		batchMs;		// CFBXFrustum::CullSpheres1񂠂
+	double		scalarMs;		// CFBXFrustum::IsVisible1Ă񂾏ꍇ1񂠂
+
+	CULLING_RESULT()
+	{
+		objectCount = 0;
+		visibleCount = 0;
+		batchMs = 0.0;
+		scalarMs = 0.0;
+	}
+};
+
+struct HIERARCHY_RESULT
+{
+	uint32_t		nodeCount;
+	uint32_t		dirtyCount;			// XVSetLocalm[h
+	uint32_t		partialNodeCount;	// XVŎۂɌvZm[h(q܂)
+	unsigned int	threadCount;		// XVŎgXbh
+	double			fullMs;				// Sm[hύXUpdate1񂠂
+	double			partialMs;			// dirtyCountύXUpdate1񂠂
+	double			parallelMs;			// Sm[hύXUpdateParallel1񂠂([J[)
+	double			parallelFirstMs;	// ŏUpdateParallel. [J[̃Xbh鎞Ԃ܂
+
+	HIERARCHY_RESULT()
+	{
+		nodeCount = 0;
+		dirtyCount = 0;
+		partialNodeCount = 0;
+		threadCount = 0;
+		fullMs = 0.0;
+		partialMs = 0.0;
+		parallelMs = 0.0;
+		parallelFirstMs = 0.0;
+	}
+};
+
+static void PrintUsage()
+{
+	printf("usage: FBXLoaderBench <fbx file | directory> [-n repeat] [-t threads] [-noopt] [-packed] [-compressed] [-asynctex] [-skin] [-json output.json]\n");
+}
+
+static bool ParseOption(int argc, char* argv[], BENCH_OPTION* pOption)
+{
+	if(argc < 2)
+		return false;
+
+	pOption->path = argv[1];
+	for(int i=2;i<argc;i++)
+	{
+		if(strcmp(argv[i], "-n")==0 && i+1 < argc)
+			pOption->repeat = static_cast<unsigned int>(atoi(argv[++i]));
+		else if(strcmp(argv[i], "-t")==0 && i+1 < argc)
+			pOption->threadCount = static_cast<unsigned int>(atoi(argv[++i]));
+		else if(strcmp(argv[i], "-noopt")==0)
+			pOption->isOptimize = false;
+		else if(strcmp(argv[i], "-packed")==0)
+			pOption->isPacked = true;
+		else if(strcmp(argv[i], "-compressed")==0)
+			pOption->isCompressed = true;
+		else if(strcmp(argv[i], "-asynctex")==0)
+			pOption->isAsyncTexture = true;
+		else if(strcmp(argv[i], "-skin")==0)
+			pOption->isSkinned = true;
+		else if(strcmp(argv[i], "-json")==0 && i+1 < argc)
+			pOption->jsonPath = argv[++i];
+		else
+			return false;
+	}
+
+	if(pOption->repeat==0)
+		pOption->repeat = 1;
+
+	return true;
+}
+
+// ΏۂFBXt@C񋓂
+static void FindFiles(const std::string& path, std::vector<std::string>* pFileArray)
+{
+	const DWORD attribute = GetFileAttributesA(path.c_str());
+	if(attribute == INVALID_FILE_ATTRIBUTES)
+		return ;
+
+	if(!(attribute & FILE_ATTRIBUTE_DIRECTORY))
+	{
+		pFileArray->push_back(path);
+		return ;
+	}
+
+	WIN32_FIND_DATAA findData;
+	HANDLE hFind = FindFirstFileA((path + "\\*.fbx").c_str(), &findData);
+	if(hFind == INVALID_HANDLE_VALUE)
+		return ;
+
+	do
+	{
+		if(!(findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+			pFileArray->push_back(path + "\\" + findData.cFileName);
+	} while(FindNextFileA(hFind, &findData));
+
+	FindClose(hFind);
+
+	std::sort(pFileArray->begin(), pFileArray->end());
+}
+
+// `͂Ȃ̂NULLfoCXg. SDK LayersłWARPɂ.
+// ǂݍ݂̓vƎۂ̌Ăяo˂킹邽, CRecordingDeviceŕŕԂ
+static HRESULT CreateDevice(CRecordingDevice** ppDevice, const char** ppDriverName)
+{
+	D3D_DRIVER_TYPE driverTypes[] =
+	{
+		D3D_DRIVER_TYPE_NULL,
+		D3D_DRIVER_TYPE_WARP,
+	};
+	const char* driverNames[] =
+	{
+		"null",
+		"warp",
+	};
+
+	ID3D11Device* pDevice = nullptr;
+	HRESULT hr = E_FAIL;
+	for(UINT i=0;i<ARRAYSIZE(driverTypes);i++)
+	{
+		D3D_FEATURE_LEVEL featureLevel;
+		hr = D3D11CreateDevice(nullptr, driverTypes[i], nullptr, 0, nullptr, 0,
+			D3D11_SDK_VERSION, &pDevice, &featureLevel, nullptr);
+		if(SUCCEEDED(hr))
+		{
+			*ppDriverName = driverNames[i];
+			break;
+		}
+	}
+	if(FAILED(hr))
+		return hr;
+
+	hr = CRecordingDevice::Create(pDevice, ppDevice);
+	pDevice->Release();
+
+	return hr;
+}
+
+// CFBXRenderDX11_ECfbNXobt@̍쐬񐔂ƃTCY, foCXۂɎ󂯂CreateBufferƍ
+static bool CheckBufferRecord(const RECORDING_STATS& record, const FBX_LOADER::FBX_LOAD_STATS& stats, const char* filename)
+{
+	const uint32_t recordCount = record.vertexBufferCount + record.indexBufferCount;
+	const uint64_t recordBytes = record.vertexBufferBytes + record.indexBufferBytes;
+	if(recordCount == stats.bufferCreateCount && recordBytes == stats.bufferBytes)
+		return true;
+
+	printf("Error: %s: CreateBuffer recorded %u calls %llu bytes, load stats %u calls %llu bytes\n", filename,
+		recordCount, static_cast<unsigned long long>(recordBytes),
+		stats.bufferCreateCount, static_cast<unsigned long long>(stats.bufferBytes));
+	return false;
+}
+
+static size_t GetPeakWorkingSet()
+{
+	PROCESS_MEMORY_COUNTERS counters;
+	ZeroMemory(&counters, sizeof(counters));
+	if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return 0;
+	return counters.PeakWorkingSetSize;
+}
+
+// Ă񂾃Aj[VANIMATION_BENCH_MSȏ񂵑, KwŜ̕]x𑪂.
+// ͖񂸂炵ăL[̓ǂݍ݂LbVɏ܂܂ɂȂȂ悤ɂ
+static const double ANIMATION_BENCH_MS = 50.0;
+
+static void MeasureAnimation(const FBX_LOADER::CFBXAnimation* pAnimation, BENCH_RESULT* pResult)
+{
+	if(!pAnimation || !pAnimation->IsAnimated())
+		return ;
+
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+
+	std::vector<DirectX::XMFLOAT4X4> matrixArray(pAnimation->GetNodeCount());
+	const float duration = pAnimation->GetDuration();
+	const float timeStep = duration * 0.371f + 0.013f;
+
+	LARGE_INTEGER begin, now;
+	QueryPerformanceCounter(&begin);
+	uint64_t sampleCount = 0;
+	double elapsed = 0.0;
+	float time = 0.0f;
+	while(elapsed < ANIMATION_BENCH_MS)
+	{
+		// vǂމ񐔂炷64񂸂
+		for(int i=0;i<64;i++)
+		{
+			pAnimation->Sample(time, &matrixArray[0]);
+			time += timeStep;
+			if(time > duration)
+				time -= duration;
+		}
+		sampleCount += 64;
+
+		QueryPerformanceCounter(&now);
+		elapsed = static_cast<double>(now.QuadPart - begin.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart);
+	}
+
+	pResult->animationNodeCount = static_cast<uint32_t>(pAnimation->GetNodeCount());
+	pResult->animationTrackCount = pAnimation->GetTrackCount();
+	pResult->animationNodesPerMs = static_cast<double>(sampleCount) * static_cast<double>(pAnimation->GetNodeCount()) / elapsed;
+}
+
+// XL̂Sm[hSKINNING_BENCH_MSȏCPUŃXLjO.
+// {[̍s͏Ă񂾃Aj[V΂̓r̎, Γǂݍ񂾎̍sg
+static const double SKINNING_BENCH_MS = 50.0;
+
+static void MeasureSkinning(const FBX_LOADER::CFBXRenderDX11& renderer, BENCH_RESULT* pResult)
+{
+	const size_t nodeCount = renderer.GetNodeCount();
+	if(nodeCount==0)
+		return ;
+
+	std::vector<DirectX::XMFLOAT4X4> matrixArray(nodeCount);
+	const FBX_LOADER::CFBXAnimation* pAnimation = renderer.GetAnimation();
+	if(pAnimation && pAnimation->IsAnimated() && pAnimation->GetNodeCount()==nodeCount)
+		pAnimation->Sample(pAnimation->GetDuration() * 0.5f, &matrixArray[0]);
+	else
+	{
+		for(size_t i=0;i<nodeCount;i++)
+			renderer.GetNodeMatrix(static_cast<int>(i), &matrixArray[i].m[0][0]);
+	}
+
+	std::vector<const FBX_LOADER::FBX_MESH_NODE*>	skinNodeArray;
+	std::vector<FBX_LOADER::CFBXSkinning>			skinningArray;
+	uint64_t vertexCount = 0;
+	for(size_t i=0;i<nodeCount;i++)
+	{
+		const FBX_LOADER::FBX_MESH_NODE* pNode = renderer.GetSourceNode(i);
+		if(!pNode || pNode->m_skinArray.empty())
+			continue;
+
+		skinNodeArray.push_back(pNode);
+		skinningArray.push_back(FBX_LOADER::CFBXSkinning());
+		skinningArray.back().UpdatePalette(*pNode, matrixArray[i], &matrixArray[0]);
+		vertexCount += pNode->m_skinArray.size();
+	}
+	if(vertexCount==0)
+		return ;
+
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+
+	LARGE_INTEGER begin, now;
+	QueryPerformanceCounter(&begin);
+	uint64_t passCount = 0;
+	double elapsed = 0.0;
+	while(elapsed < SKINNING_BENCH_MS)
+	{
+		for(size_t i=0;i<skinNodeArray.size();i++)
+			skinningArray[i].Skin(*skinNodeArray[i]);
+		passCount++;
+
+		QueryPerformanceCounter(&now);
+		elapsed = static_cast<double>(now.QuadPart - begin.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart);
+	}
+
+	pResult->skinVertexCount = vertexCount;
+	pResult->skinVerticesPerSecond = static_cast<double>(passCount) * static_cast<double>(vertexCount) * 1000.0 / elapsed;
+}
+
+// CULLING_BENCH_OBJECTS̋E𗧕̂̒ɎU炵, _+ZCULLING_BENCH_MSȏJO.
+// т͖񓯂ɂȂ悤O̐`@ō
+static const uint32_t CULLING_BENCH_OBJECTS = 100000;
+static const double CULLING_BENCH_MS = 50.0;
+
+static void MeasureCulling(CULLING_RESULT* pResult)
+{
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+
+	FBX_LOADER::FBX_SPHERE_STREAM sphereArray(CULLING_BENCH_OBJECTS);
+	uint32_t seed = 12345;
+	for(uint32_t i=0;i<CULLING_BENCH_OBJECTS;i++)
+	{
+		float v[4];
+		for(int j=0;j<4;j++)
+		{
+			seed = seed * 1664525 + 1013904223;
+			v[j] = static_cast<float>(seed >> 8) / 16777216.0f;
+		}
+		sphereArray[i] = DirectX::XMFLOAT4A(v[0] * 2000.0f - 1000.0f, v[1] * 2000.0f - 1000.0f, v[2] * 2000.0f - 1000.0f, 1.0f + v[3] * 9.0f);
+	}
+
+	DirectX::XMFLOAT4X4 viewProjection;
+	DirectX::XMStoreFloat4x4(&viewProjection, DirectX::XMMatrixMultiply(
+		DirectX::XMMatrixLookAtLH(DirectX::XMVectorZero(), DirectX::XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), DirectX::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)),
+		DirectX::XMMatrixPerspectiveFovLH(DirectX::XM_PIDIV4, 16.0f / 9.0f, 1.0f, 1000.0f)));
+
+	FBX_LOADER::CFBXFrustum frustum;
+	frustum.SetMatrix(viewProjection);
+
+	std::vector<uint32_t> visibleArray(CULLING_BENCH_OBJECTS);
+	LARGE_INTEGER begin, now;
+
+	// ܂Ƃ߂Ĕ
+	QueryPerformanceCounter(&begin);
+	uint32_t passCount = 0;
+	double elapsed = 0.0;
+	while(elapsed < CULLING_BENCH_MS)
+	{
+		pResult->visibleCount = frustum.CullSpheres(&sphereArray[0], CULLING_BENCH_OBJECTS, &visibleArray[0]);
+		passCount++;
+
+		QueryPerformanceCounter(&now);
+		elapsed = static_cast<double>(now.QuadPart - begin.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart);
+	}
+	pResult->batchMs = elapsed / passCount;
+
+	// rp1
+	QueryPerformanceCounter(&begin);
+	passCount = 0;
+	elapsed = 0.0;
+	while(elapsed < CULLING_BENCH_MS)
+	{
+		uint32_t visibleCount = 0;
+		for(uint32_t i=0;i<CULLING_BENCH_OBJECTS;i++)
+		{
+			if(frustum.IsVisible(sphereArray[i]))
+				visibleArray[visibleCount++] = i;
+		}
+		passCount++;
+
+		QueryPerformanceCounter(&now);
+		elapsed = static_cast<double>(now.QuadPart - begin.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart);
+	}
+	pResult->scalarMs = elapsed / passCount;
+	pResult->objectCount = CULLING_BENCH_OBJECTS;
+}
+
+// HIERARCHY_BENCH_NODES̃m[hsɕׂ؂, S/1%ύXꍇƕ̏ꍇ̍XVԂ𑪂.
+// e͍ǂĂ}̒IԂ̂, [HIERARCHY_BENCH_DEPTH܂ł̂΂΂Ȗ؂ɂȂ
+static const uint32_t HIERARCHY_BENCH_NODES = 100000;
+static const uint32_t HIERARCHY_BENCH_DEPTH = 16;
+static const double HIERARCHY_BENCH_MS = 50.0;
+
+static void MeasureHierarchy(const unsigned int threadCount, HIERARCHY_RESULT* pResult)
+{
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+
+	std::vector<int32_t> parentArray(HIERARCHY_BENCH_NODES);
+	std::vector<DirectX::XMFLOAT4X4> localArray(HIERARCHY_BENCH_NODES);
+	std::vector<DirectX::XMFLOAT4X4> worldArray(HIERARCHY_BENCH_NODES);
+	std::vector<int32_t> pathArray;
+	uint32_t seed = 12345;
+	for(uint32_t i=0;i<HIERARCHY_BENCH_NODES;i++)
+	{
+		seed = seed * 1664525 + 1013904223;
+		if(pathArray.size() >= HIERARCHY_BENCH_DEPTH)
+			pathArray.resize(HIERARCHY_BENCH_DEPTH - 1);
+		if(i > 0)
+			pathArray.resize(1 + (seed >> 8) % pathArray.size());
+
+		const int32_t parent = pathArray.empty() ? -1 : pathArray.back();
+		parentArray[i] = parent;
+		pathArray.push_back(static_cast<int32_t>(i));
+
+		const float angle = static_cast<float>(seed >> 8) / 16777216.0f * DirectX::XM_PI;
+		const DirectX::XMMATRIX local = DirectX::XMMatrixMultiply(DirectX::XMMatrixRotationY(angle), DirectX::XMMatrixTranslation(1.0f, 0.0f, 0.0f));
+		DirectX::XMStoreFloat4x4(&localArray[i], local);
+
+		DirectX::XMMATRIX world = local;
+		if(parent >= 0)
+			world = DirectX::XMMatrixMultiply(local, DirectX::XMLoadFloat4x4(&worldArray[parent]));
+		DirectX::XMStoreFloat4x4(&worldArray[i], world);
+	}
+
+	FBX_LOADER::CFBXHierarchy hierarchy;
+	if(FAILED(hierarchy.Initialize(HIERARCHY_BENCH_NODES, &parentArray[0], &worldArray[0])))
+		return ;
+
+	const uint32_t dirtyCount = HIERARCHY_BENCH_NODES / 100;
+	for(int mode=0;mode<3;mode++)
+	{
+		LARGE_INTEGER begin, now;
+		QueryPerformanceCounter(&begin);
+		uint32_t passCount = 0;
+		double elapsed = 0.0;
+		while(elapsed < HIERARCHY_BENCH_MS)
+		{
+			if(mode==1)
+			{
+				for(uint32_t i=0;i<dirtyCount;i++)
+				{
+					seed = seed * 1664525 + 1013904223;
+					const uint32_t nodeId = (seed >> 8) % HIERARCHY_BENCH_NODES;
+					hierarchy.SetLocal(nodeId, localArray[nodeId]);
+				}
+				hierarchy.Update();
+				pResult->partialNodeCount = hierarchy.GetStats().updatedNodeCount;
+			}
+			else
+			{
+				for(uint32_t i=0;i<HIERARCHY_BENCH_NODES;i++)
+					hierarchy.SetLocal(i, localArray[i]);
+				if(mode==0)
+					hierarchy.Update();
+				else
+					hierarchy.UpdateParallel(threadCount);
+			}
+			passCount++;
+
+			QueryPerformanceCounter(&now);
+			elapsed = static_cast<double>(now.QuadPart - begin.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart);
+
+			// ŏ̕XV̓[J[̂ŕʂɐ, ς͊O
+			if(mode==2 && passCount==1)
+			{
+				pResult->parallelFirstMs = elapsed;
+				passCount = 0;
+				begin = now;
+				elapsed = 0.0;
+			}
+		}
+
+		const double ms = elapsed / passCount;
+		if(mode==0)
+			pResult->fullMs = ms;
+		else if(mode==1)
+			pResult->partialMs = ms;
+		else
+			pResult->parallelMs = ms;
+	}
+
+	pResult->nodeCount = HIERARCHY_BENCH_NODES;
+	pResult->dirtyCount = dirtyCount;
+	pResult->threadCount = hierarchy.GetStats().threadCount;
+}
+
+static void SetupRenderer(const BENCH_OPTION& option, FBX_LOADER::CFBXRenderDX11* pRenderer)
+{
+	pRenderer->SetLoadThreadCount(option.threadCount);
+	pRenderer->SetPackedUpload(option.isPacked);
+	pRenderer->SetAsyncTextureLoad(option.isAsyncTexture);
+	FBX_LOADER::FBX_VERTEX_FORMAT format;
+	if(option.isCompressed)
+		format = FBX_LOADER::FBX_VERTEX_FORMAT(FBX_LOADER::FBX_POSITION_SNORM16, FBX_LOADER::FBX_NORMAL_OCT_SNORM16, FBX_LOADER::FBX_TEXCOORD_HALF2);
+	if(option.isSkinned)
+		format.skin = FBX_LOADER::FBX_SKIN_UINT8_UNORM8;
+	pRenderer->SetVertexFormat(format);
+}
+
+// CreateNodes̊mۉ. operator new̕ƍƗ̈q[vmۂ𑫂
+static uint64_t GetCreateAllocCount(const FBX_LOADER::FBX_LOAD_STATS& stats)
+{
+	return stats.stageAllocCount[FBX_LOADER::FBX_LOAD_STAGE_CREATE_NODES] + stats.scratchHeapAllocCount;
+}
+
+// Ɨ̈g񂷏ꍇ, Ɣz1mۂꍇ(ȑOnew[]/delete)1񂸂ǂݍ,
+// iKƂ̊mۉ񐔂, jɎcmۂׂ̐. LLbV͌v̓ǂݍ݂ŉ܂ĂO
+static void MeasureAllocations(const BENCH_OPTION& option, ID3D11Device* pDevice, ID3D11DeviceContext* pContext, BENCH_RESULT* pResult)
+{
+	for(int mode=0;mode<2;mode++)
+	{
+		const int64_t liveBegin = GetLiveAllocCount();
+		const int64_t bytesBegin = GetLiveBytes();
+		ResetPeakLiveBytes();
+		{
+			FBX_LOADER::CFBXRenderDX11 renderer;
+			SetupRenderer(option, &renderer);
+			renderer.SetScratchHeapMode(mode==1);
+
+			FBX_LOADER::FBX_LOAD_STATS::SetAllocationCounter(GetAllocCount);
+			HRESULT hr = renderer.LoadFBX(pResult->filename.c_str(), pDevice, pContext, option.isOptimize);
+			FBX_LOADER::FBX_LOAD_STATS::SetAllocationCounter(nullptr);
+			renderer.WaitTextures();
+			if(FAILED(hr))
+				return ;
+
+			if(mode==0)
+			{
+				pResult->peakHeapBytes = GetPeakLiveBytes() - bytesBegin;
+				pResult->allocStats = renderer.GetLoadStats();
+				pResult->allocNodeCount = static_cast<uint32_t>(renderer.GetNodeCount());
+			}
+			else
+			{
+				pResult->heapModePeakHeapBytes = GetPeakLiveBytes() - bytesBegin;
+				pResult->heapModeAllocStats = renderer.GetLoadStats();
+			}
+		}
+
+		if(mode==0)
+			pResult->liveAllocCount = GetLiveAllocCount() - liveBegin;
+		else
+			pResult->heapModeLiveAllocCount = GetLiveAllocCount() - liveBegin;
+	}
+}
+
+// Aj[Ṽm[hƃXLEFCg_. LbVǂ񂾎ɏĂȂׂ
+static void GetSceneData(const FBX_LOADER::CFBXRenderDX11& renderer, uint32_t* pAnimationNodeCount, uint64_t* pSkinVertexCount)
+{
+	const FBX_LOADER::CFBXAnimation* pAnimation = renderer.GetAnimation();
+	*pAnimationNodeCount = (pAnimation && pAnimation->IsAnimated()) ? static_cast<uint32_t>(pAnimation->GetNodeCount()) : 0;
+
+	*pSkinVertexCount = 0;
+	for(size_t i=0;i<renderer.GetNodeCount();i++)
+	{
+		const FBX_LOADER::FBX_MESH_NODE* pNode = renderer.GetSourceNode(i);
+		if(pNode)
+			*pSkinVertexCount += pNode->m_skinArray.size();
+	}
+}
+
+static size_t GetWorkingSet()
+{
+	PROCESS_MEMORY_COUNTERS counters;
+	ZeroMemory(&counters, sizeof(counters));
+	if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return 0;
+	return counters.WorkingSetSize;
+}
+
+// ʒuƖ@Œ_T߂̃L[(rbgPʂŔׂ)
+struct VERTEX_KEY
+{
+	float	value[6];
+
+	bool operator<(const VERTEX_KEY& key) const { return memcmp(value, key.value, sizeof(value)) < 0; }
+	bool operator==(const VERTEX_KEY& key) const { return memcmp(value, key.value, sizeof(value)) == 0; }
+};
+
+// float32tH[}bgŏoLbV̒_߂, ʒuƖ@̃m[ĥǂꂩ̒_ƈv邱Ƃm߂.
+// LbVɂ̓Abv[ĥƓ_̂, _̕(XgCh)̊ԈႢŕ
+static bool CheckCachedVertices(const FBX_LOADER::CFBXRenderDX11& renderer, const std::string& cachePath, const char* filename)
+{
+	const FBX_LOADER::CFBXVertexLayout& layout = renderer.GetVertexLayout();
+	FBX_LOADER::CFBXMeshCache cache;
+	if(FAILED(cache.OpenBaked(cachePath.c_str(), layout.GetFormat().GetCode(), layout.GetStride())) || cache.GetNodeCount() != renderer.GetNodeCount())
+	{
+		printf("Error: %s: Unable to open the written mesh cache\n", filename);
+		return false;
+	}
+
+	std::vector<VERTEX_KEY> sourceArray;
+	std::vector<FBX_LOADER::VERTEX_DATA> decodedArray;
+	for(uint32_t i=0;i<cache.GetNodeCount();i++)
+	{
+		const FBX_LOADER::FBX_MESH_CACHE_NODE& cacheNode = cache.GetNode(i);
+		const FBX_LOADER::FBX_MESH_NODE* pSourceNode = renderer.GetSourceNode(i);
+		if(cacheNode.vertexCount==0)
+			continue;
+		if(!pSourceNode || pSourceNode->m_normalArray.size() != pSourceNode->m_positionArray.size())
+		{
+			printf("Error: %s: node %u has no source vertices to compare with\n", filename, i);
+			return false;
+		}
+
+		const size_t sourceCount = pSourceNode->m_positionArray.size();
+		sourceArray.resize(sourceCount);
+		for(size_t v=0;v<sourceCount;v++)
+		{
+			memcpy(&sourceArray[v].value[0], &pSourceNode->m_positionArray[v], sizeof(float) * 3);
+			memcpy(&sourceArray[v].value[3], &pSourceNode->m_normalArray[v], sizeof(float) * 3);
+		}
+		std::sort(sourceArray.begin(), sourceArray.end());
+
+		FBX_LOADER::CMappedView view;
+		if(FAILED(cache.MapVertices(cacheNode, &view)))
+		{
+			printf("Error: %s: Unable to map the vertices of node %u\n", filename, i);
+			return false;
+		}
+
+		FBX_LOADER::VERTEX_DEQUANT_DATA dequant;
+		dequant.positionScale = DirectX::XMFLOAT4(cacheNode.positionScale[0], cacheNode.positionScale[1], cacheNode.positionScale[2], 0.0f);
+		dequant.positionOffset = DirectX::XMFLOAT4(cacheNode.positionOffset[0], cacheNode.positionOffset[1], cacheNode.positionOffset[2], 0.0f);
+		decodedArray.resize(cacheNode.vertexCount);
+		layout.Decode(view.GetData(), cacheNode.vertexCount, dequant, &decodedArray[0]);
+
+		for(uint32_t v=0;v<cacheNode.vertexCount;v++)
+		{
+			VERTEX_KEY key;
+			memcpy(&key.value[0], &decodedArray[v].vPos, sizeof(float) * 3);
+			memcpy(&key.value[3], &decodedArray[v].vNor, sizeof(float) * 3);
+			if(!std::binary_search(sourceArray.begin(), sourceArray.end(), key))
+			{
+				printf("Error: %s: node %u vertex %u (%f, %f, %f) does not match any source vertex\n", filename, i, v,
+					decodedArray[v].vPos.x, decodedArray[v].vPos.y, decodedArray[v].vPos.z);
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+// oLbVLoadBakedMeshœǂݍ(m[h̃obt@).
+// L^foCX󂯑ɂ, SĂ̒_ECfbNXobt@̏f[^}bvt@C𒼐ڎwĂ邱(Rs[)m,
+// ǂݍݒ̃[LOZbg̑ԑ傫obt@Ɣׂ
+static bool MeasureBakedLoad(const BENCH_OPTION& option, CRecordingDevice* pDevice, const std::string& cachePath, BENCH_RESULT* pResult)
+{
+	FBX_LOADER::CFBXRenderDX11 renderer;
+	SetupRenderer(option, &renderer);
+	renderer.SetPackedUpload(false);
+
+	// ǂݍݑOɒǂoĂ, CreateBuffer̓xɑőƂ̍ǂݍ݂őƂ
+	SetProcessWorkingSetSize(GetCurrentProcess(), static_cast<SIZE_T>(-1), static_cast<SIZE_T>(-1));
+	const size_t baseWorkingSet = GetWorkingSet();
+
+	pDevice->ResetStats();
+	pDevice->SetSampleWorkingSet(true);
+	HRESULT hr = renderer.LoadBakedMesh(cachePath.c_str(), pDevice);
+	pDevice->SetSampleWorkingSet(false);
+	renderer.WaitTextures();
+	if(FAILED(hr))
+	{
+		printf("Error: %s: Unable to load the baked mesh\n", cachePath.c_str());
+		return false;
+	}
+
+	const RECORDING_STATS record = pDevice->GetStats();
+	pResult->bakedBufferCount = record.vertexBufferCount + record.indexBufferCount;
+	pResult->bakedMappedCount = record.mappedInitDataCount;
+	pResult->bakedMaxBufferBytes = record.maxBufferBytes;
+	pResult->bakedWorkingSetGrowth = record.peakWorkingSet > baseWorkingSet ? record.peakWorkingSet - baseWorkingSet : 0;
+
+	// 萔obt@(_̕p)͏f[^X^bNɂ̂ŐȂ
+	if(pResult->bakedMappedCount != pResult->bakedBufferCount || !CheckBufferRecord(record, renderer.GetLoadStats(), cachePath.c_str()))
+	{
+		printf("Error: %s: %u of %u vertex/index buffers were created from the mapped file\n", cachePath.c_str(),
+			pResult->bakedMappedCount, pResult->bakedBufferCount);
+		return false;
+	}
+
+	return true;
+}
+
+// bVLbVĂǂݍ(cold, LbVo), repeatǂݍ(warm).
+// warmLbVǂłAj[VƃXLcĂ邱,
+// ǂV[ȂwarmLbVǂ߂Ă邱Ƃm߂
+static bool MeasureMeshCache(const BENCH_OPTION& option, CRecordingDevice* pDevice, BENCH_RESULT* pResult)
+{
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+
+	const std::string cachePath = FBX_LOADER::CFBXMeshCache::GetCachePath(pResult->filename.c_str());
+	DeleteFileA(cachePath.c_str());
+
+	uint32_t coldAnimationNodeCount = 0;
+	uint64_t coldSkinVertexCount = 0;
+	uint64_t coldIndexCount = 0;
+	bool succeeded = true;
+	for(unsigned int pass=0;pass<1+option.repeat && succeeded;pass++)
+	{
+		FBX_LOADER::CFBXRenderDX11 renderer;
+		SetupRenderer(option, &renderer);
+		renderer.SetMeshCacheEnable(true);
+
+		LARGE_INTEGER begin, end;
+		QueryPerformanceCounter(&begin);
+		HRESULT hr = renderer.LoadFBX(pResult->filename.c_str(), pDevice, pDevice->GetRecordingContext(), option.isOptimize);
+		QueryPerformanceCounter(&end);
+		renderer.WaitTextures();
+		if(FAILED(hr))
+		{
+			printf("Error: %s: Unable to load with the mesh cache\n", pResult->filename.c_str());
+			succeeded = false;
+			break;
+		}
+
+		const double time = static_cast<double>(end.QuadPart - begin.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart);
+		const FBX_LOADER::FBX_LOAD_STATS& stats = renderer.GetLoadStats();
+		uint32_t animationNodeCount = 0;
+		uint64_t skinVertexCount = 0;
+		GetSceneData(renderer, &animationNodeCount, &skinVertexCount);
+
+		if(pass==0)
+		{
+			pResult->coldCacheMs = time;
+			coldAnimationNodeCount = animationNodeCount;
+			coldSkinVertexCount = skinVertexCount;
+			coldIndexCount = stats.bufferIndexCount;
+			pResult->cacheUsable = (animationNodeCount==0 && skinVertexCount==0);
+			if(stats.meshCacheHit != 0)
+			{
+				printf("Error: %s: mesh cache was hit after deleting it\n", pResult->filename.c_str());
+				succeeded = false;
+			}
+			if(pResult->cacheUsable && renderer.GetVertexLayout().GetFormat().GetCode() == FBX_LOADER::FBX_VERTEX_FORMAT().GetCode()
+				&& !CheckCachedVertices(renderer, cachePath, pResult->filename.c_str()))
+				succeeded = false;
+			continue;
+		}
+
+		pResult->warmCacheTimeArray.push_back(time);
+		pResult->warmCacheStats = stats;
+		if(stats.meshCacheHit != (pResult->cacheUsable ? 1u : 0u)
+			|| animationNodeCount != coldAnimationNodeCount || skinVertexCount != coldSkinVertexCount || stats.bufferIndexCount != coldIndexCount)
+		{
+			printf("Error: %s: mesh cache cold/warm: cache hit %u, animation nodes %u/%u, skin vertices %llu/%llu, indices %llu/%llu\n",
+				pResult->filename.c_str(), stats.meshCacheHit, coldAnimationNodeCount, animationNodeCount,
+				static_cast<unsigned long long>(coldSkinVertexCount), static_cast<unsigned long long>(skinVertexCount),
+				static_cast<unsigned long long>(coldIndexCount), static_cast<unsigned long long>(stats.bufferIndexCount));
+			succeeded = false;
+		}
+	}
+
+	if(succeeded && pResult->cacheUsable && !MeasureBakedLoad(option, pDevice, cachePath, pResult))
+		succeeded = false;
+
+	DeleteFileA(cachePath.c_str());
+
+	return succeeded;
+}
+
+// MeasureRenderQueueŕ`悷t[
+static const uint32_t RENDER_QUEUE_FRAME_COUNT = 3;
+
+static uint32_t GetMaxSortId(const FBX_LOADER::CFBXRenderDX11& renderer, uint32_t* pMinId)
+{
+	uint32_t maxId = 0;
+	*pMinId = UINT32_MAX;
+	for(size_t i=0;i<renderer.GetNodeCount();i++)
+	{
+		const FBX_LOADER::MESH_NODE& node = renderer.GetNode(static_cast<int>(i));
+		if(node.geometryId != 0)
+		{
+			maxId = std::max(maxId, node.geometryId);
+			*pMinId = std::min(*pMinId, node.geometryId);
+		}
+		for(size_t m=0;m<node.materialArray.size();m++)
+		{
+			maxId = std::max(maxId, node.materialArray[m].sortId);
+			*pMinId = std::min(*pMinId, node.materialArray[m].sortId);
+		}
+	}
+	return maxId;
+}
+
+// CFBXRenderQueueŐt[`悵, RENDER_QUEUE_STATS̉񐔂ReLXgۂɎ󂯂Ăяoƍm߂.
+// 2ڂ̓ǂݍ݂1ڂȂ̂œAhXɃobt@꓾邪, \[gL[̔ԍ͐VȂĂ邱
+static bool MeasureRenderQueue(const BENCH_OPTION& option, CRecordingDevice* pDevice, BENCH_RESULT* pResult)
+{
+	CRecordingContext* pContext = pDevice->GetRecordingContext();
+
+	DirectX::XMFLOAT4X4 world, view, projection;
+	DirectX::XMStoreFloat4x4(&world, DirectX::XMMatrixIdentity());
+	DirectX::XMStoreFloat4x4(&view, DirectX::XMMatrixLookAtLH(DirectX::XMVectorSet(0.0f, 0.0f, -100.0f, 1.0f),
+		DirectX::XMVectorZero(), DirectX::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)));
+	DirectX::XMStoreFloat4x4(&projection, DirectX::XMMatrixPerspectiveFovLH(DirectX::XM_PIDIV4, 16.0f / 9.0f, 0.1f, 10000.0f));
+
+	FBX_LOADER::CFBXRenderQueue queue;
+	if(FAILED(queue.Initialize(pDevice)))
+		return false;
+
+	bool succeeded = true;
+	uint32_t prevMaxId = 0;
+	for(int load=0;load<2 && succeeded;load++)
+	{
+		FBX_LOADER::CFBXRenderDX11 renderer;
+		SetupRenderer(option, &renderer);
+		if(FAILED(renderer.LoadFBX(pResult->filename.c_str(), pDevice, pContext, option.isOptimize)))
+			return false;
+		renderer.WaitTextures();
+
+		uint32_t minId = 0;
+		const uint32_t maxId = GetMaxSortId(renderer, &minId);
+		if(load==1 && maxId > 0 && minId <= prevMaxId)
+		{
+			printf("Error: %s: sort id %u was reused after reloading (previous max %u)\n", pResult->filename.c_str(), minId, prevMaxId);
+			succeeded = false;
+		}
+		prevMaxId = maxId;
+
+		for(uint32_t frame=0;frame<RENDER_QUEUE_FRAME_COUNT;frame++)
+		{
+			queue.Begin(view, projection);
+			queue.SubmitAll(renderer, world);
+
+			pContext->ResetStats();
+			if(FAILED(queue.Flush(pContext)))
+				return false;
+
+			const RECORDING_STATS& record = pContext->GetStats();
+			const FBX_LOADER::RENDER_QUEUE_STATS& stats = queue.GetStats();
+			const uint32_t materialCallCount = record.GetCount(RECORD_PS_SET_SHADER_RESOURCES) + record.GetCount(RECORD_PS_SET_SAMPLERS)
+				+ record.GetCount(RECORD_PS_SET_CONSTANT_BUFFERS);
+			if(record.GetCount(RECORD_DRAW) != stats.drawCount
+				|| record.GetCount(RECORD_IA_SET_PRIMITIVE_TOPOLOGY) != stats.topologyBindCount
+				|| record.GetCount(RECORD_IA_SET_INPUT_LAYOUT) != stats.inputLayoutBindCount
+				|| record.GetCount(RECORD_IA_SET_VERTEX_BUFFERS) != stats.vertexBufferBindCount
+				|| record.GetCount(RECORD_IA_SET_INDEX_BUFFER) != stats.indexBufferBindCount
+				|| record.GetCount(RECORD_VS_SET_CONSTANT_BUFFERS) != stats.constantBufferBindCount
+				|| materialCallCount != stats.materialBindCount
+				|| record.GetCount(RECORD_MAP) != stats.mapCount)
+			{
+				printf("Error: %s: frame %u: recorded draw %u ia %u/%u/%u/%u cb %u material %u map %u, queue stats draw %u ia %u/%u/%u/%u cb %u material %u map %u\n",
+					pResult->filename.c_str(), frame,
+					record.GetCount(RECORD_DRAW), record.GetCount(RECORD_IA_SET_PRIMITIVE_TOPOLOGY), record.GetCount(RECORD_IA_SET_INPUT_LAYOUT),
+					record.GetCount(RECORD_IA_SET_VERTEX_BUFFERS), record.GetCount(RECORD_IA_SET_INDEX_BUFFER),
+					record.GetCount(RECORD_VS_SET_CONSTANT_BUFFERS), materialCallCount, record.GetCount(RECORD_MAP),
+					stats.drawCount, stats.topologyBindCount, stats.inputLayoutBindCount, stats.vertexBufferBindCount, stats.indexBufferBindCount,
+					stats.constantBufferBindCount, stats.materialBindCount, stats.mapCount);
+				succeeded = false;
+			}
+
+			pResult->queueStats = stats;
+			pResult->queueFrameCount++;
+		}
+	}
+
+	return succeeded;
+}
+
+// SetPackedUpload̊mFɎgf̃m[h
+static const uint32_t PACKED_CHECK_NODE_COUNT = 8;
+// 32bit̏ꍇɐ擪m[h65535𒴂钸_ɂ
+static const uint32_t PACKED_CHECK_LARGE_VERTEX_COUNT = 70000;
+
+// m[hɎOp`ׂ.meshcacheo. use32bitȂ擪m[h̃CfbNX32bitɂȂ
+static HRESULT WritePackedCheckCache(const char* filename, const bool use32bit, const FBX_LOADER::CFBXVertexLayout& layout,
+	uint64_t* pIndex16Count, uint64_t* pIndex32Count)
+{
+	*pIndex16Count = 0;
+	*pIndex32Count = 0;
+
+	FBX_LOADER::CFBXMeshCacheWriter writer;
+	for(uint32_t i=0;i<PACKED_CHECK_NODE_COUNT;i++)
+	{
+		FBX_LOADER::FBX_MESH_CACHE_SOURCE_NODE* pNode = writer.AddNode();
+		pNode->name = "node";
+		pNode->mat4x4[0] = pNode->mat4x4[5] = pNode->mat4x4[10] = pNode->mat4x4[15] = 1.0f;
+
+		const bool isLarge = use32bit && i==0;
+		const uint32_t vertexCount = isLarge ? PACKED_CHECK_LARGE_VERTEX_COUNT : 300 + i * 30;
+		std::vector<BYTE> vertices(static_cast<size_t>(vertexCount) * layout.GetStride(), 0);
+		pNode->SetVertices(&vertices[0], layout.GetStride(), vertexCount);
+
+		std::vector<uint32_t> indices;
+		for(uint32_t v=0;v+2<vertexCount;v+=3)
+		{
+			indices.push_back(v);
+			indices.push_back(v + 1);
+			indices.push_back(v + 2);
+		}
+		const uint32_t indexCount = static_cast<uint32_t>(indices.size());
+
+		if(isLarge)
+		{
+			pNode->SetIndices(&indices[0], sizeof(uint32_t), indexCount);
+			*pIndex32Count += indexCount;
+		}
+		else
+		{
+			std::vector<uint16_t> indices16(indices.begin(), indices.end());
+			pNode->SetIndices(&indices16[0], sizeof(uint16_t), indexCount);
+			*pIndex16Count += indexCount;
+		}
+	}
+
+	return writer.Write(filename, 0, 0, 0, layout.GetFormat().GetCode(), layout.GetStride());
+}
+
+// SetPackedUploadŒ_ECfbNXobt@fŜ1(CreateBuffer2)ɂȂ邩,
+// 16bit̃f32bit̃m[h܂ރfŊm߂. m[hȂ2~m[hɂȂ
+static bool CheckPackedUpload(const BENCH_OPTION& option, CRecordingDevice* pDevice)
+{
+	char tempDirectory[MAX_PATH];
+	if(GetTempPathA(MAX_PATH, tempDirectory)==0)
+	{
+		printf("Error: Unable to get the temporary directory\n");
+		return false;
+	}
+
+	bool succeeded = true;
+	for(int bit=0;bit<2;bit++)
+	{
+		const bool use32bit = (bit==1);
+		const std::string path = std::string(tempDirectory) + (use32bit ? "FBXLoaderBench_packed32.meshcache" : "FBXLoaderBench_packed16.meshcache");
+
+		uint64_t index16Count = 0;
+		uint64_t index32Count = 0;
+		uint32_t createCount[2] = { 0, 0 };
+		uint32_t constantCount[2] = { 0, 0 };
+		for(int mode=0;mode<2 && succeeded;mode++)
+		{
+			const bool isPacked = (mode==1);
+
+			FBX_LOADER::CFBXRenderDX11 renderer;
+			SetupRenderer(option, &renderer);
+			renderer.SetPackedUpload(isPacked);
+
+			if(mode==0 && FAILED(WritePackedCheckCache(path.c_str(), use32bit, renderer.GetVertexLayout(), &index16Count, &index32Count)))
+			{
+				printf("Error: Unable to write %s\n", path.c_str());
+				succeeded = false;
+				break;
+			}
+
+			pDevice->ResetStats();
+			HRESULT hr = renderer.LoadBakedMesh(path.c_str(), pDevice);
+			const RECORDING_STATS record = pDevice->GetStats();
+			if(FAILED(hr))
+			{
+				printf("Error: Unable to load %s\n", path.c_str());
+				succeeded = false;
+				break;
+			}
+
+			// ܂Ƃ߂ꍇ1m[hł32bitȂobt@Ŝ32bit
+			const uint32_t expectCount = isPacked ? 2 : 2 * PACKED_CHECK_NODE_COUNT;
+			const uint64_t expectIndexBytes = (isPacked && use32bit) ? (index16Count + index32Count) * sizeof(uint32_t) :
+				index16Count * sizeof(uint16_t) + index32Count * sizeof(uint32_t);
+
+			// Sm[ḧʒu̕萔(}eA)Ȃ̂, 萔obt@͋L1
+			createCount[mode] = record.GetCount(RECORD_CREATE_BUFFER);
+			constantCount[mode] = record.constantBufferCount;
+			if(record.vertexBufferCount + record.indexBufferCount != expectCount || record.vertexBufferCount != record.indexBufferCount
+				|| record.indexBufferBytes != expectIndexBytes || constantCount[mode] > 1 || createCount[mode] != expectCount + constantCount[mode])
+			{
+				printf("Error: %s %s: CreateBuffer %u (expected %u vertex/index + 1 constant), constant %u, index bytes %llu (expected %llu)\n",
+					use32bit ? "32bit" : "16bit", isPacked ? "packed" : "per-node", createCount[mode], expectCount, constantCount[mode],
+					static_cast<unsigned long long>(record.indexBufferBytes), static_cast<unsigned long long>(expectIndexBytes));
+				succeeded = false;
+			}
+			if(!CheckBufferRecord(record, renderer.GetLoadStats(), path.c_str()))
+				succeeded = false;
+		}
+
+		DeleteFileA(path.c_str());
+
+		if(!succeeded)
+			break;
+
+		printf("packed:    %-29s %6u nodes per-node %4u CreateBuffer packed %4u CreateBuffer (%u constant)\n", use32bit ? "32bit index" : "16bit index",
+			PACKED_CHECK_NODE_COUNT, createCount[0], createCount[1], constantCount[1]);
+	}
+
+	return succeeded;
+}
+
+static void RunFile(const BENCH_OPTION& option, CRecordingDevice* pDevice, BENCH_RESULT* pResult)
+{
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+
+	ID3D11DeviceContext* pContext = pDevice->GetRecordingContext();
+
+	pResult->succeeded = true;
+	for(unsigned int i=0;i<option.repeat;i++)
+	{
+		FBX_LOADER::CFBXRenderDX11 renderer;
+		SetupRenderer(option, &renderer);
+		pDevice->ResetStats();
+
+		LARGE_INTEGER begin, end;
+		QueryPerformanceCounter(&begin);
+		HRESULT hr = renderer.LoadFBX(pResult->filename.c_str(), pDevice, pContext, option.isOptimize);
+		QueryPerformanceCounter(&end);
+
+		// ǂݍݒ̃eNX`c܂܎̉ɐi܂Ȃ
+		renderer.WaitTextures();
+
+		if(FAILED(hr))
+		{
+			pResult->succeeded = false;
+			break;
+		}
+
+		pResult->recordStats = pDevice->GetStats();
+		if(!CheckBufferRecord(pResult->recordStats, renderer.GetLoadStats(), pResult->filename.c_str()))
+			pResult->checkFailCount++;
+
+		pResult->timeArray.push_back(static_cast<double>(end.QuadPart - begin.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart));
+		pResult->stats = renderer.GetLoadStats();
+		pResult->triangleCount = pResult->stats.bufferIndexCount / 3;
+
+		if(i+1 == option.repeat)
+		{
+			MeasureAnimation(renderer.GetAnimation(), pResult);
+			MeasureSkinning(renderer, pResult);
+		}
+	}
+
+	pResult->peakWorkingSet = GetPeakWorkingSet();
+
+	if(pResult->succeeded)
+	{
+		MeasureAllocations(option, pDevice, pContext, pResult);
+		if(!MeasureRenderQueue(option, pDevice, pResult))
+			pResult->checkFailCount++;
+		if(!MeasureMeshCache(option, pDevice, pResult))
+			pResult->checkFailCount++;
+	}
+
+	// ɂđȂ邽, ݒ1Xbhłǂݍ
+	for(unsigned int i=0;pResult->succeeded && option.threadCount!=1 && i<option.repeat;i++)
+	{
+		FBX_LOADER::CFBXRenderDX11 renderer;
+		SetupRenderer(option, &renderer);
+		renderer.SetLoadThreadCount(1);
+		pDevice->ResetStats();
+
+		LARGE_INTEGER begin, end;
+		QueryPerformanceCounter(&begin);
+		HRESULT hr = renderer.LoadFBX(pResult->filename.c_str(), pDevice, pContext, option.isOptimize);
+		QueryPerformanceCounter(&end);
+		renderer.WaitTextures();
+		if(FAILED(hr))
+			break;
+
+		if(!CheckBufferRecord(pDevice->GetStats(), renderer.GetLoadStats(), pResult->filename.c_str()))
+			pResult->checkFailCount++;
+
+		pResult->serialTimeArray.push_back(static_cast<double>(end.QuadPart - begin.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart));
+		pResult->serialStats = renderer.GetLoadStats();
+	}
+}
+
+static void WriteJSON(const char* filename, const char* driverName, const std::vector<BENCH_RESULT>& resultArray,
+	const CULLING_RESULT& culling, const HIERARCHY_RESULT& hierarchy, const uint64_t totalTriangle, const double totalTime)
+{
+	FILE* fp = nullptr;
+	if(fopen_s(&fp, filename, "w") != 0 || !fp)
+	{
+		printf("Error: Unable to write %s\n", filename);
+		return ;
+	}
+
+	fprintf(fp, "{\n\t\"device\": \"%s\",\n\t\"files\": [\n", driverName);
+	for(size_t i=0;i<resultArray.size();i++)
+	{
+		const BENCH_RESULT& result = resultArray[i];
+
+		// pX؂'\'JSONł̓GXP[vKv
+		std::string name;
+		for(size_t j=0;j<result.filename.size();j++)
+		{
+			if(result.filename[j]=='\\' || result.filename[j]=='"')
+				name += '\\';
+			name += result.filename[j];
+		}
+
+		fprintf(fp, "\t\t{\n");
+		fprintf(fp, "\t\t\t\"file\": \"%s\",\n", name.c_str());
+		fprintf(fp, "\t\t\t\"succeeded\": %s,\n", result.succeeded ? "true" : "false");
+		fprintf(fp, "\t\t\t\"runs\": %u,\n", static_cast<unsigned int>(result.timeArray.size()));
+		fprintf(fp, "\t\t\t\"triangles\": %llu,\n", result.triangleCount);
+		fprintf(fp, "\t\t\t\"minMs\": %.3f,\n", result.GetPercentile(0.0));
+		fprintf(fp, "\t\t\t\"p50Ms\": %.3f,\n", result.GetPercentile(50.0));
+		fprintf(fp, "\t\t\t\"p90Ms\": %.3f,\n", result.GetPercentile(90.0));
+		fprintf(fp, "\t\t\t\"maxMs\": %.3f,\n", result.GetPercentile(100.0));
+		fprintf(fp, "\t\t\t\"trianglesPerSecond\": %.1f,\n", result.GetTrianglesPerSecond());
+		fprintf(fp, "\t\t\t\"peakWorkingSetBytes\": %llu,\n", static_cast<unsigned long long>(result.peakWorkingSet));
+		fprintf(fp, "\t\t\t\"animationNodes\": %u,\n", result.animationNodeCount);
+		fprintf(fp, "\t\t\t\"animationTracks\": %u,\n", result.animationTrackCount);
+		fprintf(fp, "\t\t\t\"animationNodesPerMs\": %.1f,\n", result.animationNodesPerMs);
+		fprintf(fp, "\t\t\t\"skinVertices\": %llu,\n", static_cast<unsigned long long>(result.skinVertexCount));
+		fprintf(fp, "\t\t\t\"skinVerticesPerSecond\": %.1f,\n", result.skinVerticesPerSecond);
+		if(!result.serialTimeArray.empty())
+		{
+			fprintf(fp, "\t\t\t\"serialP50Ms\": %.3f,\n", GetPercentile(result.serialTimeArray, 50.0));
+			fprintf(fp, "\t\t\t\"serialBuildNodesMs\": %.3f,\n", result.serialStats.stageTime[FBX_LOADER::FBX_LOAD_STAGE_BUILD_NODES]);
+		}
+		fprintf(fp, "\t\t\t\"allocNodes\": %u,\n", result.allocNodeCount);
+		fprintf(fp, "\t\t\t\"createNodesAllocs\": %llu,\n", static_cast<unsigned long long>(GetCreateAllocCount(result.allocStats)));
+		fprintf(fp, "\t\t\t\"createNodesAllocsHeapMode\": %llu,\n", static_cast<unsigned long long>(GetCreateAllocCount(result.heapModeAllocStats)));
+		fprintf(fp, "\t\t\t\"liveAllocsAfterRelease\": %lld,\n", static_cast<long long>(result.liveAllocCount));
+		fprintf(fp, "\t\t\t\"liveAllocsAfterReleaseHeapMode\": %lld,\n", static_cast<long long>(result.heapModeLiveAllocCount));
+		fprintf(fp, "\t\t\t\"peakHeapBytes\": %lld,\n", static_cast<long long>(result.peakHeapBytes));
+		fprintf(fp, "\t\t\t\"peakHeapBytesHeapMode\": %lld,\n", static_cast<long long>(result.heapModePeakHeapBytes));
+		if(!result.warmCacheTimeArray.empty())
+		{
+			fprintf(fp, "\t\t\t\"meshCacheUsable\": %s,\n", result.cacheUsable ? "true" : "false");
+			fprintf(fp, "\t\t\t\"coldCacheMs\": %.3f,\n", result.coldCacheMs);
+			fprintf(fp, "\t\t\t\"warmCacheP50Ms\": %.3f,\n", GetPercentile(result.warmCacheTimeArray, 50.0));
+			fprintf(fp, "\t\t\t\"bakedBuffers\": %u,\n", result.bakedBufferCount);
+			fprintf(fp, "\t\t\t\"bakedMappedBuffers\": %u,\n", result.bakedMappedCount);
+			fprintf(fp, "\t\t\t\"bakedWorkingSetGrowthBytes\": %llu,\n", static_cast<unsigned long long>(result.bakedWorkingSetGrowth));
+			fprintf(fp, "\t\t\t\"bakedMaxBufferBytes\": %llu,\n", static_cast<unsigned long long>(result.bakedMaxBufferBytes));
+		}
+		fprintf(fp, "\t\t\t\"stats\": %s", result.stats.ToJSON().c_str());
+		fprintf(fp, "\t\t}%s\n", (i+1 < resultArray.size()) ? "," : "");
+	}
+	fprintf(fp, "\t],\n");
+	fprintf(fp, "\t\"culling\": {\n");
+	fprintf(fp, "\t\t\"objects\": %u,\n", culling.objectCount);
+	fprintf(fp, "\t\t\"visible\": %u,\n", culling.visibleCount);
+	fprintf(fp, "\t\t\"batchMs\": %.4f,\n", culling.batchMs);
+	fprintf(fp, "\t\t\"scalarMs\": %.4f\n", culling.scalarMs);
+	fprintf(fp, "\t},\n");
+	fprintf(fp, "\t\"hierarchy\": {\n");
+	fprintf(fp, "\t\t\"nodes\": %u,\n", hierarchy.nodeCount);
+	fprintf(fp, "\t\t\"dirty\": %u,\n", hierarchy.dirtyCount);
+	fprintf(fp, "\t\t\"partialNodes\": %u,\n", hierarchy.partialNodeCount);
+	fprintf(fp, "\t\t\"threads\": %u,\n", hierarchy.threadCount);
+	fprintf(fp, "\t\t\"fullMs\": %.4f,\n", hierarchy.fullMs);
+	fprintf(fp, "\t\t\"partialMs\": %.4f,\n", hierarchy.partialMs);
+	fprintf(fp, "\t\t\"parallelMs\": %.4f,\n", hierarchy.parallelMs);
+	fprintf(fp, "\t\t\"parallelFirstMs\": %.4f\n", hierarchy.parallelFirstMs);
+	fprintf(fp, "\t},\n");
+	fprintf(fp, "\t\"totalTriangles\": %llu,\n", totalTriangle);
+	fprintf(fp, "\t\"totalP50Ms\": %.3f,\n", totalTime);
+	fprintf(fp, "\t\"trianglesPerSecond\": %.1f,\n", totalTime > 0.0 ? static_cast<double>(totalTriangle) * 1000.0 / totalTime : 0.0);
+	fprintf(fp, "\t\"peakWorkingSetBytes\": %llu\n}\n", static_cast<unsigned long long>(GetPeakWorkingSet()));
+
+	fclose(fp);
+}
+
+int main(int argc, char* argv[])
+{
+	BENCH_OPTION option;
+	if(!ParseOption(argc, argv, &option))
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	std::vector<std::string> fileArray;
+	FindFiles(option.path, &fileArray);
+	if(fileArray.size()==0)
+	{
+		printf("Error: No FBX file in %s\n", option.path.c_str());
+		return 1;
+	}
+
+	CRecordingDevice*		pDevice = nullptr;
+	const char*				driverName = "";
+	if(FAILED(CreateDevice(&pDevice, &driverName)))
+	{
+		printf("Error: Unable to create D3D11 device!\n");
+		return 1;
+	}
+
+	std::vector<BENCH_RESULT> resultArray(fileArray.size());
+	for(size_t i=0;i<fileArray.size();i++)
+	{
+		resultArray[i].filename = fileArray[i];
+		RunFile(option, pDevice, &resultArray[i]);
+	}
+
+	// ʂ̕\(lŏWv)
+	printf("\ndevice: %s, runs: %u, optimize: %s, packed: %s, compressed: %s, skin: %s\n", driverName, option.repeat, option.isOptimize ? "on" : "off",
+		option.isPacked ? "on" : "off", option.isCompressed ? "on" : "off", option.isSkinned ? "on" : "off");
+	printf("%-40s %10s %10s %10s %10s %14s %10s\n", "file", "tris", "min ms", "p50 ms", "p90 ms", "tris/s", "peak MB");
+
+	uint64_t totalTriangle = 0;
+	double totalTime = 0.0;
+	int failedCount = 0;
+	for(size_t i=0;i<resultArray.size();i++)
+	{
+		const BENCH_RESULT& result = resultArray[i];
+
+		std::string name = result.filename;
+		const size_t pos = name.find_last_of("\\/");
+		if(pos != std::string::npos)
+			name = name.substr(pos + 1);
+
+		if(!result.succeeded)
+		{
+			printf("%-40s failed\n", name.c_str());
+			failedCount++;
+			continue;
+		}
+
+		printf("%-40s %10llu %10.2f %10.2f %10.2f %14.0f %10.1f\n", name.c_str(), result.triangleCount,
+			result.GetPercentile(0.0), result.GetPercentile(50.0), result.GetPercentile(90.0),
+			result.GetTrianglesPerSecond(), static_cast<double>(result.peakWorkingSet) / (1024.0 * 1024.0));
+
+		totalTriangle += result.triangleCount;
+		totalTime += result.GetPercentile(50.0);
+	}
+
+	printf("%-40s %10llu %10s %10.2f %10s %14.0f %10.1f\n", "total", totalTriangle, "", totalTime, "",
+		totalTime > 0.0 ? static_cast<double>(totalTriangle) * 1000.0 / totalTime : 0.0,
+		static_cast<double>(GetPeakWorkingSet()) / (1024.0 * 1024.0));
+
+	// Aj[VXL̂t@C
+	for(size_t i=0;i<resultArray.size();i++)
+	{
+		const BENCH_RESULT& result = resultArray[i];
+		if(!result.succeeded || (result.animationNodeCount==0 && result.skinVertexCount==0))
+			continue;
+
+		std::string name = result.filename;
+		const size_t pos = name.find_last_of("\\/");
+		if(pos != std::string::npos)
+			name = name.substr(pos + 1);
+
+		// k͈kȂꍇ̃TCY / k̃TCY
+		if(result.animationNodeCount > 0)
+		{
+			const double ratio = result.stats.animationBytes > 0 ?
+				static_cast<double>(result.stats.animationRawBytes) / static_cast<double>(result.stats.animationBytes) : 0.0;
+			printf("animation: %-29s %10u nodes %10u tracks %14.0f nodes/ms %6.2fx %10g error\n", name.c_str(),
+				result.animationNodeCount, result.animationTrackCount, result.animationNodesPerMs,
+				ratio, result.stats.animationMaxError);
+		}
+		if(result.skinVertexCount > 0)
+			printf("skinning:  %-29s %10llu verts %28.0f verts/s\n", name.c_str(),
+				static_cast<unsigned long long>(result.skinVertexCount), result.skinVerticesPerSecond);
+	}
+
+	// FBX SDK̒_̃Rs[(CFBXLoadersetup)̑. nڑO̒_(|S̊p)̐Ŋ
+	for(size_t i=0;i<resultArray.size();i++)
+	{
+		const BENCH_RESULT& result = resultArray[i];
+		if(!result.succeeded || result.stats.meshCacheHit)
+			continue;
+
+		std::string name = result.filename;
+		const size_t pos = name.find_last_of("\\/");
+		if(pos != std::string::npos)
+			name = name.substr(pos + 1);
+
+		const double setupTime = result.stats.stageTime[FBX_LOADER::FBX_LOAD_STAGE_SETUP];
+		printf("setup:     %-29s %10llu corners %10.2f ms %14.0f corners/ms\n", name.c_str(),
+			static_cast<unsigned long long>(result.stats.sourceVertexCount), setupTime,
+			setupTime > 0.0 ? static_cast<double>(result.stats.sourceVertexCount) / setupTime : 0.0);
+	}
+
+	// bVLbV1(cold), LbVǂ2ڈȍ~(warm)̒l
+	for(size_t i=0;i<resultArray.size();i++)
+	{
+		const BENCH_RESULT& result = resultArray[i];
+		if(!result.succeeded || result.warmCacheTimeArray.empty())
+			continue;
+
+		std::string name = result.filename;
+		const size_t pos = name.find_last_of("\\/");
+		if(pos != std::string::npos)
+			name = name.substr(pos + 1);
+
+		const double warmTime = GetPercentile(result.warmCacheTimeArray, 50.0);
+		printf("meshcache: %-29s cold %10.2f ms warm %10.2f ms (read %.2f) %6.2fx%s\n", name.c_str(),
+			result.coldCacheMs, warmTime, result.warmCacheStats.stageTime[FBX_LOADER::FBX_LOAD_STAGE_MESH_CACHE_READ],
+			warmTime > 0.0 ? result.coldCacheMs / warmTime : 0.0, result.cacheUsable ? "" : " (animation/skin: not cached)");
+		if(result.bakedBufferCount > 0)
+			printf("baked:     %-29s %6u/%u buffers mapped, working set +%.2f MB, largest buffer %.2f MB\n", name.c_str(),
+				result.bakedMappedCount, result.bakedBufferCount, static_cast<double>(result.bakedWorkingSetGrowth) / (1024.0 * 1024.0),
+				static_cast<double>(result.bakedMaxBufferBytes) / (1024.0 * 1024.0));
+	}
+
+	// 1Xbh-t̃Xbh̔r. SDK̓ǂݏo(setup)͂ǂVOXbh
+	for(size_t i=0;i<resultArray.size();i++)
+	{
+		const BENCH_RESULT& result = resultArray[i];
+		if(!result.succeeded || result.serialTimeArray.empty())
+			continue;
+
+		std::string name = result.filename;
+		const size_t pos = name.find_last_of("\\/");
+		if(pos != std::string::npos)
+			name = name.substr(pos + 1);
+
+		const double serialTime = GetPercentile(result.serialTimeArray, 50.0);
+		const double parallelTime = result.GetPercentile(50.0);
+		printf("threads:   %-29s 1 thread %10.2f ms (setup %.2f, build %.2f) %2u threads %10.2f ms (setup %.2f, build %.2f) %6.2fx\n", name.c_str(),
+			serialTime, result.serialStats.stageTime[FBX_LOADER::FBX_LOAD_STAGE_SETUP], result.serialStats.stageTime[FBX_LOADER::FBX_LOAD_STAGE_BUILD_NODES],
+			result.stats.buildThreadCount, parallelTime, result.stats.stageTime[FBX_LOADER::FBX_LOAD_STAGE_SETUP],
+			result.stats.stageTime[FBX_LOADER::FBX_LOAD_STAGE_BUILD_NODES], parallelTime > 0.0 ? serialTime / parallelTime : 0.0);
+	}
+
+	// m[h̃q[vmۉ. create͍Ɨ̈g񂵂ꍇ / Ɣz1mۂꍇ.
+	// live͔jɎcm([NĂȂ0). peak heap͓ǂݍݒɑmۗʂ̍ő(FBX SDK͓̕Ȃ)
+	for(size_t i=0;i<resultArray.size();i++)
+	{
+		const BENCH_RESULT& result = resultArray[i];
+		if(!result.succeeded || result.allocNodeCount==0)
+			continue;
+
+		std::string name = result.filename;
+		const size_t pos = name.find_last_of("\\/");
+		if(pos != std::string::npos)
+			name = name.substr(pos + 1);
+
+		const FBX_LOADER::FBX_LOAD_STATS& stats = result.allocStats;
+		const double nodeCount = static_cast<double>(result.allocNodeCount);
+		printf("allocs:    %-29s %6u nodes setup %8.2f build %8.2f create %8.2f (heap mode %8.2f) /node, live %lld (heap mode %lld)\n", name.c_str(),
+			result.allocNodeCount,
+			static_cast<double>(stats.stageAllocCount[FBX_LOADER::FBX_LOAD_STAGE_SETUP]) / nodeCount,
+			static_cast<double>(stats.stageAllocCount[FBX_LOADER::FBX_LOAD_STAGE_BUILD_NODES]) / nodeCount,
+			static_cast<double>(GetCreateAllocCount(stats)) / nodeCount,
+			static_cast<double>(GetCreateAllocCount(result.heapModeAllocStats)) / nodeCount,
+			static_cast<long long>(result.liveAllocCount), static_cast<long long>(result.heapModeLiveAllocCount));
+		printf("           %-29s %6s       peak heap %10.2f MB (heap mode %10.2f MB) %8.2f KB/node\n", "", "",
+			static_cast<double>(result.peakHeapBytes) / (1024.0 * 1024.0), static_cast<double>(result.heapModePeakHeapBytes) / (1024.0 * 1024.0),
+			static_cast<double>(result.peakHeapBytes) / 1024.0 / nodeCount);
+	}
+
+	// `L[1t[̌Ăяo(ReLXg̋L^ƈvmFς)
+	for(size_t i=0;i<resultArray.size();i++)
+	{
+		const BENCH_RESULT& result = resultArray[i];
+		if(!result.succeeded || result.queueFrameCount==0)
+			continue;
+
+		std::string name = result.filename;
+		const size_t pos = name.find_last_of("\\/");
+		if(pos != std::string::npos)
+			name = name.substr(pos + 1);
+
+		const FBX_LOADER::RENDER_QUEUE_STATS& stats = result.queueStats;
+		printf("queue:     %-29s %6u draws %6u culled ia %u/%u/%u cb %u material %u map %u skipped %u /frame\n", name.c_str(),
+			stats.drawCount, stats.culledNodeCount, stats.inputLayoutBindCount, stats.vertexBufferBindCount, stats.indexBufferBindCount,
+			stats.constantBufferBindCount, stats.materialBindCount, stats.mapCount, stats.skippedBindCount);
+	}
+
+	CULLING_RESULT culling;
+	MeasureCulling(&culling);
+	printf("culling:   %10u objects %10u visible %10.4f ms/pass (scalar %.4f ms) %14.0f objects/ms\n",
+		culling.objectCount, culling.visibleCount, culling.batchMs, culling.scalarMs,
+		culling.batchMs > 0.0 ? static_cast<double>(culling.objectCount) / culling.batchMs : 0.0);
+
+	HIERARCHY_RESULT hierarchy;
+	MeasureHierarchy(option.threadCount, &hierarchy);
+	printf("hierarchy: %10u nodes %10.4f ms/full %10.4f ms/%u dirty (%u nodes) %10.4f ms/parallel (%u threads, first call %.4f ms)\n",
+		hierarchy.nodeCount, hierarchy.fullMs, hierarchy.partialMs, hierarchy.dirtyCount, hierarchy.partialNodeCount,
+		hierarchy.parallelMs, hierarchy.threadCount, hierarchy.parallelFirstMs);
+
+	const bool packedSucceeded = CheckPackedUpload(option, pDevice);
+
+	if(option.jsonPath)
+		WriteJSON(option.jsonPath, driverName, resultArray, culling, hierarchy, totalTriangle, totalTime);
+
+	pDevice->Release();
+
+	if(failedCount > 0)
+		return 2;
+
+	// ǂݍ݂̓vfoCX̌ĂяoƍȂȂ, mFɎsΎsɂ
+	int checkFailCount = 0;
+	for(size_t i=0;i<resultArray.size();i++)
+		checkFailCount += resultArray[i].checkFailCount;
+	if(checkFailCount > 0 || !packedSucceeded)
+	{
+		printf("Error: %d checks failed%s\n", checkFailCount, packedSucceeded ? "" : ", packed upload check failed");
+		return 3;
+	}
+
+	return 0;
+}